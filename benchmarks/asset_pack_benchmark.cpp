@@ -0,0 +1,137 @@
+/* Loads the assets of a skin, a font and a set of decoded images, for a growing
+ * number of editor instances, once by reading the files into memory for each
+ * instance and once from an asset pack mapped once for the whole process.
+ * Reports the time to load the assets of all instances, including touching
+ * every byte as an upload would, and the memory each way keeps per process.
+ * The skin is generated in the temp directory and removed afterwards */
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "asset_pack.h"
+
+constexpr int IMAGES = 24;
+constexpr int IMAGE_SIZE = 256;
+constexpr size_t FONT_BYTES = 160 * 1024;
+
+struct Result
+{
+    double ms;
+    size_t bytes;
+    uint64_t checksum;
+};
+
+static std::vector<uint8_t> test_data(size_t size, int seed)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<uint8_t>((i * 31 + seed * 17) ^ (i >> 8));
+    }
+    return data;
+}
+
+static uint64_t touch(const uint8_t* data, size_t size)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i += 64)
+    {
+        sum += data[i];
+    }
+    return sum;
+}
+
+static Result load_files(const std::vector<std::string>& paths, int instances)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::vector<uint8_t>> loaded;
+    Result result{0, 0, 0};
+    for (int instance = 0; instance < instances; ++instance)
+    {
+        for (const auto& path : paths)
+        {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            loaded.emplace_back(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(loaded.back().data()), static_cast<std::streamsize>(loaded.back().size()));
+            result.bytes += loaded.back().size();
+            result.checksum += touch(loaded.back().data(), loaded.back().size());
+        }
+    }
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+static Result load_pack(const std::string& path, const std::vector<std::string>& names, int instances)
+{
+    auto start = std::chrono::steady_clock::now();
+    imgui_editor::AssetPack pack;
+    Result result{0, 0, 0};
+    if (!pack.open(path))
+    {
+        return result;
+    }
+    for (int instance = 0; instance < instances; ++instance)
+    {
+        for (const auto& name : names)
+        {
+            imgui_editor::Asset asset;
+            if (pack.find(name, asset))
+            {
+                result.checksum += touch(asset.data, asset.size);
+            }
+        }
+    }
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.bytes = pack.bytes();
+    return result;
+}
+
+int main()
+{
+    auto directory = std::filesystem::temp_directory_path() / "vstimgui_asset_pack_benchmark";
+    std::filesystem::create_directories(directory);
+
+    imgui_editor::AssetPackWriter writer;
+    std::vector<std::string> paths;
+    std::vector<std::string> names;
+    for (int i = 0; i <= IMAGES; ++i)
+    {
+        bool font = i == IMAGES;
+        std::string name = font ? "font" : "image" + std::to_string(i);
+        std::vector<uint8_t> data = test_data(font ? FONT_BYTES : IMAGE_SIZE * IMAGE_SIZE * 4, i);
+        std::string path = (directory / name).string();
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        paths.push_back(path);
+        names.push_back(name);
+        if (font)
+        {
+            writer.add(name, imgui_editor::AssetType::FONT, std::move(data));
+        }
+        else
+        {
+            writer.add(name, imgui_editor::AssetType::IMAGE_RGBA, std::move(data), IMAGE_SIZE, IMAGE_SIZE);
+        }
+    }
+    std::string pack_path = (directory / "skin.pack").string();
+    if (!writer.write(pack_path))
+    {
+        return 1;
+    }
+
+    std::printf("instances  files ms  files MB  pack ms  pack MB  identical\n");
+    for (int instances : {1, 2, 4, 8, 16, 32})
+    {
+        Result files = load_files(paths, instances);
+        Result pack = load_pack(pack_path, names, instances);
+        std::printf("%9d  %8.2f  %8.1f  %7.2f  %7.1f  %9s\n", instances, files.ms, files.bytes / 1'048'576.0,
+                    pack.ms, pack.bytes / 1'048'576.0, files.checksum == pack.checksum ? "yes" : "NO");
+    }
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,174 @@
+#ifndef IMPLUGINGUI_BENCHMARK_CONTEXT_H
+#define IMPLUGINGUI_BENCHMARK_CONTEXT_H
+
+/* Sets up a hidden glfw window with an OpenGL context and a Dear ImGui
+ * context with the OpenGL3 renderer backend for running benchmarks. The
+ * context is chosen like the editor's, 3.3 core if available, else 3.0.
+ * No platform backend is used, display size and time step are set
+ * directly on ImGuiIO. BenchmarkFrame builds the frame several benchmarks
+ * render, so their results can be compared */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "editor.h"
+
+class BenchmarkContext
+{
+public:
+    BenchmarkContext(int width, int height) : _width(width), _height(height)
+    {
+        glfwSetErrorCallback(imgui_editor::glfw_error_callback);
+        if (!glfwInit())
+        {
+            return;
+        }
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        const char* glsl_version = nullptr;
+        for (const auto& version : imgui_editor::GL_VERSIONS)
+        {
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version.major);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version.minor);
+            glfwWindowHint(GLFW_OPENGL_PROFILE, version.core_profile ? GLFW_OPENGL_CORE_PROFILE : GLFW_OPENGL_ANY_PROFILE);
+            _window = glfwCreateWindow(width, height, "vstimgui benchmark", nullptr, nullptr);
+            if (_window != nullptr)
+            {
+                glsl_version = version.glsl_version;
+                break;
+            }
+        }
+        if (_window == nullptr)
+        {
+            return;
+        }
+        glfwMakeContextCurrent(_window);
+        glfwSwapInterval(0);
+
+#if defined(IMGUI_IMPL_OPENGL_LOADER_GL3W)
+        bool err = gl3wInit() != 0;
+#elif defined(IMGUI_IMPL_OPENGL_LOADER_GLEW)
+        bool err = glewInit() != GLEW_OK;
+#elif defined(IMGUI_IMPL_OPENGL_LOADER_GLAD)
+        bool err = gladLoadGL() == 0;
+#else
+        bool err = false;
+#endif
+        if (err)
+        {
+            std::cerr << "Failed to initialize OpenGL loader!" << std::endl;
+            return;
+        }
+
+        MyImGuiTLS = ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.DisplaySize = ImVec2(static_cast<float>(width), static_cast<float>(height));
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui_ImplOpenGL3_Init(glsl_version);
+        std::cerr << "OpenGL " << glGetString(GL_VERSION) << ", widgets drawn "
+                  << (ImGui_ImplOpenGL3_HasInstancedWidgets() ? "instanced" : "with regular primitives") << std::endl;
+        _valid = true;
+    }
+
+    ~BenchmarkContext()
+    {
+        if (_valid)
+        {
+            ImGui_ImplOpenGL3_Shutdown();
+            ImGui::DestroyContext();
+        }
+        if (_window)
+        {
+            glfwDestroyWindow(_window);
+        }
+        glfwTerminate();
+    }
+
+    bool valid() const
+    {
+        return _valid;
+    }
+
+    void new_frame()
+    {
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui::NewFrame();
+    }
+
+    /* Renders the current frame, or the given draw data, and waits for the gpu to finish it */
+    void render(ImDrawData* draw_data = nullptr)
+    {
+        glViewport(0, 0, _width, _height);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        ImGui_ImplOpenGL3_RenderDrawData(draw_data ? draw_data : ImGui::GetDrawData());
+        glFinish();
+    }
+
+private:
+    int         _width;
+    int         _height;
+    bool        _valid{false};
+    GLFWwindow* _window{nullptr};
+};
+
+/* A page of text over a grid of vertical sliders whose values change every
+ * frame, in a window covering the display */
+class BenchmarkFrame
+{
+public:
+    BenchmarkFrame(int text_lines, int sliders) : _text_lines(text_lines), _values(sliders), _ids(sliders)
+    {
+        for (int i = 0; i < sliders; ++i)
+        {
+            _ids[i] = "##" + std::to_string(i);
+        }
+    }
+
+    /* Builds frame number frame and renders it to draw data */
+    void build(int frame)
+    {
+        begin(frame);
+        end();
+    }
+
+    /* Builds the text and sliders of frame number frame, more can be drawn in
+     * the window until end() */
+    void begin(int frame)
+    {
+        ImVec2 display_size = ImGui::GetIO().DisplaySize;
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(display_size);
+        ImGui::Begin("frame", nullptr, ImGuiWindowFlags_NoDecoration);
+        for (int i = 0; i < _text_lines; ++i)
+        {
+            ImGui::Text("Line %d of text in frame %d, the quick brown fox jumps over the lazy dog", i, frame);
+        }
+        int columns = static_cast<int>(display_size.x / (SLIDER_SIZE.x + 4));
+        for (int i = 0; i < static_cast<int>(_values.size()); ++i)
+        {
+            _values[i] = static_cast<float>((i + frame) % 100) / 100.0f;
+            if (i % columns != 0)
+            {
+                ImGui::SameLine(0, 4);
+            }
+            ImGui::VSliderFloat(_ids[i].c_str(), SLIDER_SIZE, &_values[i], 0.0f, 1.0f, "");
+        }
+    }
+
+    void end()
+    {
+        ImGui::End();
+        ImGui::Render();
+    }
+
+private:
+    static constexpr ImVec2 SLIDER_SIZE{12, 40};
+
+    int                      _text_lines;
+    std::vector<float>       _values;
+    std::vector<std::string> _ids;
+};
+
+#endif //IMPLUGINGUI_BENCHMARK_CONTEXT_H
@@ -0,0 +1,173 @@
+/* Replays a draw data capture, recorded by running an editor with the
+ * VSTIMGUI_DRAW_CAPTURE environment variable set, as fast as possible through
+ * the OpenGL3 backend, or the software renderer with --soft, and reports the
+ * time spent rendering per frame. The font atlas is uploaded again, untimed,
+ * whenever the frames switch to another revision of it. Captured polylines and
+ * instanced widgets are only drawn by the OpenGL3 backend, the commands left
+ * out of each frame are reported.
+ *
+ * usage: draw_replay <capture file> [--repeat <count>] [--soft <threads>] */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "benchmark_context.h"
+#include "draw_capture.h"
+#include "imgui_impl_soft.h"
+
+/* Stands in for images and other textures that only existed in the captured session */
+constexpr ImU32 PLACEHOLDER_COLOUR = 0xffffffff;
+
+static double percentile(std::vector<double>& times, double fraction)
+{
+    size_t index = std::min(times.size() - 1, static_cast<size_t>(fraction * times.size()));
+    std::nth_element(times.begin(), times.begin() + index, times.end());
+    return times[index];
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <capture file> [--repeat <count>] [--soft <threads>]" << std::endl;
+        return 1;
+    }
+    int repeats = 1;
+    int soft_threads = -1;
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--repeat") == 0)
+        {
+            repeats = std::max(1, std::atoi(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--soft") == 0)
+        {
+            soft_threads = std::atoi(argv[i + 1]);
+        }
+    }
+
+    imgui_editor::DrawCapture capture;
+    if (!capture.open(argv[1]) || capture.frames() == 0)
+    {
+        std::cerr << "Nothing to replay in " << argv[1] << std::endl;
+        return 1;
+    }
+    int width = std::max(1, static_cast<int>(capture.header().max_width));
+    int height = std::max(1, static_cast<int>(capture.header().max_height));
+
+    BenchmarkContext context(width, height);
+    if (!context.valid())
+    {
+        std::cerr << "Failed to set up OpenGL context" << std::endl;
+        return 1;
+    }
+
+    bool soft = soft_threads >= 0;
+    std::vector<ImU32> pixels;
+    ImTextureID font_texture = nullptr;
+    ImTextureID placeholder;
+    if (soft)
+    {
+        ImGui_ImplSoft_Init(soft_threads);
+        pixels.resize(static_cast<size_t>(width) * height);
+        placeholder = ImGui_ImplSoft_CreateTexture(&PLACEHOLDER_COLOUR, 1, 1);
+    }
+    else
+    {
+        ImGui_ImplOpenGL3_NewFrame();
+        placeholder = ImGui_ImplOpenGL3_CreateTexture(&PLACEHOLDER_COLOUR, 1, 1);
+    }
+    auto destroy_texture = [soft](ImTextureID texture)
+    {
+        if (texture == nullptr)
+        {
+            return;
+        }
+        if (soft)
+        {
+            ImGui_ImplSoft_DestroyTexture(texture);
+        }
+        else
+        {
+            ImGui_ImplOpenGL3_DestroyTexture(texture);
+        }
+    };
+    int current_atlas = -1;
+    imgui_editor::DrawCallbackFunctions callbacks = imgui_editor::opengl3_callbacks();
+
+    std::vector<double> times;
+    times.reserve(static_cast<size_t>(capture.frames()) * repeats);
+    long long vertices = 0;
+    long long indices = 0;
+    long long dropped = 0;
+    for (int repeat = 0; repeat < repeats; ++repeat)
+    {
+        for (int frame = 0; frame < capture.frames(); ++frame)
+        {
+            int atlas = capture.frame_atlas(frame);
+            if (atlas < 0)
+            {
+                std::cerr << "Capture frame " << frame << " has no font atlas" << std::endl;
+                return 1;
+            }
+            if (atlas != current_atlas)
+            {
+                destroy_texture(font_texture);
+                const auto& revision = capture.atlas(atlas);
+                int atlas_width = static_cast<int>(revision.width);
+                int atlas_height = static_cast<int>(revision.height);
+                font_texture = soft ? ImGui_ImplSoft_CreateTexture(capture.atlas_pixels(atlas), atlas_width, atlas_height) :
+                                      ImGui_ImplOpenGL3_CreateTexture(capture.atlas_pixels(atlas), atlas_width, atlas_height);
+                current_atlas = atlas;
+            }
+            if (!soft)
+            {
+                /* Clears the backend's polylines and widgets, before the frame adds them again */
+                ImGui_ImplOpenGL3_NewFrame();
+            }
+            ImDrawData* draw_data = capture.frame(frame, font_texture, placeholder, soft ? nullptr : &callbacks);
+            if (draw_data == nullptr)
+            {
+                return 1;
+            }
+            vertices += draw_data->TotalVtxCount;
+            indices += draw_data->TotalIdxCount;
+            dropped += capture.dropped_commands();
+            auto start = std::chrono::steady_clock::now();
+            if (soft)
+            {
+                std::fill(pixels.begin(), pixels.end(), IM_COL32_BLACK);
+                ImGui_ImplSoft_RenderDrawData(draw_data, pixels.data(), width, height, width);
+            }
+            else
+            {
+                context.render(draw_data);
+            }
+            times.push_back((std::chrono::steady_clock::now() - start).count() / 1'000'000.0);
+        }
+    }
+
+    double total = 0;
+    for (double time : times)
+    {
+        total += time;
+    }
+    size_t count = times.size();
+    std::printf("renderer  frames  unique  atlases  vertices  indices  dropped  mean ms  median ms  99%% ms  max ms\n");
+    std::printf("%s  %6d  %6d  %7d  %8lld  %7lld  %7.2f  %7.3f  %9.3f  %6.3f  %6.3f\n", soft ? "software" : "opengl3 ",
+                capture.frames(), capture.unique_frames(), capture.atlases(), vertices / static_cast<long long>(count),
+                indices / static_cast<long long>(count), static_cast<double>(dropped) / count, total / count, percentile(times, 0.5),
+                percentile(times, 0.99), *std::max_element(times.begin(), times.end()));
+
+    destroy_texture(font_texture);
+    destroy_texture(placeholder);
+    if (soft)
+    {
+        ImGui_ImplSoft_Shutdown();
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+/* Compares building the font atlas with every glyph of a set of ranges up front
+ * against building it with ASCII only and rasterizing the glyphs of a set of
+ * localized parameter names on demand with GlyphAtlas. Reports the time until
+ * the text can be drawn and the size of the atlas each way.
+ *
+ * usage: glyph_atlas_benchmark [font file]
+ * Without a font file ImGui's default font is used, which only has Latin-1, so
+ * pass a font covering the ranges, e.g. a Noto Sans CJK, for meaningful numbers */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#include "glyph_atlas.h"
+#include "imgui.h"
+
+constexpr float FONT_SIZE = 16;
+constexpr ImWchar ASCII[] = {0x0020, 0x007E, 0};
+/* Latin, Greek, Cyrillic, Japanese kana and the common CJK ideographs */
+constexpr ImWchar LOCALIZED[] = {0x0020, 0x024F, 0x0370, 0x03FF, 0x0400, 0x04FF, 0x3000, 0x30FF, 0x4E00, 0x9FAF, 0};
+constexpr const char* PARAMETER_NAMES[] = {"Cutoff", "Résonance", "Hüllkurve", "Частота", "Затухание", "カットオフ",
+                                           "レゾナンス", "截止频率", "共振", "包络", "音量", "Γένος"};
+
+struct Result
+{
+    double ms;
+    int width;
+    int height;
+};
+
+static ImFont* add_font(const char* path, const ImWchar* ranges)
+{
+    ImFontConfig config;
+    config.GlyphRanges = ranges;
+    ImGuiIO& io = ImGui::GetIO();
+    return path ? io.Fonts->AddFontFromFileTTF(path, FONT_SIZE, &config) : io.Fonts->AddFontDefault(&config);
+}
+
+static Result up_front(const char* path)
+{
+    MyImGuiTLS = ImGui::CreateContext();
+    auto start = std::chrono::steady_clock::now();
+    add_font(path, LOCALIZED);
+    unsigned char* pixels;
+    int width, height;
+    ImGui::GetIO().Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    Result result{std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(), width, height};
+    ImGui::DestroyContext();
+    return result;
+}
+
+static Result on_demand(const char* path)
+{
+    MyImGuiTLS = ImGui::CreateContext();
+    imgui_editor::GlyphAtlas glyphs;
+    auto start = std::chrono::steady_clock::now();
+    ImFont* font = add_font(path, ASCII);
+    glyphs.add(font, LOCALIZED);
+    glyphs.new_frame();
+    for (const char* name : PARAMETER_NAMES)
+    {
+        glyphs.use(font, name);
+    }
+    /* Glyphs that didn't fit are added as the next frame starts */
+    glyphs.new_frame();
+    ImGuiIO& io = ImGui::GetIO();
+    Result result{std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                  io.Fonts->TexWidth, io.Fonts->TexHeight};
+    std::printf("%d glyphs rasterized on demand\n", glyphs.glyphs());
+    glyphs.clear();
+    ImGui::DestroyContext();
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    const char* path = argc > 1 ? argv[1] : nullptr;
+    if (path == nullptr)
+    {
+        std::cerr << "No font given, using the default font" << std::endl;
+    }
+    Result all = up_front(path);
+    Result used = on_demand(path);
+    std::printf("               ms     atlas    atlas MB\n");
+    std::printf("up front   %7.2f  %4d x %-4d %7.2f\n", all.ms, all.width, all.height, all.width * all.height * 4 / 1'048'576.0);
+    std::printf("on demand  %7.2f  %4d x %-4d %7.2f\n", used.ms, used.width, used.height, used.width * used.height * 4 / 1'048'576.0);
+    return 0;
+}
@@ -0,0 +1,118 @@
+/* Draws an editor made of a growing number of heavy panels, each a matrix of
+ * anti-aliased circles under a dense curve, with ParallelPanels at different
+ * worker thread counts. Reports the time to build the panels' geometry per
+ * frame, the speed-up over drawing them on the draw thread alone, and whether
+ * the merged draw data is identical to the single threaded one */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "benchmark_context.h"
+#include "fnv_hash.h"
+#include "parallel_panels.h"
+
+constexpr int WIDTH = 1024;
+constexpr int HEIGHT = 768;
+constexpr int FRAMES = 100;
+constexpr int MATRIX_SIZE = 24;
+constexpr int CURVE_POINTS = 1000;
+
+static void draw_panel(ImDrawList* draw_list, ImVec2 pos, ImVec2 size, int frame, int panel)
+{
+    float cell = std::min(size.x, size.y) / MATRIX_SIZE;
+    for (int row = 0; row < MATRIX_SIZE; ++row)
+    {
+        for (int column = 0; column < MATRIX_SIZE; ++column)
+        {
+            float level = 0.5f + 0.5f * std::sin(0.3f * row + 0.2f * column + 0.05f * frame + panel);
+            ImVec2 centre(pos.x + (column + 0.5f) * cell, pos.y + (row + 0.5f) * cell);
+            draw_list->AddCircleFilled(centre, 0.45f * cell * level, IM_COL32(0x40, 0xa0, 0xf0, 0xff));
+        }
+    }
+    ImVec2 points[CURVE_POINTS];
+    for (int i = 0; i < CURVE_POINTS; ++i)
+    {
+        float x = static_cast<float>(i) / CURVE_POINTS;
+        points[i] = ImVec2(pos.x + x * size.x, pos.y + size.y * (0.5f + 0.4f * std::sin(30.0f * x + 0.1f * frame + panel)));
+    }
+    draw_list->AddPolyline(points, CURVE_POINTS, IM_COL32_WHITE, ImDrawFlags_None, 1.5f);
+}
+
+struct Result
+{
+    double   build_ms;
+    uint64_t draw_hash;
+};
+
+static Result run(BenchmarkContext& context, imgui_editor::ParallelPanels& panels, int panel_count)
+{
+    int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(panel_count))));
+    int rows = (panel_count + columns - 1) / columns;
+    ImVec2 size(static_cast<float>(WIDTH) / columns, static_cast<float>(HEIGHT) / rows);
+
+    std::chrono::nanoseconds time(0);
+    uint64_t draw_hash = imgui_editor::FNV_OFFSET;
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        context.new_frame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImVec2(WIDTH, HEIGHT));
+        ImGui::Begin("panels", nullptr, ImGuiWindowFlags_NoDecoration);
+        for (int panel = 0; panel < panel_count; ++panel)
+        {
+            ImVec2 pos((panel % columns) * size.x, (panel / columns) * size.y);
+            panels.submit(pos, ImVec2(pos.x + size.x, pos.y + size.y), [pos, size, frame, panel](ImDrawList* draw_list)
+            {
+                draw_panel(draw_list, pos, size, frame, panel);
+            });
+        }
+        ImGui::End();
+        ImGui::Render();
+        auto start = std::chrono::steady_clock::now();
+        panels.merge(ImGui::GetDrawData());
+        time += std::chrono::steady_clock::now() - start;
+
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        for (int n = 0; n < draw_data->CmdListsCount; ++n)
+        {
+            const ImDrawList* list = draw_data->CmdLists[n];
+            draw_hash = imgui_editor::fnv_hash(draw_hash, list->VtxBuffer.Data, list->VtxBuffer.size_in_bytes());
+            draw_hash = imgui_editor::fnv_hash(draw_hash, list->IdxBuffer.Data, list->IdxBuffer.size_in_bytes());
+        }
+        context.render();
+    }
+    return {time.count() / 1'000'000.0 / FRAMES, draw_hash};
+}
+
+int main()
+{
+    BenchmarkContext context(WIDTH, HEIGHT);
+    if (!context.valid())
+    {
+        std::cerr << "Failed to set up OpenGL context" << std::endl;
+        return 1;
+    }
+
+    int max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    imgui_editor::ParallelPanels panels;
+    std::printf("panels  threads  build ms  speed-up  identical\n");
+    for (int panel_count : {1, 2, 4, 8, 16, 32})
+    {
+        panels.start(0, nullptr);
+        Result serial = run(context, panels, panel_count);
+        std::printf("%6d  %7d  %8.3f  %8.2f  %9s\n", panel_count, 0, serial.build_ms, 1.0, "-");
+        for (int threads = 1; threads <= max_threads; threads *= 2)
+        {
+            panels.start(threads, nullptr);
+            Result result = run(context, panels, panel_count);
+            std::printf("%6d  %7d  %8.3f  %8.2f  %9s\n", panel_count, threads, result.build_ms,
+                        serial.build_ms / result.build_ms, result.draw_hash == serial.draw_hash ? "yes" : "NO");
+        }
+    }
+    panels.stop();
+    return 0;
+}
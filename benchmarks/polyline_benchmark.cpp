@@ -0,0 +1,76 @@
+/* Compares drawing dense polylines with ImDrawList::AddPolyline(), which
+ * tessellates anti-aliased lines on the cpu, against the vertex shader
+ * expansion of ImGui_ImplOpenGL3_AddPolyline() */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "benchmark_context.h"
+
+constexpr int WIDTH = 1024;
+constexpr int HEIGHT = 768;
+constexpr int LINES = 8;
+constexpr int FRAMES = 200;
+
+enum class Mode
+{
+    CPU,
+    GPU
+};
+
+int main()
+{
+    BenchmarkContext context(WIDTH, HEIGHT);
+    if (!context.valid())
+    {
+        std::cerr << "Failed to set up OpenGL context" << std::endl;
+        return 1;
+    }
+
+    std::printf("mode  points/line  build ms  render ms  vertices\n");
+    for (int points_per_line : {1000, 4000, 16000})
+    {
+        std::vector<ImVec2> points(points_per_line);
+        for (Mode mode : {Mode::CPU, Mode::GPU})
+        {
+            std::chrono::nanoseconds build_time(0);
+            std::chrono::nanoseconds render_time(0);
+            int vertices = 0;
+            for (int frame = 0; frame < FRAMES; ++frame)
+            {
+                auto start = std::chrono::steady_clock::now();
+                context.new_frame();
+                ImDrawList* draw_list = ImGui::GetBackgroundDrawList();
+                for (int line = 0; line < LINES; ++line)
+                {
+                    float y_offset = (line + 0.5f) * HEIGHT / LINES;
+                    for (int i = 0; i < points_per_line; ++i)
+                    {
+                        float x = static_cast<float>(i) * WIDTH / points_per_line;
+                        points[i] = ImVec2(x, y_offset + 30.0f * std::sin(0.05f * i + frame * 0.1f + line));
+                    }
+                    if (mode == Mode::CPU)
+                    {
+                        draw_list->AddPolyline(points.data(), points_per_line, IM_COL32_WHITE, ImDrawFlags_None, 1.5f);
+                    }
+                    else
+                    {
+                        ImGui_ImplOpenGL3_AddPolyline(draw_list, points.data(), points_per_line, IM_COL32_WHITE, 1.5f);
+                    }
+                }
+                ImGui::Render();
+                auto split = std::chrono::steady_clock::now();
+                context.render();
+                auto end = std::chrono::steady_clock::now();
+                build_time += split - start;
+                render_time += end - split;
+                vertices = ImGui::GetDrawData()->TotalVtxCount;
+            }
+            std::printf("%s  %11d  %8.3f  %9.3f  %8d\n", mode == Mode::CPU ? "cpu " : "gpu ", points_per_line,
+                        build_time.count() / 1'000'000.0 / FRAMES, render_time.count() / 1'000'000.0 / FRAMES, vertices);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+/* Renders the same frame, a grid of sliders under a page of text, with the
+ * OpenGL3 backend and with the software renderer at different thread counts.
+ * Run with LIBGL_ALWAYS_SOFTWARE=1 to compare against Mesa's llvmpipe, the
+ * renderer that would be used on hosts without a gpu */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "benchmark_context.h"
+#include "imgui_impl_soft.h"
+
+constexpr int WIDTH = 1024;
+constexpr int HEIGHT = 768;
+constexpr int FRAMES = 200;
+constexpr int SLIDERS = 512;
+constexpr int TEXT_LINES = 30;
+
+int main()
+{
+    BenchmarkContext context(WIDTH, HEIGHT);
+    if (!context.valid())
+    {
+        std::cerr << "Failed to set up OpenGL context" << std::endl;
+        return 1;
+    }
+    BenchmarkFrame benchmark_frame(TEXT_LINES, SLIDERS);
+
+    std::printf("renderer  threads  render ms  triangles  binned  tiles\n");
+    std::chrono::nanoseconds gl_time(0);
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        context.new_frame();
+        benchmark_frame.build(frame);
+        auto start = std::chrono::steady_clock::now();
+        context.render();
+        gl_time += std::chrono::steady_clock::now() - start;
+    }
+    std::printf("opengl3   %7s  %9.3f\n", "-", gl_time.count() / 1'000'000.0 / FRAMES);
+
+    /* The software renderer puts its own font texture in the atlas */
+    ImGuiIO& io = ImGui::GetIO();
+    ImTextureID gl_font_texture = io.Fonts->TexID;
+    std::vector<ImU32> pixels(WIDTH * HEIGHT);
+    int max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        ImGui_ImplSoft_Init(threads);
+        std::chrono::nanoseconds soft_time(0);
+        for (int frame = 0; frame < FRAMES; ++frame)
+        {
+            ImGui_ImplSoft_NewFrame();
+            ImGui::NewFrame();
+            benchmark_frame.build(frame);
+            auto start = std::chrono::steady_clock::now();
+            std::fill(pixels.begin(), pixels.end(), IM_COL32_BLACK);
+            ImGui_ImplSoft_RenderDrawData(ImGui::GetDrawData(), pixels.data(), WIDTH, HEIGHT, WIDTH);
+            soft_time += std::chrono::steady_clock::now() - start;
+        }
+        const auto& stats = ImGui_ImplSoft_GetFrameStats();
+        std::printf("software  %7d  %9.3f  %9d  %6d  %5d\n", threads, soft_time.count() / 1'000'000.0 / FRAMES,
+                    stats.Triangles, stats.BinnedTriangles, stats.Tiles);
+        ImGui_ImplSoft_Shutdown();
+    }
+    io.Fonts->SetTexID(gl_font_texture);
+    return 0;
+}
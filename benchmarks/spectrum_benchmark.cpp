@@ -0,0 +1,48 @@
+/* Measures the cost of one analyzer frame, i.e. windowing, fft, log
+ * frequency binning and smoothing, at a range of fft sizes */
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+
+#include "spectrum.h"
+
+constexpr int DISPLAY_BINS = 230;
+constexpr int HOP_SIZE = 800;  // Roughly one 60 Hz frame of audio at 48 kHz
+constexpr float SAMPLE_RATE = 48000;
+constexpr auto TARGET_TIME = std::chrono::milliseconds(500);
+
+int main()
+{
+    std::mt19937 rand_gen(1);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> audio(HOP_SIZE);
+
+    std::cout << "fft size    us/frame    frames/s" << std::endl;
+    for (int fft_size : {2048, 8192, 32768})
+    {
+        imgui_editor::SpectrumAnalyzer analyzer(fft_size, SAMPLE_RATE);
+        analyzer.set_display_range(DISPLAY_BINS, 20.0f, 20000.0f);
+
+        for (auto& sample : audio)
+        {
+            sample = dist(rand_gen);
+        }
+
+        int frames = 0;
+        std::chrono::nanoseconds total(0);
+        while (total < TARGET_TIME)
+        {
+            analyzer.push(audio.data(), HOP_SIZE);
+            auto start = std::chrono::steady_clock::now();
+            analyzer.process();
+            total += std::chrono::steady_clock::now() - start;
+            frames++;
+        }
+        double us_per_frame = total.count() / 1000.0 / frames;
+        std::printf("%8d  %10.2f  %10.0f\n", fft_size, us_per_frame, 1'000'000.0 / us_per_frame);
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+/* Replays an input recording, made by running an editor with the
+ * VSTIMGUI_INPUT_RECORDING environment variable set, through the editor's
+ * widget code as fast as possible. Runs headless, without a window or OpenGL,
+ * so only the ImGui::NewFrame() to ImGui::Render() part is measured.
+ * The editor gets the standalone demo's test signal through a SampleFifo, as
+ * much of it as the recorded frame times add up to, so the scope, analyzer and
+ * spectrogram are part of the measurement as they are in the demo.
+ * Reports frames per second, allocations per frame, both through ImGui's
+ * allocator as counted by the editor's memory accounting and through operator
+ * new, and a hash of the generated draw data. The editor leaves out its
+ * statistics when headless, as they are timings, so the hash is the same on
+ * every run of the same recording.
+ *
+ * usage: ui_replay <recording file> [--repeat <count>] */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include "editor.h"
+#include "fnv_hash.h"
+
+/* The standalone demo's audio */
+constexpr int AUDIO_BLOCK_SIZE = 64;
+constexpr float AUDIO_SAMPLE_RATE = 48000;
+constexpr float TWO_PI = 6.283185307f;
+
+static std::atomic<long long> heap_allocations{0};
+
+void* operator new(size_t size)
+{
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+/* Pushes the demo's test signal, a 110 Hz sine with a 0.5 Hz tremolo, in whole blocks
+ * as they would have arrived over the recorded frame time. Starts over with every
+ * replay, so the draw data is the same each time */
+class TestSignal
+{
+public:
+    explicit TestSignal(imgui_editor::SampleFifo* fifo) : _fifo(fifo)
+    {}
+
+    void advance(float seconds)
+    {
+        _time_left += seconds;
+        auto block_time = AUDIO_BLOCK_SIZE / AUDIO_SAMPLE_RATE;
+        while (_time_left >= block_time)
+        {
+            for (auto& sample : _buffer)
+            {
+                sample = 0.8f * std::sin(_phase) * (0.5f + 0.5f * std::sin(_lfo_phase));
+                _phase = std::fmod(_phase + TWO_PI * 110.0f / AUDIO_SAMPLE_RATE, TWO_PI);
+                _lfo_phase = std::fmod(_lfo_phase + TWO_PI * 0.5f / AUDIO_SAMPLE_RATE, TWO_PI);
+            }
+            _fifo->push(_buffer.data(), AUDIO_BLOCK_SIZE);
+            _time_left -= block_time;
+        }
+    }
+
+private:
+    imgui_editor::SampleFifo* _fifo;
+    std::array<float, AUDIO_BLOCK_SIZE> _buffer;
+    float _phase{0};
+    float _lfo_phase{0};
+    float _time_left{0};
+};
+
+struct ReplayResult
+{
+    std::chrono::nanoseconds time;
+    long long heap_allocations;
+    long long imgui_allocations;
+};
+
+/* Times the frames and counts their allocations, setting up and tearing down the
+ * ImGui context is not included. The draw data is hashed if draw_hash is not null */
+static ReplayResult replay(imgui_editor::Editor& editor, imgui_editor::SampleFifo& fifo,
+                           const imgui_editor::InputRecording& recording, uint64_t* draw_hash)
+{
+    editor.open_headless();
+    TestSignal signal(&fifo);
+    long long heap_start = heap_allocations;
+    long long imgui_start = editor.memory_stats().cpu_allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& frame : recording.frames())
+    {
+        signal.advance(frame.delta_time);
+        editor.draw_headless(frame);
+        if (draw_hash)
+        {
+            ImDrawData* draw_data = ImGui::GetDrawData();
+            for (int n = 0; n < draw_data->CmdListsCount; ++n)
+            {
+                const ImDrawList* list = draw_data->CmdLists[n];
+                *draw_hash = imgui_editor::fnv_hash(*draw_hash, list->VtxBuffer.Data, list->VtxBuffer.size_in_bytes());
+                *draw_hash = imgui_editor::fnv_hash(*draw_hash, list->IdxBuffer.Data, list->IdxBuffer.size_in_bytes());
+            }
+        }
+    }
+    ReplayResult result{std::chrono::steady_clock::now() - start, heap_allocations - heap_start,
+                        editor.memory_stats().cpu_allocations - imgui_start};
+    editor.close_headless();
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <recording file> [--repeat <count>]" << std::endl;
+        return 1;
+    }
+    int repeats = 10;
+    if (argc > 3 && std::strcmp(argv[2], "--repeat") == 0)
+    {
+        repeats = std::max(1, std::atoi(argv[3]));
+    }
+
+    imgui_editor::InputRecording recording;
+    if (!recording.load(argv[1]) || recording.frames().empty())
+    {
+        std::cerr << "Nothing to replay in " << argv[1] << std::endl;
+        return 1;
+    }
+
+    AudioEffect plugin_dummy_instance;
+    imgui_editor::SampleFifo audio_fifo;
+    imgui_editor::Editor editor(&plugin_dummy_instance, &audio_fifo);
+
+    /* The dummy plugin prints every parameter change the replay makes */
+    std::cout.setstate(std::ios::failbit);
+
+    /* One untimed pass to warm up and hash the output */
+    uint64_t draw_hash = imgui_editor::FNV_OFFSET;
+    replay(editor, audio_fifo, recording, &draw_hash);
+
+    std::chrono::nanoseconds time(0);
+    long long heap = 0;
+    long long imgui = 0;
+    for (int repeat = 0; repeat < repeats; ++repeat)
+    {
+        auto result = replay(editor, audio_fifo, recording, nullptr);
+        time += result.time;
+        heap += result.heap_allocations;
+        imgui += result.imgui_allocations;
+    }
+    std::cout.clear();
+
+    double frames = static_cast<double>(recording.frames().size()) * repeats;
+    std::printf("frames  repeats        fps  ms/frame  imgui allocs/frame  heap allocs/frame  draw data hash\n");
+    std::printf("%6zu  %7d  %9.0f  %8.4f  %18.2f  %17.2f  %016llx\n", recording.frames().size(), repeats,
+                frames / (time.count() / 1'000'000'000.0), time.count() / 1'000'000.0 / frames,
+                imgui / frames, heap / frames, static_cast<unsigned long long>(draw_hash));
+    return 0;
+}
@@ -0,0 +1,143 @@
+/* Compares Dear ImGui's 20 byte vertices with the compact 12 byte fixed point
+ * vertices of the COMPACT_VERTICES build option. The frame, text, sliders and
+ * anti-aliased curves, is built and rendered with the vertex layout this program
+ * was compiled with, build it with and without COMPACT_VERTICES to compare the
+ * cpu cost of generating the vertices. The vertices of the last frame are then
+ * converted to both layouts and uploaded repeatedly, which compares the bytes
+ * moved and the upload time independently of the build */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "benchmark_context.h"
+
+constexpr int WIDTH = 1024;
+constexpr int HEIGHT = 768;
+constexpr int FRAMES = 200;
+constexpr int UPLOADS = 1000;
+constexpr int SLIDERS = 256;
+constexpr int TEXT_LINES = 20;
+constexpr int CURVE_POINTS = 2000;
+
+/* The fixed point scales of the compact layout in imconfig.h */
+constexpr float POS_ONE = 16.0f;
+constexpr float UV_ONE = 16384.0f;
+
+struct FloatVertex
+{
+    float pos[2];
+    float uv[2];
+    ImU32 col;
+};
+
+struct CompactVertex
+{
+    int16_t  pos[2];
+    uint16_t uv[2];
+    ImU32    col;
+};
+
+/* Adds anti-aliased curves to the benchmark frame */
+static void build_frame(BenchmarkFrame& benchmark_frame, int frame, std::vector<ImVec2>& curve)
+{
+    benchmark_frame.begin(frame);
+    for (int i = 0; i < CURVE_POINTS; ++i)
+    {
+        float x = static_cast<float>(i) * WIDTH / CURVE_POINTS;
+        curve[i] = ImVec2(x, HEIGHT - 150.0f + 100.0f * std::sin(0.02f * i + frame * 0.1f));
+    }
+    ImGui::GetWindowDrawList()->AddPolyline(curve.data(), CURVE_POINTS, IM_COL32_WHITE, ImDrawFlags_None, 1.5f);
+    benchmark_frame.end();
+}
+
+static int16_t to_fixed(float value, float one)
+{
+    return static_cast<int16_t>(std::lround(std::fmax(-32768.0f, std::fmin(32767.0f, value * one))));
+}
+
+static uint16_t to_unsigned_fixed(float value, float one)
+{
+    return static_cast<uint16_t>(std::lround(std::fmax(0.0f, std::fmin(65535.0f, value * one))));
+}
+
+/* Times uploading the vertices to a buffer object as the backend does, once per frame */
+template <typename VERTEX>
+static double upload_ms(GLuint buffer, const std::vector<VERTEX>& vertices)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    auto start = std::chrono::steady_clock::now();
+    for (int upload = 0; upload < UPLOADS; ++upload)
+    {
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(VERTEX), vertices.data(), GL_STREAM_DRAW);
+    }
+    glFinish();
+    std::chrono::nanoseconds time = std::chrono::steady_clock::now() - start;
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return time.count() / 1'000'000.0 / UPLOADS;
+}
+
+int main()
+{
+    BenchmarkContext context(WIDTH, HEIGHT);
+    if (!context.valid())
+    {
+        std::cerr << "Failed to set up OpenGL context" << std::endl;
+        return 1;
+    }
+    BenchmarkFrame benchmark_frame(TEXT_LINES, SLIDERS);
+    std::vector<ImVec2> curve(CURVE_POINTS);
+
+    std::chrono::nanoseconds build_time(0);
+    std::chrono::nanoseconds render_time(0);
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        auto start = std::chrono::steady_clock::now();
+        context.new_frame();
+        build_frame(benchmark_frame, frame, curve);
+        auto built = std::chrono::steady_clock::now();
+        context.render();
+        build_time += built - start;
+        render_time += std::chrono::steady_clock::now() - built;
+    }
+#ifdef VSTIMGUI_COMPACT_VERTICES
+    const char* built_layout = "compact";
+#else
+    const char* built_layout = "float";
+#endif
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    std::printf("built with  bytes/vertex  vertices/frame  build ms  render ms\n");
+    std::printf("%-10s  %12zu  %14d  %8.3f  %9.3f\n\n", built_layout, sizeof(ImDrawVert), draw_data->TotalVtxCount,
+                build_time.count() / 1'000'000.0 / FRAMES, render_time.count() / 1'000'000.0 / FRAMES);
+
+    std::vector<FloatVertex> float_vertices;
+    std::vector<CompactVertex> compact_vertices;
+    for (int n = 0; n < draw_data->CmdListsCount; ++n)
+    {
+        for (const ImDrawVert& vertex : draw_data->CmdLists[n]->VtxBuffer)
+        {
+            ImVec2 pos = vertex.pos;
+            ImVec2 uv = vertex.uv;
+            float_vertices.push_back({{pos.x, pos.y}, {uv.x, uv.y}, vertex.col});
+            compact_vertices.push_back({{to_fixed(pos.x, POS_ONE), to_fixed(pos.y, POS_ONE)},
+                                        {to_unsigned_fixed(uv.x, UV_ONE), to_unsigned_fixed(uv.y, UV_ONE)}, vertex.col});
+        }
+    }
+
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    double float_ms = upload_ms(buffer, float_vertices);
+    double compact_ms = upload_ms(buffer, compact_vertices);
+    glDeleteBuffers(1, &buffer);
+
+    size_t float_bytes = float_vertices.size() * sizeof(FloatVertex);
+    size_t compact_bytes = compact_vertices.size() * sizeof(CompactVertex);
+    std::printf("layout   bytes/vertex  bytes/frame  upload ms\n");
+    std::printf("float    %12zu  %11zu  %9.4f\n", sizeof(FloatVertex), float_bytes, float_ms);
+    std::printf("compact  %12zu  %11zu  %9.4f\n", sizeof(CompactVertex), compact_bytes, compact_ms);
+    std::printf("saved    %12zu  %11zu  %9.4f  (%.0f%% of the bytes)\n", sizeof(FloatVertex) - sizeof(CompactVertex),
+                float_bytes - compact_bytes, float_ms - compact_ms, 100.0 * (float_bytes - compact_bytes) / float_bytes);
+    return 0;
+}
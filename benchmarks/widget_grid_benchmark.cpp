@@ -0,0 +1,88 @@
+/* Compares a grid of ImGui::VSliderFloat() sliders with the same grid drawn
+ * through the instanced widget path of the OpenGL3 backend, reporting the
+ * bytes uploaded to the gpu and the number of draw calls per frame. Without
+ * GL 3.3 the second row is labelled fallback, as the backend then draws the
+ * widgets with regular primitives */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "benchmark_context.h"
+
+constexpr int WIDTH = 1024;
+constexpr int HEIGHT = 768;
+constexpr int FRAMES = 200;
+constexpr ImVec2 SLIDER_SIZE{12, 40};
+
+enum class Mode
+{
+    IMGUI,
+    INSTANCED
+};
+
+int main()
+{
+    BenchmarkContext context(WIDTH, HEIGHT);
+    if (!context.valid())
+    {
+        std::cerr << "Failed to set up OpenGL context" << std::endl;
+        return 1;
+    }
+
+    std::printf("mode       sliders  build ms  render ms  upload kB  draw calls\n");
+    for (int slider_count : {64, 256, 1024})
+    {
+        std::vector<float> values(slider_count);
+        std::vector<std::string> ids(slider_count);
+        for (int i = 0; i < slider_count; ++i)
+        {
+            ids[i] = "##" + std::to_string(i);
+        }
+        int columns = static_cast<int>(WIDTH / (SLIDER_SIZE.x + 4));
+        for (Mode mode : {Mode::IMGUI, Mode::INSTANCED})
+        {
+            std::chrono::nanoseconds build_time(0);
+            std::chrono::nanoseconds render_time(0);
+            for (int frame = 0; frame < FRAMES; ++frame)
+            {
+                auto start = std::chrono::steady_clock::now();
+                context.new_frame();
+                ImGui::SetNextWindowPos(ImVec2(0, 0));
+                ImGui::SetNextWindowSize(ImVec2(WIDTH, HEIGHT));
+                ImGui::Begin("grid", nullptr, ImGuiWindowFlags_NoDecoration);
+                for (int i = 0; i < slider_count; ++i)
+                {
+                    values[i] = static_cast<float>((i + frame) % 100) / 100.0f;
+                    if (i % columns != 0)
+                    {
+                        ImGui::SameLine(0, 4);
+                    }
+                    if (mode == Mode::IMGUI)
+                    {
+                        ImGui::VSliderFloat(ids[i].c_str(), SLIDER_SIZE, &values[i], 0.0f, 1.0f, "");
+                    }
+                    else
+                    {
+                        imgui_editor::instanced_vslider(ids[i].c_str(), SLIDER_SIZE, &values[i]);
+                    }
+                }
+                ImGui::End();
+                ImGui::Render();
+                auto split = std::chrono::steady_clock::now();
+                context.render();
+                auto end = std::chrono::steady_clock::now();
+                build_time += split - start;
+                render_time += end - split;
+            }
+            const auto& stats = ImGui_ImplOpenGL3_GetFrameStats();
+            int upload = stats.VertexBytes + stats.IndexBytes + stats.InstanceBytes;
+            const char* label = mode == Mode::IMGUI ? "imgui    " : ImGui_ImplOpenGL3_HasInstancedWidgets() ? "instanced" : "fallback ";
+            std::printf("%s  %7d  %8.3f  %9.3f  %9.1f  %10d\n", label, slider_count,
+                        build_time.count() / 1'000'000.0 / FRAMES, render_time.count() / 1'000'000.0 / FRAMES,
+                        upload / 1024.0, stats.DrawCalls);
+        }
+    }
+    return 0;
+}
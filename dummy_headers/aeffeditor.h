@@ -53,10 +53,16 @@ public:
         std::copy(_parameters[index].name.begin(), _parameters[index].name.end(), text);
     }
 
+    float getSampleRate()
+    {
+        return _sample_rate;
+    }
+
     static constexpr int PARAMETER_COUNT = 8;
 
 private:
     AEffect  _effect{.numParams = PARAMETER_COUNT};
+    float    _sample_rate{48000.0f};
 
     struct Parameter
     {
@@ -1,13 +1,89 @@
 #ifndef IMPLUGINGUI_IMGUI_EDITOR_H
 #define IMPLUGINGUI_IMGUI_EDITOR_H
 
+#include <cstdint>
+#include <future>
 #include <memory>
 
 #include "aeffeditor.h"
+#include "imgui_editor/sample_fifo.h"
 
 namespace imgui_editor {
 
-std::unique_ptr<AEffEditor> create_editor(AudioEffect* instance);
+/* If audio_fifo is not null, the editor displays the audio pushed
+ * to it from the dsp side in a scope. The fifo must outlive the editor */
+std::unique_ptr<AEffEditor> create_editor(AudioEffect* instance, SampleFifo* audio_fifo = nullptr);
+
+/* Frame timing of an editor since it was last opened, for stress testing */
+struct FrameTimeStats
+{
+    float open_latency_ms;  // From open() until the first frame was on screen, negative if it isn't yet
+    int   frames;           // Frames drawn since opened
+    float suspended_s;      // Time not drawing anything because the editor couldn't be seen
+    int   quality_level;    // Set by the quality governor, 0 is full quality
+    /* Time to draw, render and swap a frame, not counting time spent waiting for
+     * input, over the most recent frames */
+    float average_ms;
+    float p50_ms;
+    float p90_ms;
+    float p99_ms;
+    float max_ms;
+};
+
+/* editor must have been created with create_editor(), can be called from any thread */
+FrameTimeStats frame_time_stats(AEffEditor* editor);
+
+/* How long opening and closing an editor takes, from the last open() and close().
+ * Both calls return without waiting for the draw thread, which sets up and
+ * tears down the editor in the background */
+struct LifecycleStats
+{
+    float open_call_ms;     // Time spent in open(), i.e. the host's wait
+    float ready_ms;         // From open() until the first frame was on screen, negative if it isn't yet
+    float close_call_ms;    // Time spent in close()
+    float teardown_ms;      // From close() until the draw thread had torn down, negative if it hasn't yet
+};
+
+/* editor must have been created with create_editor(), can be called from any thread */
+LifecycleStats lifecycle_stats(AEffEditor* editor);
+
+/* Becomes true when the editor's first frame since the last open() is on screen,
+ * or false if it was closed or failed to set up before that. Invalid before the
+ * first open(). editor must have been created with create_editor(), must be
+ * called from the thread calling open() and close() */
+std::shared_future<bool> editor_ready(AEffEditor* editor);
+
+/* Becomes ready when the editor has finished tearing down after close(). Invalid
+ * before the first open(). editor must have been created with create_editor(),
+ * must be called from the thread calling open() and close() */
+std::shared_future<void> editor_closed(AEffEditor* editor);
+
+/* How the editor's draw thread gets scheduled, see the environment variables in
+ * the readme for keeping editors out of the way of the audio threads */
+struct SchedulingStats
+{
+    float run_delay_ms;     // Average wait for a cpu each time the draw thread was ready to run, recently. Linux only
+    float max_run_delay_ms; // Highest recent average since opened
+    float render_wait_ms;   // Smoothed wait for other editors to finish drawing, 0 without a limit
+};
+
+/* editor must have been created with create_editor(), can be called from any thread */
+SchedulingStats scheduling_stats(AEffEditor* editor);
+
+/* Memory used by an editor, for keeping track of memory budgets across instances */
+struct MemoryStats
+{
+    int64_t cpu_bytes;          // Allocated through ImGui, i.e. context, draw lists and font atlas, and the backends' state
+    int64_t cpu_peak_bytes;
+    int64_t cpu_allocations;    // Allocations made through ImGui since the editor was created
+    int64_t gpu_buffer_bytes;   // Estimated from the buffers and textures created by the renderer
+    int64_t gpu_texture_bytes;
+    int64_t framebuffer_bytes;  // Estimated, front and back buffer of the window
+    int64_t thread_stack_bytes; // Reserved for the draw thread, not necessarily in use, 0 if not known
+};
+
+/* editor must have been created with create_editor(), can be called from any thread */
+MemoryStats memory_stats(AEffEditor* editor);
 
 }
 #endif //IMPLUGINGUI_IMGUI_EDITOR_H
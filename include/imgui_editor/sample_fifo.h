@@ -0,0 +1,120 @@
+#ifndef IMPLUGINGUI_SAMPLE_FIFO_H
+#define IMPLUGINGUI_SAMPLE_FIFO_H
+
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+
+namespace imgui_editor {
+
+/* Wait-free single producer, single consumer fifo for passing audio data
+ * from the audio thread to the draw thread of an editor. push() never
+ * blocks, locks or allocates so it is safe to call from the audio callback.
+ * If the fifo is full, the samples that don't fit are dropped and counted
+ * as overruns. Capacity is rounded up to the nearest power of 2.
+ *
+ * The fifo is owned by the plugin and should outlive the editor, while
+ * the editor is closed the fifo is disabled and push() returns immediately */
+class SampleFifo
+{
+public:
+    explicit SampleFifo(int capacity = 16384) : _capacity(_round_up_pow2(capacity)),
+                                                _mask(_capacity - 1),
+                                                _buffer(std::make_unique<float[]>(_capacity))
+    {}
+
+    /* Called from the audio thread only. Returns the number of samples written */
+    int push(const float* samples, int count)
+    {
+        if (!_enabled.load(std::memory_order_relaxed))
+        {
+            return 0;
+        }
+        uint32_t write_pos = _write_pos.load(std::memory_order_relaxed);
+        uint32_t read_pos = _read_pos.load(std::memory_order_acquire);
+        int free_space = static_cast<int>(_capacity - (write_pos - read_pos));
+        int to_write = std::min(count, free_space);
+        if (to_write < count)
+        {
+            _overruns.fetch_add(count - to_write, std::memory_order_relaxed);
+        }
+        _copy_in(samples, write_pos, to_write);
+        _write_pos.store(write_pos + to_write, std::memory_order_release);
+        return to_write;
+    }
+
+    /* Called from the draw thread only. Returns the number of samples read */
+    int pop(float* samples, int max_count)
+    {
+        uint32_t read_pos = _read_pos.load(std::memory_order_relaxed);
+        uint32_t write_pos = _write_pos.load(std::memory_order_acquire);
+        int to_read = std::min(max_count, static_cast<int>(write_pos - read_pos));
+        _copy_out(samples, read_pos, to_read);
+        _read_pos.store(read_pos + to_read, std::memory_order_release);
+        return to_read;
+    }
+
+    /* Called from the draw thread only. Any stale data in the fifo is discarded */
+    void set_enabled(bool enabled)
+    {
+        _enabled.store(enabled, std::memory_order_relaxed);
+        _read_pos.store(_write_pos.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    bool enabled() const
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /* Total number of samples dropped because the fifo was full */
+    uint64_t overruns() const
+    {
+        return _overruns.load(std::memory_order_relaxed);
+    }
+
+    int capacity() const
+    {
+        return static_cast<int>(_capacity);
+    }
+
+private:
+    static uint32_t _round_up_pow2(int capacity)
+    {
+        uint32_t size = 1;
+        while (size < static_cast<uint32_t>(std::max(capacity, 2)))
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    void _copy_in(const float* samples, uint32_t pos, int count)
+    {
+        uint32_t start = pos & _mask;
+        int first = std::min(count, static_cast<int>(_capacity - start));
+        std::copy(samples, samples + first, _buffer.get() + start);
+        std::copy(samples + first, samples + count, _buffer.get());
+    }
+
+    void _copy_out(float* samples, uint32_t pos, int count) const
+    {
+        uint32_t start = pos & _mask;
+        int first = std::min(count, static_cast<int>(_capacity - start));
+        std::copy(_buffer.get() + start, _buffer.get() + start + first, samples);
+        std::copy(_buffer.get(), _buffer.get() + count - first, samples + first);
+    }
+
+    const uint32_t           _capacity;
+    const uint32_t           _mask;
+    std::unique_ptr<float[]> _buffer;
+
+    /* Keep producer and consumer indexes on separate cache lines */
+    alignas(64) std::atomic<uint32_t> _write_pos{0};
+    alignas(64) std::atomic<uint32_t> _read_pos{0};
+    alignas(64) std::atomic<uint64_t> _overruns{0};
+    std::atomic_bool                  _enabled{false};
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_SAMPLE_FIFO_H
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "asset_pack.h"
+
+namespace imgui_editor {
+
+constexpr const char* ASSET_PACK_ENV_VARIABLE = "VSTIMGUI_ASSET_PACK";
+
+static uint64_t aligned(uint64_t offset)
+{
+    return (offset + ASSET_PACK_ALIGNMENT - 1) & ~(ASSET_PACK_ALIGNMENT - 1);
+}
+
+void AssetPackWriter::add(const std::string& name, AssetType type, std::vector<uint8_t> data, int width, int height)
+{
+    _assets.push_back({name, type, std::move(data), width, height});
+}
+
+bool AssetPackWriter::write(const std::string& path) const
+{
+    std::vector<const PendingAsset*> assets;
+    for (const auto& asset : _assets)
+    {
+        assets.push_back(&asset);
+    }
+    std::sort(assets.begin(), assets.end(), [](const PendingAsset* a, const PendingAsset* b) {return a->name < b->name;});
+    for (size_t i = 1; i < assets.size(); ++i)
+    {
+        if (assets[i]->name == assets[i - 1]->name)
+        {
+            std::cerr << "More than one asset called " << assets[i]->name << std::endl;
+            return false;
+        }
+    }
+
+    AssetPackHeader header{};
+    std::memcpy(header.magic, ASSET_PACK_MAGIC, sizeof(header.magic));
+    header.version = ASSET_PACK_VERSION;
+    header.entry_count = static_cast<uint32_t>(assets.size());
+    header.index_offset = sizeof(header);
+    header.names_offset = header.index_offset + assets.size() * sizeof(AssetPackEntry);
+
+    std::vector<AssetPackEntry> entries;
+    std::string names;
+    uint64_t names_size = 0;
+    for (const auto* asset : assets)
+    {
+        names_size += asset->name.size() + 1;
+    }
+    uint64_t offset = aligned(header.names_offset + names_size);
+    for (const auto* asset : assets)
+    {
+        AssetPackEntry entry{offset, asset->data.size(), static_cast<uint32_t>(names.size()), asset->type,
+                             static_cast<uint32_t>(asset->width), static_cast<uint32_t>(asset->height)};
+        entries.push_back(entry);
+        names.append(asset->name);
+        names.push_back(0);
+        offset = aligned(offset + asset->data.size());
+    }
+
+    /* Written next to the pack and renamed over it when complete, so processes that
+     * have the old pack mapped keep it and no one maps a partly written one */
+    std::string temporary_path = path + ".tmp";
+    std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open " << temporary_path << " for writing" << std::endl;
+        return false;
+    }
+    uint64_t position = 0;
+    auto write = [&](const void* data, size_t size)
+    {
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        position += size;
+    };
+    auto pad = [&]()
+    {
+        static const char zeros[ASSET_PACK_ALIGNMENT] = {};
+        write(zeros, aligned(position) - position);
+    };
+    write(&header, sizeof(header));
+    write(entries.data(), entries.size() * sizeof(AssetPackEntry));
+    write(names.data(), names.size());
+    for (const auto* asset : assets)
+    {
+        pad();
+        write(asset->data.data(), asset->data.size());
+    }
+    file.close();
+    if (!file)
+    {
+        std::cerr << "Failed to write " << temporary_path << std::endl;
+        std::error_code error;
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error)
+    {
+        std::cerr << "Failed to replace " << path << ": " << error.message() << std::endl;
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+    return true;
+}
+
+AssetPack::~AssetPack()
+{
+    _unmap();
+}
+
+bool AssetPack::open(const std::string& path)
+{
+    _unmap();
+    if (!_mapping.open(path))
+    {
+        return false;
+    }
+
+    if (_mapping.size() < sizeof(_header))
+    {
+        std::cerr << path << " is not an asset pack" << std::endl;
+        _unmap();
+        return false;
+    }
+    std::memcpy(&_header, _mapping.data(), sizeof(_header));
+    bool valid = std::memcmp(_header.magic, ASSET_PACK_MAGIC, sizeof(_header.magic)) == 0 &&
+                 _header.version == ASSET_PACK_VERSION &&
+                 _header.index_offset % alignof(AssetPackEntry) == 0 &&
+                 _header.index_offset + _header.entry_count * sizeof(AssetPackEntry) <= _header.names_offset &&
+                 _header.names_offset <= _mapping.size();
+    if (valid)
+    {
+        _entries = reinterpret_cast<const AssetPackEntry*>(_mapping.data() + _header.index_offset);
+        _names = reinterpret_cast<const char*>(_mapping.data() + _header.names_offset);
+        size_t names_size = _mapping.size() - _header.names_offset;
+        /* Check everything once here, so lookups can trust the index */
+        for (uint32_t i = 0; i < _header.entry_count && valid; ++i)
+        {
+            const auto& entry = _entries[i];
+            valid = entry.offset <= _mapping.size() && entry.size <= _mapping.size() - entry.offset &&
+                    entry.name_offset < names_size &&
+                    std::memchr(_names + entry.name_offset, 0, names_size - entry.name_offset) != nullptr &&
+                    (entry.type != AssetType::IMAGE_RGBA || uint64_t(entry.width) * entry.height * 4 == entry.size);
+        }
+    }
+    if (!valid)
+    {
+        std::cerr << path << " is not an asset pack or is damaged" << std::endl;
+        _unmap();
+        return false;
+    }
+    return true;
+}
+
+bool AssetPack::find(std::string_view name, Asset& asset) const
+{
+    if (_mapping.data() == nullptr)
+    {
+        return false;
+    }
+    const AssetPackEntry* end = _entries + _header.entry_count;
+    const AssetPackEntry* entry = std::lower_bound(_entries, end, name, [this](const AssetPackEntry& entry, std::string_view name)
+    {
+        return std::string_view(_names + entry.name_offset) < name;
+    });
+    if (entry == end || std::string_view(_names + entry->name_offset) != name)
+    {
+        return false;
+    }
+    asset = {_mapping.data() + entry->offset, static_cast<size_t>(entry->size), entry->type,
+             static_cast<int>(entry->width), static_cast<int>(entry->height)};
+    return true;
+}
+
+const AssetPack* AssetPack::process()
+{
+    static AssetPack pack;
+    static bool opened = []
+    {
+        const char* path = std::getenv(ASSET_PACK_ENV_VARIABLE);
+#ifdef VSTIMGUI_ASSET_PACK_PATH
+        if (path == nullptr || path[0] == 0)
+        {
+            path = VSTIMGUI_ASSET_PACK_PATH;
+        }
+#endif
+        return path != nullptr && path[0] != 0 && pack.open(path);
+    }();
+    return opened ? &pack : nullptr;
+}
+
+void AssetPack::_unmap()
+{
+    _mapping.close();
+    _header = AssetPackHeader();
+    _entries = nullptr;
+    _names = nullptr;
+}
+
+} // imgui_editor
@@ -0,0 +1,129 @@
+#ifndef IMPLUGINGUI_ASSET_PACK_H
+#define IMPLUGINGUI_ASSET_PACK_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.h"
+
+namespace imgui_editor {
+
+/* A skin's fonts and images in one file, built with the asset_packer tool and
+ * memory mapped once per process, so all editor instances share the same pages
+ * through the page cache and use the assets straight from the mapping.
+ *
+ * The file starts with an AssetPackHeader, followed by an index of
+ * AssetPackEntries sorted by name, the names, each zero terminated, and the
+ * assets themselves, each aligned to ASSET_PACK_ALIGNMENT bytes. Fonts are
+ * stored as TrueType or OpenType files, images decoded to 8 bit RGBA pixels so
+ * they can be uploaded as textures without decoding or copying them first.
+ * Everything is in native byte order */
+constexpr char ASSET_PACK_MAGIC[4] = {'I', 'M', 'A', 'P'};
+constexpr uint32_t ASSET_PACK_VERSION = 1;
+constexpr uint64_t ASSET_PACK_ALIGNMENT = 64;
+
+enum class AssetType : uint32_t
+{
+    BLOB,
+    FONT,
+    IMAGE_RGBA
+};
+
+struct AssetPackHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t reserved;
+    uint64_t index_offset;
+    uint64_t names_offset;
+};
+
+struct AssetPackEntry
+{
+    uint64_t  offset;
+    uint64_t  size;
+    uint32_t  name_offset;  // From the start of the names
+    AssetType type;
+    uint32_t  width;        // Of images, 0 otherwise
+    uint32_t  height;
+};
+
+struct Asset
+{
+    const uint8_t* data;
+    size_t         size;
+    AssetType      type;
+    int            width;
+    int            height;
+};
+
+/* Collects assets and writes them to a pack file */
+class AssetPackWriter
+{
+public:
+    void add(const std::string& name, AssetType type, std::vector<uint8_t> data, int width = 0, int height = 0);
+
+    /* Replaces the file at path only once the new pack is complete, processes
+     * that have the old one mapped keep using it */
+    bool write(const std::string& path) const;
+
+private:
+    struct PendingAsset
+    {
+        std::string          name;
+        AssetType            type;
+        std::vector<uint8_t> data;
+        int                  width;
+        int                  height;
+    };
+
+    std::vector<PendingAsset> _assets;
+};
+
+/* Memory maps a pack file read only. Lookups don't allocate, assets stay valid
+ * as long as the pack is open */
+class AssetPack
+{
+public:
+    AssetPack() = default;
+
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& path);
+
+    /* False if there's no asset called name */
+    bool find(std::string_view name, Asset& asset) const;
+
+    int assets() const
+    {
+        return static_cast<int>(_header.entry_count);
+    }
+
+    size_t bytes() const
+    {
+        return _mapping.size();
+    }
+
+    /* The pack shared by all editors in the process, opened on first use from
+     * the path in the environment variable VSTIMGUI_ASSET_PACK or, without it,
+     * the one set at build time. Null if there's no pack or it failed to open */
+    static const AssetPack* process();
+
+private:
+    void _unmap();
+
+    MappedFile            _mapping;
+    AssetPackHeader       _header{};
+    const AssetPackEntry* _entries{nullptr};
+    const char*           _names{nullptr};
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_ASSET_PACK_H
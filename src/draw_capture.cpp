@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "draw_capture.h"
+
+namespace imgui_editor {
+
+constexpr size_t ALIGNMENT = 8;
+
+static size_t aligned(size_t size)
+{
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+static void append(std::vector<uint8_t>& buffer, const void* data, size_t size)
+{
+    auto start = buffer.size();
+    buffer.resize(start + aligned(size), 0);
+    std::memcpy(buffer.data() + start, data, size);
+}
+
+/* Which of the OpenGL3 backend's callbacks cmd is, if any */
+static uint32_t callback_type(const ImDrawCmd& cmd)
+{
+    const ImVec2* points;
+    int points_count;
+    ImU32 col;
+    float thickness;
+    ImGui_ImplOpenGL3_WidgetType type;
+    const ImGui_ImplOpenGL3_WidgetInstance* instances;
+    int instances_count;
+    if (cmd.UserCallback == nullptr)
+    {
+        return DRAW_CAPTURE_NO_CALLBACK;
+    }
+    if (ImGui_ImplOpenGL3_GetPolyline(&cmd, &points, &points_count, &col, &thickness))
+    {
+        return DRAW_CAPTURE_POLYLINE;
+    }
+    if (ImGui_ImplOpenGL3_GetWidgets(&cmd, &type, &instances, &instances_count))
+    {
+        return DRAW_CAPTURE_WIDGETS;
+    }
+    return DRAW_CAPTURE_NO_CALLBACK;
+}
+
+static void append_callback(std::vector<uint8_t>& buffer, const ImDrawCmd& cmd)
+{
+    const ImVec2* points;
+    int points_count;
+    ImU32 col;
+    float thickness;
+    ImGui_ImplOpenGL3_WidgetType type;
+    const ImGui_ImplOpenGL3_WidgetInstance* instances;
+    int instances_count;
+    if (ImGui_ImplOpenGL3_GetPolyline(&cmd, &points, &points_count, &col, &thickness))
+    {
+        DrawCaptureCallback callback{static_cast<uint32_t>(points_count), col, thickness, 0};
+        append(buffer, &callback, sizeof(callback));
+        append(buffer, points, points_count * sizeof(ImVec2));
+    }
+    else if (ImGui_ImplOpenGL3_GetWidgets(&cmd, &type, &instances, &instances_count))
+    {
+        DrawCaptureCallback callback{static_cast<uint32_t>(instances_count), 0, 0, static_cast<uint32_t>(type)};
+        append(buffer, &callback, sizeof(callback));
+        append(buffer, instances, instances_count * sizeof(ImGui_ImplOpenGL3_WidgetInstance));
+    }
+}
+
+DrawCallbackFunctions opengl3_callbacks()
+{
+    return {ImGui_ImplOpenGL3_SetPolyline, ImGui_ImplOpenGL3_SetWidgets};
+}
+
+DrawCaptureWriter::~DrawCaptureWriter()
+{
+    close();
+}
+
+bool DrawCaptureWriter::open(const std::string& path)
+{
+    _file.open(path, std::ios::binary | std::ios::trunc);
+    if (!_file.is_open())
+    {
+        std::cerr << "Failed to open " << path << " for capturing" << std::endl;
+        return false;
+    }
+    std::memcpy(_header.magic, DRAW_CAPTURE_MAGIC, sizeof(_header.magic));
+    _header.version = DRAW_CAPTURE_VERSION;
+    _header.vertex_size = sizeof(ImDrawVert);
+    _header.index_size = sizeof(ImDrawIdx);
+    /* Filled in for real when closing */
+    _write(&_header, sizeof(_header));
+    return true;
+}
+
+void DrawCaptureWriter::write_frame(const ImDrawData* draw_data)
+{
+    if (!_file.is_open() || draw_data == nullptr || !draw_data->Valid)
+    {
+        return;
+    }
+    _write_atlas();
+
+    _frame.clear();
+    DrawCaptureFrame frame{{draw_data->DisplayPos.x, draw_data->DisplayPos.y},
+                           {draw_data->DisplaySize.x, draw_data->DisplaySize.y},
+                           {draw_data->FramebufferScale.x, draw_data->FramebufferScale.y},
+                           static_cast<uint32_t>(draw_data->CmdListsCount), static_cast<uint32_t>(_atlases.size() - 1)};
+    append(_frame, &frame, sizeof(frame));
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        _callbacks.clear();
+        DrawCaptureList list{static_cast<uint32_t>(cmd_list->VtxBuffer.Size), static_cast<uint32_t>(cmd_list->IdxBuffer.Size), 0, 0};
+        for (const ImDrawCmd& cmd : cmd_list->CmdBuffer)
+        {
+            uint32_t callback = callback_type(cmd);
+            list.command_count += cmd.UserCallback == nullptr || callback != DRAW_CAPTURE_NO_CALLBACK ? 1 : 0;
+            list.dropped_count += cmd.UserCallback != nullptr && callback == DRAW_CAPTURE_NO_CALLBACK ? 1 : 0;
+        }
+        append(_frame, &list, sizeof(list));
+        append(_frame, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.size_in_bytes());
+        append(_frame, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.size_in_bytes());
+        for (const ImDrawCmd& cmd : cmd_list->CmdBuffer)
+        {
+            uint32_t callback = callback_type(cmd);
+            if (cmd.UserCallback != nullptr && callback == DRAW_CAPTURE_NO_CALLBACK)
+            {
+                continue;
+            }
+            DrawCaptureCommand command{{cmd.ClipRect.x, cmd.ClipRect.y, cmd.ClipRect.z, cmd.ClipRect.w},
+                                       reinterpret_cast<uintptr_t>(cmd.TextureId), cmd.VtxOffset, cmd.IdxOffset, cmd.ElemCount, callback};
+            append(_frame, &command, sizeof(command));
+            if (callback != DRAW_CAPTURE_NO_CALLBACK)
+            {
+                _callbacks.push_back(&cmd);
+            }
+        }
+        /* The contents of the callbacks follow all commands of the list */
+        for (const ImDrawCmd* cmd : _callbacks)
+        {
+            append_callback(_frame, *cmd);
+        }
+    }
+
+    _header.max_width = std::max(_header.max_width, static_cast<uint32_t>(draw_data->DisplaySize.x * draw_data->FramebufferScale.x));
+    _header.max_height = std::max(_header.max_height, static_cast<uint32_t>(draw_data->DisplaySize.y * draw_data->FramebufferScale.y));
+    if (!_frame_offsets.empty() && _frame == _previous_frame)
+    {
+        _frame_offsets.push_back(_frame_offsets.back());
+        return;
+    }
+    _frame_offsets.push_back(_offset);
+    _write(_frame.data(), _frame.size());
+    std::swap(_frame, _previous_frame);
+}
+
+void DrawCaptureWriter::close()
+{
+    if (!_file.is_open())
+    {
+        return;
+    }
+    _header.frame_count = static_cast<uint32_t>(_frame_offsets.size());
+    _header.index_offset = _offset;
+    _write(_frame_offsets.data(), _frame_offsets.size() * sizeof(uint64_t));
+    _header.atlas_count = static_cast<uint32_t>(_atlases.size());
+    _header.atlas_index_offset = _offset;
+    _write(_atlases.data(), _atlases.size() * sizeof(DrawCaptureAtlas));
+    _file.seekp(0);
+    _file.write(reinterpret_cast<const char*>(&_header), sizeof(_header));
+    _file.close();
+}
+
+void DrawCaptureWriter::_write_atlas()
+{
+    /* The atlas is only guaranteed to be built once a frame has been rendered.
+     * A new glyph changes the pixels and a full atlas doubles in height, which
+     * changes all texture coordinates, so either needs a new revision */
+    ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+    unsigned char* pixels;
+    int width, height;
+    fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    uint32_t glyphs = 0;
+    for (const ImFont* font : fonts->Fonts)
+    {
+        glyphs += static_cast<uint32_t>(font->Glyphs.Size);
+    }
+    DrawCaptureAtlas atlas{reinterpret_cast<uintptr_t>(fonts->TexID), _offset, static_cast<uint32_t>(width),
+                           static_cast<uint32_t>(height), glyphs, 0};
+    if (!_atlases.empty())
+    {
+        const DrawCaptureAtlas& last = _atlases.back();
+        if (last.texture_id == atlas.texture_id && last.width == atlas.width && last.height == atlas.height && last.glyphs == atlas.glyphs)
+        {
+            return;
+        }
+    }
+    _atlases.push_back(atlas);
+    size_t size = static_cast<size_t>(width) * height * 4;
+    _write(pixels, size);
+    const uint8_t padding[ALIGNMENT] = {};
+    _write(padding, aligned(size) - size);
+}
+
+void DrawCaptureWriter::_write(const void* data, size_t size)
+{
+    _file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    _offset += size;
+}
+
+DrawCapture::~DrawCapture()
+{
+    _release_lists();
+    _unmap();
+}
+
+bool DrawCapture::open(const std::string& path)
+{
+    _release_lists();
+    _unmap();
+    if (!_mapping.open(path))
+    {
+        return false;
+    }
+
+    if (_mapping.size() < sizeof(_header))
+    {
+        std::cerr << path << " is not a capture file" << std::endl;
+        _unmap();
+        return false;
+    }
+    std::memcpy(&_header, _mapping.data(), sizeof(_header));
+    bool valid = std::memcmp(_header.magic, DRAW_CAPTURE_MAGIC, sizeof(_header.magic)) == 0 &&
+                 _header.version == DRAW_CAPTURE_VERSION &&
+                 _header.index_offset + _header.frame_count * sizeof(uint64_t) <= _mapping.size() &&
+                 _header.atlas_index_offset + _header.atlas_count * sizeof(DrawCaptureAtlas) <= _mapping.size();
+    for (uint32_t i = 0; valid && i < _header.atlas_count; i++)
+    {
+        DrawCaptureAtlas atlas;
+        std::memcpy(&atlas, _mapping.data() + _header.atlas_index_offset + i * sizeof(DrawCaptureAtlas), sizeof(atlas));
+        valid = atlas.offset + static_cast<uint64_t>(atlas.width) * atlas.height * 4 <= _mapping.size();
+    }
+    if (!valid)
+    {
+        std::cerr << path << " is not a capture file or was not closed properly" << std::endl;
+        _unmap();
+        return false;
+    }
+    /* The vertex format can be changed in imconfig.h */
+    if (_header.vertex_size != sizeof(ImDrawVert) || _header.index_size != sizeof(ImDrawIdx))
+    {
+        std::cerr << path << " was captured with a different vertex or index format" << std::endl;
+        _unmap();
+        return false;
+    }
+    _frame_offsets = reinterpret_cast<const uint64_t*>(_mapping.data() + _header.index_offset);
+    _atlases = reinterpret_cast<const DrawCaptureAtlas*>(_mapping.data() + _header.atlas_index_offset);
+    return true;
+}
+
+int DrawCapture::unique_frames() const
+{
+    int count = 0;
+    for (uint32_t i = 0; i < _header.frame_count; i++)
+    {
+        count += i == 0 || _frame_offsets[i] != _frame_offsets[i - 1] ? 1 : 0;
+    }
+    return count;
+}
+
+const void* DrawCapture::atlas_pixels(int index) const
+{
+    return _mapping.data() && index >= 0 && index < atlases() ? _mapping.data() + _atlases[index].offset : nullptr;
+}
+
+int DrawCapture::frame_atlas(int index) const
+{
+    if (_mapping.data() == nullptr || index < 0 || index >= frames() ||
+        _frame_offsets[index] + sizeof(DrawCaptureFrame) > _header.index_offset)
+    {
+        return -1;
+    }
+    auto frame = reinterpret_cast<const DrawCaptureFrame*>(_mapping.data() + _frame_offsets[index]);
+    return frame->atlas < _header.atlas_count ? static_cast<int>(frame->atlas) : -1;
+}
+
+ImDrawData* DrawCapture::frame(int index, ImTextureID font_texture, ImTextureID other_texture, const DrawCallbackFunctions* callbacks)
+{
+    _release_lists();
+    if (_mapping.data() == nullptr || index < 0 || index >= frames())
+    {
+        return nullptr;
+    }
+    const uint8_t* read_pos = _mapping.data() + _frame_offsets[index];
+    const uint8_t* end = _mapping.data() + _header.index_offset;
+    auto take = [&](size_t size) -> const uint8_t*
+    {
+        const uint8_t* data = read_pos;
+        read_pos += aligned(size);
+        return read_pos <= end ? data : nullptr;
+    };
+
+    auto frame = reinterpret_cast<const DrawCaptureFrame*>(take(sizeof(DrawCaptureFrame)));
+    if (frame == nullptr || frame->atlas >= _header.atlas_count)
+    {
+        return nullptr;
+    }
+    uint64_t font_texture_id = _atlases[frame->atlas].texture_id;
+    _draw_data = ImDrawData();
+    _draw_data.Valid = true;
+    _draw_data.DisplayPos = ImVec2(frame->display_pos[0], frame->display_pos[1]);
+    _draw_data.DisplaySize = ImVec2(frame->display_size[0], frame->display_size[1]);
+    _draw_data.FramebufferScale = ImVec2(frame->framebuffer_scale[0], frame->framebuffer_scale[1]);
+
+    while (_lists.size() < frame->list_count)
+    {
+        _lists.push_back(std::make_unique<ImDrawList>(nullptr));
+    }
+    _list_pointers.clear();
+    for (uint32_t n = 0; n < frame->list_count; n++)
+    {
+        auto list = reinterpret_cast<const DrawCaptureList*>(take(sizeof(DrawCaptureList)));
+        auto vertices = list ? take(list->vertex_count * sizeof(ImDrawVert)) : nullptr;
+        auto indices = vertices ? take(list->index_count * sizeof(ImDrawIdx)) : nullptr;
+        auto commands = indices ? reinterpret_cast<const DrawCaptureCommand*>(take(list->command_count * sizeof(DrawCaptureCommand))) : nullptr;
+        if (commands == nullptr)
+        {
+            std::cerr << "Capture frame " << index << " is truncated" << std::endl;
+            _release_lists();
+            return nullptr;
+        }
+        _dropped_commands += static_cast<int>(list->dropped_count);
+
+        /* Vertices and indices are only ever read by the renderer, so the
+         * buffers can borrow the mapping, they are handed back before the
+         * list is reused or destroyed in _release_lists() */
+        ImDrawList* draw_list = _lists[n].get();
+        draw_list->VtxBuffer.Data = const_cast<ImDrawVert*>(reinterpret_cast<const ImDrawVert*>(vertices));
+        draw_list->VtxBuffer.Size = static_cast<int>(list->vertex_count);
+        draw_list->IdxBuffer.Data = const_cast<ImDrawIdx*>(reinterpret_cast<const ImDrawIdx*>(indices));
+        draw_list->IdxBuffer.Size = static_cast<int>(list->index_count);
+        draw_list->CmdBuffer.resize(0);
+        for (uint32_t i = 0; i < list->command_count; i++)
+        {
+            const DrawCaptureCommand& command = commands[i];
+            ImDrawCmd cmd;
+            cmd.ClipRect = ImVec4(command.clip_rect[0], command.clip_rect[1], command.clip_rect[2], command.clip_rect[3]);
+            cmd.TextureId = command.texture_id == font_texture_id ? font_texture : other_texture;
+            cmd.VtxOffset = command.vertex_offset;
+            cmd.IdxOffset = command.index_offset;
+            cmd.ElemCount = command.element_count;
+            if (command.callback != DRAW_CAPTURE_NO_CALLBACK)
+            {
+                /* The contents are read in order, whether the command is replayed or not */
+                auto callback = reinterpret_cast<const DrawCaptureCallback*>(take(sizeof(DrawCaptureCallback)));
+                size_t element_size = command.callback == DRAW_CAPTURE_POLYLINE ? sizeof(ImVec2) : sizeof(ImGui_ImplOpenGL3_WidgetInstance);
+                auto elements = callback ? take(callback->count * element_size) : nullptr;
+                if (elements == nullptr)
+                {
+                    std::cerr << "Capture frame " << index << " is truncated" << std::endl;
+                    _release_lists();
+                    return nullptr;
+                }
+                bool added = false;
+                if (callbacks && command.callback == DRAW_CAPTURE_POLYLINE)
+                {
+                    added = callbacks->polyline(&cmd, reinterpret_cast<const ImVec2*>(elements), static_cast<int>(callback->count),
+                                                callback->colour, callback->thickness);
+                }
+                else if (callbacks && command.callback == DRAW_CAPTURE_WIDGETS)
+                {
+                    added = callbacks->widgets(&cmd, static_cast<ImGui_ImplOpenGL3_WidgetType>(callback->widget_type),
+                                               reinterpret_cast<const ImGui_ImplOpenGL3_WidgetInstance*>(elements),
+                                               static_cast<int>(callback->count));
+                }
+                if (!added)
+                {
+                    _dropped_commands++;
+                    continue;
+                }
+            }
+            draw_list->CmdBuffer.push_back(cmd);
+        }
+        _list_pointers.push_back(draw_list);
+        _draw_data.TotalVtxCount += draw_list->VtxBuffer.Size;
+        _draw_data.TotalIdxCount += draw_list->IdxBuffer.Size;
+    }
+    _draw_data.CmdListsCount = static_cast<int>(_list_pointers.size());
+    _draw_data.CmdLists = _list_pointers.data();
+    return &_draw_data;
+}
+
+void DrawCapture::_release_lists()
+{
+    for (auto& list : _lists)
+    {
+        list->VtxBuffer.Data = nullptr;
+        list->VtxBuffer.Size = 0;
+        list->IdxBuffer.Data = nullptr;
+        list->IdxBuffer.Size = 0;
+    }
+    _list_pointers.clear();
+    _draw_data = ImDrawData();
+    _dropped_commands = 0;
+}
+
+void DrawCapture::_unmap()
+{
+    _mapping.close();
+    _header = DrawCaptureHeader();
+    _frame_offsets = nullptr;
+    _atlases = nullptr;
+}
+
+} // imgui_editor
@@ -0,0 +1,244 @@
+#ifndef IMPLUGINGUI_DRAW_CAPTURE_H
+#define IMPLUGINGUI_DRAW_CAPTURE_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "imgui.h"
+#include "imgui_impl_opengl3.h"
+#include "mapped_file.h"
+
+namespace imgui_editor {
+
+/* Records the draw data of every frame of a session to a file, to reproduce
+ * rendering performance problems without the plugin that caused them.
+ *
+ * The file starts with a DrawCaptureHeader, followed by the frames, an index
+ * with the file offset of each frame and an index of the font atlases.
+ * Glyphs are added to the atlas on demand and it grows when full, so the atlas
+ * is stored as RGBA pixels before the first frame and again before any frame
+ * it changed for, and each frame refers to the atlas it was drawn with.
+ * Each frame is a DrawCaptureFrame followed by its draw lists, each one a
+ * DrawCaptureList followed by its vertices, indices, DrawCaptureCommands and
+ * the contents of its callback commands, all 8 byte aligned so vertex and index
+ * buffers can be used straight from a
+ * memory mapping. A frame identical to the one before it isn't stored again,
+ * its index entry points to the previous one, so idle stretches cost 8 bytes
+ * per frame. Everything is in native byte order.
+ *
+ * Texture ids are stored as they were, the font atlas' with the atlas. Draw
+ * callbacks can't be replayed in another process, but the polylines and
+ * instanced widgets the OpenGL3 backend draws through them are stored as a
+ * DrawCaptureCallback each, followed by the points or widget instances, and
+ * added to the backend again on replay. Other callbacks are left out and only
+ * counted */
+constexpr char DRAW_CAPTURE_MAGIC[4] = {'I', 'M', 'D', 'C'};
+constexpr uint32_t DRAW_CAPTURE_VERSION = 3;
+
+/* DrawCaptureCommand::callback */
+constexpr uint32_t DRAW_CAPTURE_NO_CALLBACK = 0;
+constexpr uint32_t DRAW_CAPTURE_POLYLINE = 1;
+constexpr uint32_t DRAW_CAPTURE_WIDGETS = 2;
+
+struct DrawCaptureHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t vertex_size;
+    uint32_t index_size;
+    uint32_t frame_count;
+    uint32_t max_width;
+    uint32_t max_height;
+    uint32_t atlas_count;
+    uint32_t reserved[2];
+    uint64_t atlas_index_offset;
+    uint64_t index_offset;
+};
+
+/* One revision of the font atlas, the pixels are at offset */
+struct DrawCaptureAtlas
+{
+    uint64_t texture_id;
+    uint64_t offset;
+    uint32_t width;
+    uint32_t height;
+    uint32_t glyphs;
+    uint32_t reserved;
+};
+
+struct DrawCaptureFrame
+{
+    float    display_pos[2];
+    float    display_size[2];
+    float    framebuffer_scale[2];
+    uint32_t list_count;
+    uint32_t atlas;         // Index of the atlas revision
+};
+
+struct DrawCaptureList
+{
+    uint32_t vertex_count;
+    uint32_t index_count;
+    uint32_t command_count;
+    uint32_t dropped_count;     // Callbacks that couldn't be stored
+};
+
+struct DrawCaptureCommand
+{
+    float    clip_rect[4];
+    uint64_t texture_id;
+    uint32_t vertex_offset;
+    uint32_t index_offset;
+    uint32_t element_count;
+    uint32_t callback;
+};
+
+struct DrawCaptureCallback
+{
+    uint32_t count;             // Points or widget instances following
+    uint32_t colour;
+    float    thickness;
+    uint32_t widget_type;
+};
+
+/* Turn captured polylines and widgets back into draw callbacks of a renderer,
+ * each returns false if the renderer can't draw them */
+struct DrawCallbackFunctions
+{
+    bool (*polyline)(ImDrawCmd* cmd, const ImVec2* points, int points_count, ImU32 col, float thickness);
+    bool (*widgets)(ImDrawCmd* cmd, ImGui_ImplOpenGL3_WidgetType type, const ImGui_ImplOpenGL3_WidgetInstance* instances, int instances_count);
+};
+
+/* The OpenGL3 backend's polylines and instanced widgets, call its NewFrame() before each frame */
+DrawCallbackFunctions opengl3_callbacks();
+
+/* Writes frames to a capture file. Must be used from the thread of the
+ * ImGui context whose frames are captured */
+class DrawCaptureWriter
+{
+public:
+    DrawCaptureWriter() = default;
+
+    ~DrawCaptureWriter();
+
+    bool open(const std::string& path);
+
+    /* Appends the frame, call after ImGui::Render() */
+    void write_frame(const ImDrawData* draw_data);
+
+    /* Writes the frame index and completes the file, called by the destructor if not called before */
+    void close();
+
+    bool is_open() const
+    {
+        return _file.is_open();
+    }
+
+    int frames() const
+    {
+        return static_cast<int>(_frame_offsets.size());
+    }
+
+    /* Bytes written so far */
+    uint64_t bytes() const
+    {
+        return _offset;
+    }
+
+private:
+    /* Stores the atlas if it changed since the last frame */
+    void _write_atlas();
+
+    void _write(const void* data, size_t size);
+
+    std::ofstream         _file;
+    DrawCaptureHeader     _header{};
+    uint64_t              _offset{0};
+    std::vector<DrawCaptureAtlas> _atlases;
+    std::vector<uint64_t> _frame_offsets;
+    std::vector<uint8_t>  _frame;
+    std::vector<uint8_t>  _previous_frame;
+    std::vector<const ImDrawCmd*> _callbacks;
+};
+
+/* Memory maps a capture file and presents its frames as ImDrawData for any
+ * renderer backend. Vertex and index buffers point into the mapping, nothing
+ * is copied except the commands, whose texture ids have to be replaced */
+class DrawCapture
+{
+public:
+    DrawCapture() = default;
+
+    ~DrawCapture();
+
+    DrawCapture(const DrawCapture&) = delete;
+
+    DrawCapture& operator=(const DrawCapture&) = delete;
+
+    bool open(const std::string& path);
+
+    int frames() const
+    {
+        return static_cast<int>(_header.frame_count);
+    }
+
+    /* Frames that are stored, i.e. not repeats of the frame before */
+    int unique_frames() const;
+
+    const DrawCaptureHeader& header() const
+    {
+        return _header;
+    }
+
+    int atlases() const
+    {
+        return static_cast<int>(_header.atlas_count);
+    }
+
+    const DrawCaptureAtlas& atlas(int index) const
+    {
+        return _atlases[index];
+    }
+
+    /* Revision index of the font atlas as width * height RGBA pixels */
+    const void* atlas_pixels(int index) const;
+
+    /* The atlas revision frame index was drawn with, its texture has to be
+     * passed to frame(). -1 if the frame is out of range */
+    int frame_atlas(int index) const;
+
+    /* Returns frame index as draw data, valid until the next call. The
+     * captured font atlas id is replaced with font_texture, which must hold
+     * the frame's atlas revision, and all other texture ids with other_texture,
+     * as they only meant something to the renderer that drew them. Polylines
+     * and widgets are added through callbacks, or left out if it's null */
+    ImDrawData* frame(int index, ImTextureID font_texture, ImTextureID other_texture,
+                      const DrawCallbackFunctions* callbacks = nullptr);
+
+    /* Callback commands of the last frame returned that are missing from its
+     * draw data, as they weren't captured or can't be drawn by the renderer */
+    int dropped_commands() const
+    {
+        return _dropped_commands;
+    }
+
+private:
+    void _release_lists();
+
+    void _unmap();
+
+    MappedFile       _mapping;
+    DrawCaptureHeader _header{};
+    const uint64_t*  _frame_offsets{nullptr};
+    const DrawCaptureAtlas* _atlases{nullptr};
+    ImDrawData       _draw_data{};
+    int              _dropped_commands{0};
+    std::vector<std::unique_ptr<ImDrawList>> _lists;
+    std::vector<ImDrawList*> _list_pointers;
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_DRAW_CAPTURE_H
@@ -1,84 +1,335 @@
 #include <iostream>
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <array>
 #include <string>
 #include <algorithm>
 #include <iostream>
 
+#include "asset_pack.h"
 #include "editor.h"
+#ifndef VSTIMGUI_FONT_IN_ASSET_PACK
 #include "font.h"
+#endif
+#include "layout.h"
 
 #ifdef LINUX
 #include <X11/Xlib.h>
+#include <pthread.h>
 #endif
 
 thread_local ImGuiContext* MyImGuiTLS;
 
 constexpr int WINDOW_WIDTH = 500;
-constexpr int WINDOW_HEIGHT = 320;
-constexpr int PARAM_SPACING = 50;
+constexpr int WINDOW_HEIGHT = 580;
 constexpr int MAX_PARAMETERS = 10;
 constexpr int PING_INTERVALL = 300;
 constexpr float SMOOTH_FACT = 0.05;
-const char* glsl_version = "#version 130";
+constexpr int SCOPE_LENGTH = 2048;
+constexpr ImVec2 SCOPE_POS{260, 190};
+constexpr ImVec2 SCOPE_SIZE{230, 120};
+constexpr int ANALYZER_FFT_SIZE = 4096;
+constexpr ImVec2 ANALYZER_POS{260, 320};
+constexpr ImVec2 ANALYZER_SIZE{230, 120};
+constexpr float ANALYZER_MIN_FREQ = 20.0f;
+constexpr float ANALYZER_MAX_FREQ = 20000.0f;
+constexpr ImVec2 SPECTROGRAM_POS{260, 450};
+constexpr ImVec2 SPECTROGRAM_SIZE{230, 120};
+constexpr float SPECTROGRAM_MIN_DB = -90.0f;
+constexpr float SPECTROGRAM_MAX_DB = 0.0f;
+/* One column of name, slider and value for each parameter */
+constexpr imgui_editor::LayoutGroup<MAX_PARAMETERS, 3> PARAMETER_GROUP{"Parameters", ImVec2(5, 5), ImVec2(3, 3), 16, 50, 4, 0,
+                                                                       {{{imgui_editor::WidgetKind::PARAMETER_NAME, 0, ImVec2(45, 16)},
+                                                                         {imgui_editor::WidgetKind::PARAMETER_SLIDER, 2, ImVec2(20, 105)},
+                                                                         {imgui_editor::WidgetKind::PARAMETER_VALUE, 0, ImVec2(45, 16)}}}};
+constexpr auto PARAMETER_LAYOUT = imgui_editor::compile_layout(PARAMETER_GROUP);
+/* Text cache slots of values formatted every frame */
+constexpr int TIMING_TEXT_SLOT = MAX_PARAMETERS;
+/* Front and back buffer, both RGBA */
+constexpr int64_t FRAMEBUFFER_BYTES_PER_PIXEL = 2 * 4;
+/* Set to the path of a PNG file, or the name of an image in the asset pack, to draw it as a skin background */
+constexpr const char* BACKGROUND_IMAGE = "";
+/* Name of the font in the asset pack, if built with FONT_IN_ASSET_PACK */
+constexpr const char* FONT_ASSET = "font";
+/* Glyphs rasterized when the font atlas is built, the rest of the basic
+ * multilingual plane is rasterized the first time it's drawn */
+constexpr ImWchar PRELOADED_GLYPHS[] = {0x0020, 0x007E, 0};
+constexpr ImWchar ON_DEMAND_GLYPHS[] = {0x0020, 0xFFFF, 0};
+/* When nothing is animated, stop drawing after this many frames without input
+ * and wait for input, but redraw at least this often to show parameter changes */
+constexpr int IDLE_FRAMES_BEFORE_WAIT = 3;
+constexpr double IDLE_WAIT_TIMEOUT = 0.05;
+/* How often a suspended editor checks if it's visible again, if it can't be notified */
+constexpr auto SUSPENDED_CHECK_INTERVAL = std::chrono::milliseconds(100);
+/* Frame times kept for the percentiles in frame_time_stats() */
+constexpr int FRAME_TIME_HISTORY = 8192;
+/* If set, the draw data of every frame is captured to a file named after its
+ * value and the editor instance, for replaying with the draw_replay tool */
+constexpr const char* CAPTURE_ENV_VARIABLE = "VSTIMGUI_DRAW_CAPTURE";
+/* If set, the input, time steps and parameter changes of every frame are recorded
+ * to a file named after its value and the editor instance, for replaying with the
+ * ui_replay tool */
+constexpr const char* RECORDING_ENV_VARIABLE = "VSTIMGUI_INPUT_RECORDING";
+/* Time per frame each editor may use before the quality governor lowers the
+ * drawing quality, can be changed with the environment variable, 0 disables it */
+constexpr float DEFAULT_FRAME_BUDGET_MS = 5.0f;
+constexpr const char* FRAME_BUDGET_ENV_VARIABLE = "VSTIMGUI_FRAME_BUDGET_MS";
+/* Worker threads drawing the geometry of panels like the scope, 0 draws them on
+ * the draw thread. Can be changed with the environment variable */
+constexpr int DEFAULT_PANEL_THREADS = 0;
+constexpr int MAX_PANEL_THREADS = 16;
+constexpr const char* PANEL_THREADS_ENV_VARIABLE = "VSTIMGUI_PANEL_THREADS";
+/* Statistics are published for the stats_monitor tool at this interval. A frame
+ * that takes longer than the display's refresh period, or the frame interval of
+ * the quality governor, makes the editor skip refreshes */
+constexpr auto STATS_PUBLISH_INTERVAL = std::chrono::milliseconds(250);
+constexpr float DISPLAY_REFRESH_RATE = 60.0f;
+/* Set to soft to render with the software renderer instead of OpenGL, which then
+ * only copies each finished frame to the window. For hosts where OpenGL is slow,
+ * such as virtual machines and remote sessions */
+constexpr const char* RENDERER_ENV_VARIABLE = "VSTIMGUI_RENDERER";
+constexpr const char* SOFT_RENDERER = "soft";
+/* Threads rasterizing each editor's frames with the software renderer, including the draw thread */
+constexpr int SOFT_RENDERER_THREADS = 2;
 
 namespace imgui_editor {
 
 std::mutex Editor::_init_lock;
+std::mutex Editor::_lifecycle_lock;
+#ifdef LINUX
+std::unique_ptr<EventThread> Editor::_event_thread;
+#endif
 std::atomic<int> Editor::instance_counter = 0;
+std::atomic<int> Editor::session_counter = 0;
+ThreadReaper Editor::_reaper;
+RenderSlots Editor::_render_slots(ThreadPolicy::from_environment().max_rendering);
+
+std::unique_ptr<AEffEditor> create_editor(AudioEffect* instance, SampleFifo* audio_fifo)
+{
+    return std::make_unique<Editor>(instance, audio_fifo);
+}
+
+FrameTimeStats frame_time_stats(AEffEditor* editor)
+{
+    return static_cast<Editor*>(editor)->frame_time_stats();
+}
+
+MemoryStats memory_stats(AEffEditor* editor)
+{
+    return static_cast<Editor*>(editor)->memory_stats();
+}
+
+LifecycleStats lifecycle_stats(AEffEditor* editor)
+{
+    return static_cast<Editor*>(editor)->lifecycle_stats();
+}
+
+SchedulingStats scheduling_stats(AEffEditor* editor)
+{
+    return static_cast<Editor*>(editor)->scheduling_stats();
+}
+
+std::shared_future<bool> editor_ready(AEffEditor* editor)
+{
+    return static_cast<Editor*>(editor)->ready();
+}
+
+std::shared_future<void> editor_closed(AEffEditor* editor)
+{
+    return static_cast<Editor*>(editor)->closed();
+}
+
+static float frame_budget()
+{
+    const char* budget = std::getenv(FRAME_BUDGET_ENV_VARIABLE);
+    return budget != nullptr && budget[0] != 0 ? static_cast<float>(std::atof(budget)) : DEFAULT_FRAME_BUDGET_MS;
+}
+
+static int panel_threads()
+{
+    const char* threads = std::getenv(PANEL_THREADS_ENV_VARIABLE);
+    int count = threads != nullptr && threads[0] != 0 ? std::atoi(threads) : DEFAULT_PANEL_THREADS;
+    return std::clamp(count, 0, MAX_PANEL_THREADS);
+}
+
+static bool software_rendering()
+{
+    const char* renderer = std::getenv(RENDERER_ENV_VARIABLE);
+    return renderer != nullptr && std::string(renderer) == SOFT_RENDERER;
+}
 
-std::unique_ptr<AEffEditor> create_editor(AudioEffect* instance)
+/* Size of the calling thread's stack, 0 if not known */
+static int64_t thread_stack_size()
 {
-    return std::make_unique<Editor>(instance);
+#ifdef LINUX
+    pthread_attr_t attributes;
+    size_t size = 0;
+    if (pthread_getattr_np(pthread_self(), &attributes) == 0)
+    {
+        pthread_attr_getstacksize(&attributes, &size);
+        pthread_attr_destroy(&attributes);
+    }
+    return static_cast<int64_t>(size);
+#else
+    return 0;
+#endif
 }
 
-Editor::Editor(AudioEffect* instance) : AEffEditor::AEffEditor(instance),
-                                        _rect{0, 0, WINDOW_HEIGHT, WINDOW_WIDTH}
+Editor::Editor(AudioEffect* instance, SampleFifo* audio_fifo) : AEffEditor::AEffEditor(instance),
+                                                                _rect{0, 0, WINDOW_HEIGHT, WINDOW_WIDTH},
+                                                                _software(software_rendering()),
+                                                                _audio_fifo(audio_fifo),
+                                                                _scope(SCOPE_LENGTH),
+                                                                _analyzer(ANALYZER_FFT_SIZE, instance->getSampleRate()),
+                                                                _spectrogram(static_cast<int>(ANALYZER_SIZE.x), static_cast<int>(SPECTROGRAM_SIZE.x),
+                                                                             SPECTROGRAM_MIN_DB, SPECTROGRAM_MAX_DB, _software),
+                                                                _images(decode_png, _software ? soft_textures() : opengl3_textures()),
+                                                                _governor(frame_budget())
 {
     _num_parameters = instance->getAeffect()->numParams;
+    if (_audio_fifo)
+    {
+        _audio_buffer.resize(_audio_fifo->capacity());
+    }
+    _analyzer.set_display_range(static_cast<int>(ANALYZER_SIZE.x), ANALYZER_MIN_FREQ, ANALYZER_MAX_FREQ);
+}
+
+Editor::~Editor()
+{
+    if (_running)
+    {
+        close();
+    }
+    if (_closed.valid())
+    {
+        _closed.wait();
+    }
 }
 
 bool Editor::open(void* window)
 {
+    auto call_start = std::chrono::high_resolution_clock::now();
     /* Handle situations when open_view is called on an already
      * open editor or one that wasn't closed properly */
     if (_running == true)
     {
         return false;
     }
-    if (_update_thread.joinable())
+    _reaper.add(std::move(_update_thread));
+
     {
-        _update_thread.join();
+        std::scoped_lock<std::mutex> lock(_frame_time_lock);
+        _frame_times.clear();
+        _frame_count = 0;
     }
+    _open_latency = -1.0f;
+    _open_time = call_start;
+    _suspended_ns = 0;
 
+    /* The last session's teardown may still be running, the new draw thread waits for it */
+    auto embedded = std::make_shared<EmbeddedWindow>();
+    DrawSession session{session_counter.fetch_add(1), std::promise<bool>(), std::promise<void>(), _closed, embedded};
+    auto ready = session.ready.get_future().share();
+    auto closed = session.closed.get_future().share();
+    _session = session.number;
     _running = true;
     try
     {
-        _update_thread = std::thread(&Editor::_draw_loop, this, window);
+        _update_thread = std::thread(&Editor::_draw_loop, this, window, std::move(session));
     }
     catch (std::exception& e)
     {
         std::cerr << "Failed to start draw thread: " << e.what() << std::endl;
+        _running = false;
+        std::promise<bool> failed;
+        failed.set_value(false);
+        _ready = failed.get_future().share();
         return false;
     }
+    _ready = ready;
+    _closed = closed;
+#ifdef LINUX
+    _embedded = embedded;
+#endif
 
+    _open_call_ms = (std::chrono::high_resolution_clock::now() - call_start).count() / 1'000'000.0f;
     return true;
 }
 
 void Editor::close()
 {
     std::cout << "Closing window" << std::endl;
+    _close_time = std::chrono::high_resolution_clock::now();
 
+#ifdef LINUX
+    /* Before stopping the draw thread, so it doesn't start destroying the window first */
+    _detach_window();
+#endif
     _running = false;
+    {
+        std::scoped_lock<std::mutex> lock(_visibility_lock);
+        _visibility_changed.notify_all();
+    }
 
+#ifdef LINUX
+    _reaper.add(std::move(_update_thread));
+#else
+    /* A child window can't be moved out of the host's window from another thread
+     * without risking a deadlock with the draw thread, so wait for the teardown */
     if (_update_thread.joinable())
     {
         _update_thread.join();
     }
+#endif
+    _close_call_ms = (std::chrono::high_resolution_clock::now() - _close_time).count() / 1'000'000.0f;
+}
+
+#ifdef LINUX
+void Editor::_detach_window()
+{
+    if (!_embedded)
+    {
+        return;
+    }
+    EmbeddedWindow& embedded = *_embedded;
+    auto state = WindowState::NOT_CREATED;
+    if (embedded.state.compare_exchange_strong(state, WindowState::CLOSED))
+    {
+        return;
+    }
+    /* The window is created before the draw thread applies the thread policy,
+     * so this only waits for a thread running at normal priority */
+    while (state == WindowState::CREATING)
+    {
+        embedded.state.wait(state);
+        state = embedded.state.load();
+    }
+    if (state == WindowState::ATTACHED && embedded.state.compare_exchange_strong(state, WindowState::DETACHING))
+    {
+        /* GLFW initializes Xlib for use from several threads, and the draw thread
+         * doesn't destroy the window, or terminate GLFW, until it's detached */
+        Display* display = glfwGetX11Display();
+        XUnmapWindow(display, embedded.window);
+        XReparentWindow(display, embedded.window, DefaultRootWindow(display), 0, 0);
+        XFlush(display);
+        _event_thread->xlib_used();
+        embedded.state = WindowState::DETACHED;
+        embedded.state.notify_all();
+        return;
+    }
+    /* Only if the window closed on its own, it must be gone before the host destroys its window */
+    while (state == WindowState::DESTROYING)
+    {
+        embedded.state.wait(state);
+        state = embedded.state.load();
+    }
 }
+#endif
 
 bool Editor::_setup_open_gl(void* host_window)
 {
+    _window = nullptr;
     auto inst_no = instance_counter.fetch_add(1);
     if (inst_no == 0)
     {
@@ -87,17 +338,29 @@ bool Editor::_setup_open_gl(void* host_window)
         {
             return false;
         }
+#ifdef LINUX
+        _event_thread = std::make_unique<EventThread>(_init_lock);
+#endif
     }
 
-    // GL 3.0 + GLSL 130
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
     glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
     glfwWindowHint(GLFW_DECORATED, GLFW_FALSE);
     glfwWindowHint(GLFW_EMBEDDED_WINDOW, GLFW_TRUE);
     glfwWindowHintVoid(GLFW_PARENT_WINDOW_ID, host_window);
 
-    _window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Dear ImGui Plugin UI", nullptr, nullptr);
+    /* Failing to create a context of a version prints a GLFW error before the next one is tried */
+    for (const auto& version : GL_VERSIONS)
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version.major);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version.minor);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, version.core_profile ? GLFW_OPENGL_CORE_PROFILE : GLFW_OPENGL_ANY_PROFILE);
+        _window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Dear ImGui Plugin UI", nullptr, nullptr);
+        if (_window != nullptr)
+        {
+            _glsl_version = version.glsl_version;
+            break;
+        }
+    }
     if (_window == nullptr)
     {
         std::cout << "Failed to create window"  << std::endl;
@@ -133,6 +396,38 @@ bool Editor::_setup_open_gl(void* host_window)
 }
 
 bool Editor::_setup_imgui()
+{
+    _create_imgui_context();
+
+    /* Setup Platform/Renderer backends */
+    if (!ImGui_ImplGlfw_InitForOpenGL(_window, true))
+    {
+        return false;
+    }
+    /* The software renderer is set up once the thread policy is applied, so its workers inherit it */
+    if (!_software && !ImGui_ImplOpenGL3_Init(_glsl_version))
+    {
+        ImGui_ImplGlfw_Shutdown(false);
+        return false;
+    }
+    return true;
+}
+
+void Editor::_release_glfw()
+{
+    if (instance_counter.fetch_add(-1) > 1)
+    {
+        return;
+    }
+#ifdef LINUX
+    /* The event thread takes _init_lock to dispatch events, so stop it before taking it here */
+    _event_thread.reset();
+#endif
+    std::scoped_lock<std::mutex> lock(_init_lock);
+    glfwTerminate();
+}
+
+void Editor::_create_imgui_context()
 {
     /* Setup Dear ImGui context. To enable multiple, independent windows,
      * the context is thread local and each window has it's own context
@@ -141,7 +436,6 @@ bool Editor::_setup_imgui()
     IMGUI_CHECKVERSION();
     MyImGuiTLS = ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
-    (void) io;
 
     /* Setup Dear ImGui style */
     ImGui::StyleColorsDark();
@@ -153,17 +447,36 @@ bool Editor::_setup_imgui()
     style.Colors[ImGuiCol_FrameBgActive] = style.Colors[ImGuiCol_FrameBg];
     style.Colors[ImGuiCol_SliderGrabActive] = style.Colors[ImGuiCol_SliderGrab];
 
-    /* Setup Platform/Renderer backends */
-    ImGui_ImplGlfw_InitForOpenGL(_window, true);
-    ImGui_ImplOpenGL3_Init(glsl_version);
-
     /* The font is loaded from generated/font.h. The font file is in generated by the
      * binary_to_source utility included in Dear ImGui, this util is built and run by
      * CMake when generating the make files. Default font is Roboto
-     * To change font, set the CMake varible INCLUDED_FONT */
+     * To change font, set the CMake varible INCLUDED_FONT. With the CMake option
+     * FONT_IN_ASSET_PACK, it's put in the asset pack instead.
+     * Only ASCII is built into the atlas up front, other glyphs are added by
+     * _glyphs when text using them is laid out */
     ImFontConfig config;
-    io.Fonts->AddFontFromMemoryCompressedTTF(font_compressed_data, font_compressed_size, 16 , &config);
-    return true;
+    config.GlyphRanges = PRELOADED_GLYPHS;
+    ImFont* font_added;
+#ifdef VSTIMGUI_FONT_IN_ASSET_PACK
+    Asset font;
+    const AssetPack* pack = AssetPack::process();
+    if (pack != nullptr && pack->find(FONT_ASSET, font) && font.type == AssetType::FONT)
+    {
+        /* Read straight from the pack, shared by all editors, instead of every
+         * editor decompressing its own copy. The atlas must not free it */
+        config.FontDataOwnedByAtlas = false;
+        font_added = io.Fonts->AddFontFromMemoryTTF(const_cast<uint8_t*>(font.data), static_cast<int>(font.size), 16, &config);
+    }
+    else
+    {
+        std::cerr << "No font in the asset pack, using the default font" << std::endl;
+        font_added = io.Fonts->AddFontDefault(&config);
+    }
+#else
+    font_added = io.Fonts->AddFontFromMemoryCompressedTTF(font_compressed_data, font_compressed_size, 16 , &config);
+#endif
+    _glyphs.add(font_added, ON_DEMAND_GLYPHS);
+    _text_cache.set_glyphs(&_glyphs);
 }
 
 bool Editor::getRect(ERect** rect)
@@ -181,146 +494,742 @@ void Editor::idle()
     for (int i = 0; i < param_count; ++i)
     {
         _slider_values[i] = effect->getParameter(i);
+        if (_recorder.is_open())
+        {
+            _recorder.record_parameter(i, _slider_values[i]);
+        }
     }
 }
 
-void Editor::_draw_loop(void* window)
+bool Editor::open_headless()
 {
-    /* Setting up more than 1 context at the same time seems to be not 100% thread safe */
+    if (_running)
     {
-        std::scoped_lock<std::mutex> lock(_init_lock);
-        _setup_open_gl(window);
-        _setup_imgui();
+        return false;
     }
+    MemoryAccount::Scope memory_scope(&_memory);
+    _create_imgui_context();
+    /* Only the renderer needs the atlas as a texture, but ImGui needs it built */
+    ImGui::GetIO().Fonts->Build();
+    _setup_parameters();
+    _panels.start(panel_threads(), &_memory);
+    _headless = true;
+    if (_audio_fifo)
+    {
+        /* There's no GL context to keep the spectrogram in */
+        _spectrogram.set_software(true);
+        _analyzer.set_sample_rate(effect->getSampleRate());
+        _audio_fifo->set_enabled(true);
+    }
+    return true;
+}
 
-    /* Only display a maximum of 10 parameters in this demo */
-    int param_count = std::min(_num_parameters, MAX_PARAMETERS);
+void Editor::draw_headless(const RecordedFrame& frame)
+{
+    MemoryAccount::Scope memory_scope(&_memory);
+    for (const auto& parameter : frame.parameters)
+    {
+        if (parameter.index >= 0 && parameter.index < _param_count)
+        {
+            _slider_values[parameter.index] = parameter.value;
+        }
+    }
+    InputRecording::apply(frame, ImGui::GetIO());
+    _process_audio();
+    if (_glyphs.new_frame())
+    {
+        _text_cache.invalidate();
+    }
+    ImGui::NewFrame();
+    _draw_widgets();
+    ImGui::Render();
+    _panels.merge(ImGui::GetDrawData());
+}
 
-    /* It's somewhat against the philosophy of an immediate mode gui to
-     * hold a separate state in the gui class, but I would still prefer
-     * to mirror the parameter values here than polling at 60 Hz or
-     * sharing a state with the dsp model.
-     * It's just a demo anyway :) You can do as you please */
+void Editor::close_headless()
+{
+    MemoryAccount::Scope memory_scope(&_memory);
+    if (_audio_fifo)
+    {
+        _audio_fifo->set_enabled(false);
+    }
+    _spectrogram.clear();
+    _spectrogram.set_software(_software);
+    _headless = false;
+    _panels.stop();
+    _glyphs.clear();
+    ImGui::DestroyContext();
+    MyImGuiTLS = nullptr;
+}
 
-    for (int i = 0; i < param_count; ++i)
+void Editor::_process_audio()
+{
+    /* Drain the audio fifo, reduce it to one min/max pair per pixel column
+     * for the scope and run the analyzer's fft if new audio has arrived */
+    if (!_audio_fifo)
     {
-        _slider_values[i] = effect->getParameter(i);
+        return;
     }
+    auto start_time = std::chrono::high_resolution_clock::now();
+    int samples = _audio_fifo->pop(_audio_buffer.data(), static_cast<int>(_audio_buffer.size()));
+    _scope.push(_audio_buffer.data(), samples);
+    _analyzer.push(_audio_buffer.data(), samples);
+    _scope.decimate(static_cast<int>(SCOPE_SIZE.x));
+    auto decimation_end = std::chrono::high_resolution_clock::now();
+    if (_analyzer.process())
+    {
+        _spectrogram.push(_analyzer.average_db(), _analyzer.bins());
+    }
+    auto analyzer_end = std::chrono::high_resolution_clock::now();
+    _timings.decimation = (1.0f - SMOOTH_FACT) * _timings.decimation + SMOOTH_FACT * (decimation_end - start_time).count() / 1'000'000.0f;
+    _timings.analyzer = (1.0f - SMOOTH_FACT) * _timings.analyzer + SMOOTH_FACT * (analyzer_end - decimation_end).count() / 1'000'000.0f;
+}
 
-    std::array<std::string, MAX_PARAMETERS> param_names;
-    for (int i = 0; i < param_count; ++i)
+void Editor::_upload_glyphs()
+{
+    int y;
+    int height;
+    if (!_glyphs.take_dirty_rows(y, height))
     {
-        char buffer[64];
-        std::fill(buffer, buffer + 64, 0);
-        effect->getParameterName(i, buffer);
-        param_names[i] = buffer;
+        return;
     }
+    if (_software)
+    {
+        ImGui_ImplSoft_UpdateFontsTexture(y, height);
+    }
+    else
+    {
+        ImGui_ImplOpenGL3_UpdateFontsTexture(y, height);
+    }
+}
 
-    float draw_time = 0;
-    float render_time = 0;
-    float gl_render_time = 0;
-    float swap_time = 0;
-    while (!glfwWindowShouldClose(_window) && _running)
+void Editor::_render_soft(ImDrawData* draw_data, int width, int height)
+{
+    if (width <= 0 || height <= 0)
     {
-        // Poll and handle events (inputs, window resize, etc.)
-        glfwPollEvents();
+        return;
+    }
+    _soft_pixels.assign(static_cast<size_t>(width) * height, ImGui::ColorConvertFloat4ToU32(clear_color));
+    ImGui_ImplSoft_RenderDrawData(draw_data, _soft_pixels.data(), width, height, width);
 
-        auto start_time = std::chrono::high_resolution_clock::now();
+    if (_soft_texture == 0)
+    {
+        glGenTextures(1, &_soft_texture);
+        glGenFramebuffers(1, &_soft_framebuffer);
+    }
+    glBindTexture(GL_TEXTURE_2D, _soft_texture);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    if (width != _soft_width || height != _soft_height)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, _soft_pixels.data());
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, _soft_framebuffer);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _soft_texture, 0);
+        _soft_width = width;
+        _soft_height = height;
+    }
+    else
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, _soft_pixels.data());
+    }
+    /* The software renderer's first row is the top one, OpenGL's the bottom one */
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _soft_framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, width, height, 0, height, width, 0, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
 
-        // Start the Dear ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
+void Editor::_release_soft()
+{
+    if (_soft_texture != 0)
+    {
+        glDeleteFramebuffers(1, &_soft_framebuffer);
+        glDeleteTextures(1, &_soft_texture);
+    }
+    _soft_texture = 0;
+    _soft_framebuffer = 0;
+    _soft_width = 0;
+    _soft_height = 0;
+    _soft_pixels = std::vector<ImU32>();
+}
+
+void Editor::_draw_loop(void* window, DrawSession session)
+{
+    if (session.previous.valid())
+    {
+        session.previous.wait();
+    }
+    _teardown_ms = -1.0f;
+    MemoryAccount::Scope memory_scope(&_memory);
+    _thread_stack_bytes = thread_stack_size();
+    _scheduler_latency.start();
+    _render_wait_ms = 0;
 
-        ImGui::SetNextWindowPos(ImVec2(0, 0));
-        ImGui::SetNextWindowSize(ImVec2(WINDOW_WIDTH, WINDOW_HEIGHT));
-        ImGui::SetNextWindowBgAlpha(0.0f);
-        ImGui::Begin("__", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize |
-                                    ImGuiWindowFlags_NoMove);
+    /* Setting up more than 1 context at the same time seems to be not 100% thread safe.
+     * GLFW is initialized by the first editor and terminated by the last one holding
+     * _lifecycle_lock, so an editor opened while the last one is still being torn
+     * down waits for GLFW to be terminated before initializing it again */
+    {
+        std::scoped_lock<std::mutex> lifecycle_lock(_lifecycle_lock);
+        bool setup = false;
+        {
+            std::scoped_lock<std::mutex> lock(_init_lock);
+            /* If the editor was closed already, the host's window may be gone */
+            auto window_state = WindowState::NOT_CREATED;
+            if (!_session_open(session.number) ||
+                !session.embedded->state.compare_exchange_strong(window_state, WindowState::CREATING))
+            {
+                _scheduler_latency.stop();
+                session.ready.set_value(false);
+                session.closed.set_value();
+                return;
+            }
+            setup = _setup_open_gl(window) && _setup_imgui();
+            if (setup)
+            {
+#ifdef LINUX
+                _visibility.window = glfwGetX11Window(_window);
+                _visibility.on_change = [this]()
+                {
+                    std::scoped_lock<std::mutex> lock(_visibility_lock);
+                    _visibility_changed.notify_all();
+                };
+                _event_thread->track(&_visibility);
+                _event_thread->xlib_used();
+                session.embedded->window = _visibility.window;
+#endif
+                session.embedded->state = WindowState::ATTACHED;
+            }
+            else
+            {
+                std::cerr << "Failed to set up the editor window" << std::endl;
+                if (MyImGuiTLS != nullptr)
+                {
+                    ImGui::DestroyContext();
+                    MyImGuiTLS = nullptr;
+                }
+                if (_window != nullptr)
+                {
+                    glfwDestroyWindow(_window);
+                    _window = nullptr;
+                }
+                session.embedded->state = WindowState::CLOSED;
+            }
+            session.embedded->state.notify_all();
+        }
+        if (!setup)
+        {
+            _release_glfw();
+            _scheduler_latency.stop();
+            session.ready.set_value(false);
+            session.closed.set_value();
+            return;
+        }
+    }
+    /* Only once the window is set up, so creating it and the event thread, which
+     * is shared by all editors, run at the host's priority. close() may be waiting
+     * for that, while the panel workers and image loader started later inherit it */
+    apply_thread_policy(ThreadPolicy::from_environment());
+    if (_software)
+    {
+        ImGui_ImplSoft_Init(SOFT_RENDERER_THREADS);
+    }
+    _backend_bytes = static_cast<int64_t>(ImGui_ImplGlfw_GetMemoryUsage());
+    _governor.reset(ImGui::GetStyle());
+    _stats_export.claim();
+    _skipped_frames = 0;
+    _stats_publish_time = std::chrono::high_resolution_clock::now();
+    _stats_publish_frames = 0;
+    _panels.start(panel_threads(), &_memory);
 
-        ImU32 colour = ImColor(0x41, 0x7c, 0x8c, 0xff);
+    _setup_parameters();
 
-        ImDrawList*draw_list = ImGui::GetWindowDrawList();
-        draw_list->AddRectFilled(ImVec2(5, 5), ImVec2(param_count * PARAM_SPACING + 10, 180), colour, 3.0f, ImDrawFlags_RoundCornersAll);
+    /* Only accept audio data from the dsp side while the editor is open */
+    if (_audio_fifo)
+    {
+        _analyzer.set_sample_rate(effect->getSampleRate());
+        _audio_fifo->set_enabled(true);
+    }
 
-        ImGui::Text("Parameters");
-        ImGui::NewLine();
+    const char* capture_path = std::getenv(CAPTURE_ENV_VARIABLE);
+    if (capture_path != nullptr && capture_path[0] != 0)
+    {
+        _capture.open(std::string(capture_path) + "." + std::to_string(session.number));
+    }
+    const char* recording_path = std::getenv(RECORDING_ENV_VARIABLE);
+    if (recording_path != nullptr && recording_path[0] != 0)
+    {
+        _recorder.open(std::string(recording_path) + "." + std::to_string(session.number));
+    }
 
-        /* Draw parameter labels */
-        for (int i = 0; i < param_count; ++i)
+    int idle_frames = 0;
+    bool ready = false;
+    while (!glfwWindowShouldClose(_window) && _session_open(session.number))
+    {
+        /* Draw nothing while the editor can't be seen, e.g. when the host has hidden
+         * or minimized its window or it's covered, then start over with a fresh frame */
+        if (!_visible())
+        {
+            _suspend(session.number);
+            idle_frames = 0;
+            continue;
+        }
+#ifdef LINUX
+        /* Events are dispatched to all editors by the event thread, so this thread
+         * only needs to wake up for its own input if nothing else changes on screen */
+        if (!_audio_fifo && _images.pending() == 0 && idle_frames >= IDLE_FRAMES_BEFORE_WAIT)
         {
-            ImGui::SameLine(8 + i * PARAM_SPACING, 10);
-            ImGui::TextUnformatted(param_names[i].c_str());
+            ImGui_ImplGlfw_WaitForEvents(IDLE_WAIT_TIMEOUT);
         }
-        ImGui::NewLine();
+#else
+        // Poll and handle events (inputs, window resize, etc.)
+        glfwPollEvents();
+#endif
+
+        /* Only a limited number of editors may draw at the same time, if set. The
+         * slot is released before the swap, which mostly waits for the display */
+        auto wait_start = std::chrono::high_resolution_clock::now();
+        _render_slots.acquire();
+        auto start_time = std::chrono::high_resolution_clock::now();
 
-        /* Draw parameter sliders */
-        for (int i = 0; i < param_count; ++i)
+        _process_audio();
+
+        /* Glyphs that didn't fit in the atlas last frame are added before the
+         * frame starts, as the texture is created again if the atlas grew */
+        if (_glyphs.new_frame())
         {
-            ImGui::SameLine(10 + i * PARAM_SPACING, 10);
-            /* Hint, we're passing a format string of \"\" to keep ImGui
-             * from printing the value inside the slider */
-            ImGui::VSliderFloat(("##" + param_names[i]).c_str(), slider_s, &_slider_values[i], 0, 1.0f, "");
-            if (ImGui::IsItemActive())
-            {
-                effect->setParameterAutomated(i, _slider_values[i]);
-            }
+            _text_cache.invalidate();
         }
-        ImGui::NewLine();
+        _upload_glyphs();
 
-        /* Draw a value display */
-        for (int i = 0; i < param_count; ++i)
+        // Start the Dear ImGui frame
+        if (_software)
+        {
+            ImGui_ImplSoft_NewFrame();
+        }
+        else
         {
-            ImGui::SameLine(7 + i * PARAM_SPACING, 10);
-            ImGui::Text("%.2f", _slider_values[i]);
+            ImGui_ImplOpenGL3_NewFrame();
         }
+        ImGui_ImplGlfw_NewFrame();
+        idle_frames = ImGui_ImplGlfw_GetInputStats().EventsApplied > 0 ? 0 : idle_frames + 1;
+        _recorder.record_frame(ImGui::GetIO());
+        ImGui::NewFrame();
+        _images.new_frame();
 
-        /* Finally show some statistics on cpu usage */
-        ImGui::NewLine();
-        ImGui::Text("Draw time: %.4f ms", draw_time);
-        ImGui::Text("Render time: %.4f ms", render_time);
-        ImGui::Text("Open GL render time: %.4f ms", gl_render_time);
-        ImGui::Text("Swap time: %.4f ms", swap_time);
-        ImGui::End();
+        _draw_widgets();
 
         auto split_time = std::chrono::high_resolution_clock::now();
 
-        /* Rendering */
+        /* Rendering, panels are drawn and added to the draw data after the widgets */
         ImGui::Render();
-        int display_w, display_h;
+        _panels.merge(ImGui::GetDrawData());
         auto split2_time = std::chrono::high_resolution_clock::now();
 
-        glfwGetFramebufferSize(_window, &display_w, &display_h);
-        glViewport(0, 0, display_w, display_h);
-        glClearColor(clear_color.x, clear_color.y, clear_color.z, clear_color.w);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        /* Use the framebuffer size cached by the backend instead of asking the window system again */
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        int display_w = static_cast<int>(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+        int display_h = static_cast<int>(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+        _upload_glyphs();
+        if (_software)
+        {
+            _render_soft(draw_data, display_w, display_h);
+        }
+        else
+        {
+            glViewport(0, 0, display_w, display_h);
+            glClearColor(clear_color.x, clear_color.y, clear_color.z, clear_color.w);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+        }
+        _capture.write_frame(draw_data);
+        const auto& gpu_memory = ImGui_ImplOpenGL3_GetMemoryStats();
+        _gpu_buffer_bytes = static_cast<int64_t>(gpu_memory.BufferBytes);
+        _gpu_texture_bytes = static_cast<int64_t>(gpu_memory.TextureBytes) + static_cast<int64_t>(_soft_width) * _soft_height * 4;
+        _framebuffer_bytes = static_cast<int64_t>(display_w) * display_h * FRAMEBUFFER_BYTES_PER_PIXEL +
+                             static_cast<int64_t>(_soft_pixels.size() * sizeof(ImU32));
 
         auto split3_time = std::chrono::high_resolution_clock::now();
+        _render_slots.release();
         glfwSwapBuffers(_window);
+#ifdef LINUX
+        _event_thread->xlib_used();
+#endif
+        ImGui_ImplGlfw_FramePresented();
         auto end_time = std::chrono::high_resolution_clock::now();
+        if (!ready)
+        {
+            _open_latency = (end_time - _open_time).count() / 1'000'000.0f;
+            session.ready.set_value(true);
+            ready = true;
+        }
+        float frame_ms = (end_time - start_time).count() / 1'000'000.0f;
+        _record_frame_time(frame_ms);
+        float refresh_ms = std::max(1000.0f / DISPLAY_REFRESH_RATE, _governor.frame_interval().count() / 1000.0f);
+        _skipped_frames += std::max(0l, std::lround(frame_ms / refresh_ms) - 1);
+        _governor.frame((split3_time - start_time).count() / 1'000'000.0f, ImGui::GetStyle());
 
         /* Filter the timings so they look a bit nicer */
-        draw_time = (1.0f - SMOOTH_FACT) * draw_time + SMOOTH_FACT * (split_time - start_time).count() / 1'000'000.0f;
-        render_time = (1.0f - SMOOTH_FACT) * render_time + SMOOTH_FACT * (split2_time - split_time).count() / 1'000'000.0f;
-        gl_render_time = (1.0f - SMOOTH_FACT) * gl_render_time + SMOOTH_FACT * (split3_time - split2_time).count() / 1'000'000.0f;
-        swap_time = (1.0f - SMOOTH_FACT) * swap_time + SMOOTH_FACT * (end_time - split3_time).count() / 1'000'000.0f;
+        _timings.draw = (1.0f - SMOOTH_FACT) * _timings.draw + SMOOTH_FACT * (split_time - start_time).count() / 1'000'000.0f;
+        _timings.render = (1.0f - SMOOTH_FACT) * _timings.render + SMOOTH_FACT * (split2_time - split_time).count() / 1'000'000.0f;
+        _timings.gl_render = (1.0f - SMOOTH_FACT) * _timings.gl_render + SMOOTH_FACT * (split3_time - split2_time).count() / 1'000'000.0f;
+        _timings.swap = (1.0f - SMOOTH_FACT) * _timings.swap + SMOOTH_FACT * (end_time - split3_time).count() / 1'000'000.0f;
+        _render_wait_ms = (1.0f - SMOOTH_FACT) * _render_wait_ms + SMOOTH_FACT * (start_time - wait_start).count() / 1'000'000.0f;
+        _scheduler_latency.update(end_time);
+        _publish_stats(session.number, end_time);
+
+        /* The lowest quality levels also lower the frame rate */
+        auto frame_interval = _governor.frame_interval();
+        if (frame_interval.count() > 0)
+        {
+            std::this_thread::sleep_until(start_time + frame_interval);
+        }
+    }
+    /* Cleanup on exit, in the background if the host closed the editor */
+    auto teardown_start = _session_open(session.number) ? std::chrono::high_resolution_clock::now() : _close_time;
+    if (!ready)
+    {
+        session.ready.set_value(false);
+    }
+    if (_audio_fifo)
+    {
+        _audio_fifo->set_enabled(false);
     }
-    /* Cleanup on exit */
 
-    auto inst_no = instance_counter.fetch_add(-1);
-    std::scoped_lock<std::mutex> lock(_init_lock);
+    _images.clear();
+    _spectrogram.clear();
+    _capture.close();
+    _recorder.close();
+    _panels.stop();
+    _stats_export.release();
+    _scheduler_latency.stop();
 
+    /* Unless close() has moved the window out of the host's, it mustn't start to while the window is destroyed */
+    auto window_state = WindowState::ATTACHED;
+    if (!session.embedded->state.compare_exchange_strong(window_state, WindowState::DESTROYING))
+    {
+        while (window_state == WindowState::DETACHING)
+        {
+            session.embedded->state.wait(window_state);
+            window_state = session.embedded->state.load();
+        }
+    }
 
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplGlfw_Shutdown(inst_no <= 1);
-    ImGui::DestroyContext();
-    glfwDestroyWindow(_window);
+    /* The instance count can't change while _lifecycle_lock is held */
+    std::scoped_lock<std::mutex> lifecycle_lock(_lifecycle_lock);
+    bool last_instance = instance_counter <= 1;
+    {
+        std::scoped_lock<std::mutex> lock(_init_lock);
+#ifdef LINUX
+        _event_thread->untrack(&_visibility);
+#endif
+        if (_software)
+        {
+            _release_soft();
+            ImGui_ImplSoft_Shutdown();
+        }
+        else
+        {
+            ImGui_ImplOpenGL3_Shutdown();
+        }
+        ImGui_ImplGlfw_Shutdown(last_instance);
+        _glyphs.clear();
+        ImGui::DestroyContext();
+        glfwDestroyWindow(_window);
+        _window = nullptr;
+#ifdef LINUX
+        _visibility.window = 0;
+#endif
+    }
+    session.embedded->state = WindowState::CLOSED;
+    session.embedded->state.notify_all();
+    _release_glfw();
+    _backend_bytes = 0;
+    _gpu_buffer_bytes = 0;
+    _gpu_texture_bytes = 0;
+    _framebuffer_bytes = 0;
+    _thread_stack_bytes = 0;
+
+    _teardown_ms = (std::chrono::high_resolution_clock::now() - teardown_start).count() / 1'000'000.0f;
+    /* The editor may be destroyed as soon as this is set */
+    session.closed.set_value();
+}
+
+bool Editor::_visible()
+{
+#ifdef LINUX
+    return _visibility.visible();
+#else
+    return glfwGetWindowAttrib(_window, GLFW_VISIBLE) && !glfwGetWindowAttrib(_window, GLFW_ICONIFIED);
+#endif
+}
 
-    if (inst_no <= 1)
+void Editor::_suspend(int session)
+{
+    auto start_time = std::chrono::high_resolution_clock::now();
+    /* Audio pushed in the meantime would only be shown for one frame */
+    if (_audio_fifo)
+    {
+        _audio_fifo->set_enabled(false);
+    }
+    while (!_visible() && _session_open(session) && !glfwWindowShouldClose(_window))
+    {
+#ifndef LINUX
+        /* Events for the window are only processed on this thread */
+        glfwPollEvents();
+#endif
+        {
+            std::unique_lock<std::mutex> lock(_visibility_lock);
+            _visibility_changed.wait_for(lock, SUSPENDED_CHECK_INTERVAL, [this, session] {return !_session_open(session) || _visible();});
+        }
+        /* Keep the stats up to date so the editor doesn't look stuck to a monitor */
+        _publish_stats(session, std::chrono::high_resolution_clock::now());
+    }
+    if (_audio_fifo)
+    {
+        _audio_fifo->set_enabled(true);
+    }
+    _suspended_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+FrameTimeStats Editor::frame_time_stats()
+{
+    std::vector<float> times;
+    FrameTimeStats stats{_open_latency, 0, _suspended_ns / 1'000'000'000.0f, _governor.level(), 0, 0, 0, 0, 0};
+    {
+        std::scoped_lock<std::mutex> lock(_frame_time_lock);
+        times = _frame_times;
+        stats.frames = _frame_count;
+    }
+    if (times.empty())
+    {
+        return stats;
+    }
+    float sum = 0;
+    for (float time : times)
+    {
+        sum += time;
+    }
+    std::sort(times.begin(), times.end());
+    auto percentile = [&](float fraction) {return times[std::min(times.size() - 1, static_cast<size_t>(fraction * times.size()))];};
+    stats.average_ms = sum / times.size();
+    stats.p50_ms = percentile(0.5f);
+    stats.p90_ms = percentile(0.9f);
+    stats.p99_ms = percentile(0.99f);
+    stats.max_ms = times.back();
+    return stats;
+}
+
+LifecycleStats Editor::lifecycle_stats() const
+{
+    return {_open_call_ms, _open_latency, _close_call_ms, _teardown_ms};
+}
+
+MemoryStats Editor::memory_stats() const
+{
+    return {_memory.bytes() + _backend_bytes, _memory.peak_bytes() + _backend_bytes, _memory.allocations(),
+            _gpu_buffer_bytes, _gpu_texture_bytes, _framebuffer_bytes, _thread_stack_bytes};
+}
+
+SchedulingStats Editor::scheduling_stats() const
+{
+    return {_scheduler_latency.run_delay_ms(), _scheduler_latency.max_run_delay_ms(), _render_wait_ms};
+}
+
+void Editor::_record_frame_time(float ms)
+{
+    std::scoped_lock<std::mutex> lock(_frame_time_lock);
+    if (_frame_times.size() < FRAME_TIME_HISTORY)
+    {
+        _frame_times.push_back(ms);
+    }
+    else
+    {
+        _frame_times[_frame_count % FRAME_TIME_HISTORY] = ms;
+    }
+    _frame_count++;
+}
+
+void Editor::_publish_stats(int session, std::chrono::high_resolution_clock::time_point now)
+{
+    auto elapsed = now - _stats_publish_time;
+    if (elapsed < STATS_PUBLISH_INTERVAL)
+    {
+        return;
+    }
+    auto memory = memory_stats();
+    EditorStatsRecord record{};
+    record.session = session;
+    record.quality_level = _governor.level();
+    record.frames = static_cast<uint64_t>(_frame_count);
+    record.skipped_frames = _skipped_frames;
+    record.update_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::steady_clock::now().time_since_epoch()).count());
+    record.fps = (_frame_count - _stats_publish_frames) / std::chrono::duration<float>(elapsed).count();
+    record.draw_ms = _timings.draw;
+    record.render_ms = _timings.render;
+    record.gl_render_ms = _timings.gl_render;
+    record.swap_ms = _timings.swap;
+    record.decimation_ms = _timings.decimation;
+    record.analyzer_ms = _timings.analyzer;
+    record.suspended_s = _suspended_ns / 1'000'000'000.0f;
+    record.run_delay_ms = _scheduler_latency.run_delay_ms();
+    record.render_wait_ms = _render_wait_ms;
+    record.cpu_bytes = memory.cpu_bytes;
+    record.gpu_bytes = memory.gpu_buffer_bytes + memory.gpu_texture_bytes + memory.framebuffer_bytes;
+    _stats_export.publish(record);
+    _stats_publish_time = now;
+    _stats_publish_frames = _frame_count;
+}
+
+void Editor::_setup_parameters()
+{
+    /* Only display a maximum of 10 parameters in this demo */
+    _param_count = std::min(_num_parameters, MAX_PARAMETERS);
+
+    /* It's somewhat against the philosophy of an immediate mode gui to
+     * hold a separate state in the gui class, but I would still prefer
+     * to mirror the parameter values here than polling at 60 Hz or
+     * sharing a state with the dsp model.
+     * It's just a demo anyway :) You can do as you please */
+
+    for (int i = 0; i < _param_count; ++i)
+    {
+        _slider_values[i] = effect->getParameter(i);
+    }
+
+    _param_names.resize(_param_count);
+    for (int i = 0; i < _param_count; ++i)
+    {
+        char buffer[64];
+        std::fill(buffer, buffer + 64, 0);
+        effect->getParameterName(i, buffer);
+        _param_names[i] = buffer;
+    }
+}
+
+void Editor::_draw_widgets()
+{
+    _text_cache.new_frame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(WINDOW_WIDTH, WINDOW_HEIGHT));
+    ImGui::SetNextWindowBgAlpha(0.0f);
+    ImGui::Begin("__", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize |
+                                ImGuiWindowFlags_NoMove);
+
+    ImU32 colour = ImColor(0x41, 0x7c, 0x8c, 0xff);
+
+    ImDrawList*draw_list = ImGui::GetWindowDrawList();
+    if (BACKGROUND_IMAGE[0] != 0 && _images.state(BACKGROUND_IMAGE) != ImageService::State::FAILED)
+    {
+        /* Shows a placeholder until the image has been loaded in the background */
+        draw_list->AddImage(_images.texture(BACKGROUND_IMAGE), ImVec2(0, 0), ImVec2(WINDOW_WIDTH, WINDOW_HEIGHT));
+    }
+    const ImVec2& background_size = PARAMETER_LAYOUT.background_size[_param_count];
+    draw_list->AddRectFilled(PARAMETER_LAYOUT.background_pos, ImVec2(PARAMETER_LAYOUT.background_pos.x + background_size.x,
+                             PARAMETER_LAYOUT.background_pos.y + background_size.y), colour, 3.0f, ImDrawFlags_RoundCornersAll);
+
+    /* Parameter names, sliders and values, positioned from the precompiled layout */
+    size_t item_count = PARAMETER_LAYOUT.items_for(_param_count);
+    for (size_t i = 0; i < item_count; ++i)
+    {
+        const LayoutItem& item = PARAMETER_LAYOUT.items[i];
+        ImGui::SetCursorPos(item.pos);
+        switch (item.kind)
+        {
+            case WidgetKind::TITLE:
+                _text_cache.text(PARAMETER_LAYOUT.title);
+                break;
+
+            case WidgetKind::PARAMETER_NAME:
+                _text_cache.text(_param_names[item.parameter].c_str());
+                break;
+
+            case WidgetKind::PARAMETER_SLIDER:
+                /* The sliders are drawn with the OpenGL3 backend's instanced widget
+                 * path, so all of them together cost one draw call */
+                if (instanced_vslider(item.id, item.size, &_slider_values[item.parameter]))
+                {
+                    effect->setParameterAutomated(item.parameter, _slider_values[item.parameter]);
+                }
+                break;
+
+            case WidgetKind::PARAMETER_VALUE:
+                _text_cache.value(item.parameter, _slider_values[item.parameter], "%.2f", 0.01f);
+                break;
+        }
+    }
+    ImGui::SetCursorPos(PARAMETER_LAYOUT.end);
+
+    /* Show the audio from the dsp side, if any */
+    if (_audio_fifo)
+    {
+        draw_list->AddRectFilled(SCOPE_POS, ImVec2(SCOPE_POS.x + SCOPE_SIZE.x, SCOPE_POS.y + SCOPE_SIZE.y), colour, 3.0f, ImDrawFlags_RoundCornersAll);
+        /* The scope's geometry only needs the draw list, so it can be built on a worker */
+        _panels.submit(SCOPE_POS, ImVec2(SCOPE_POS.x + SCOPE_SIZE.x, SCOPE_POS.y + SCOPE_SIZE.y), [this](ImDrawList* panel_list)
+        {
+            _scope.draw(panel_list, SCOPE_POS, SCOPE_SIZE, IM_COL32(0xe0, 0xe0, 0xe0, 0xff));
+        });
+        draw_list->AddRectFilled(ANALYZER_POS, ImVec2(ANALYZER_POS.x + ANALYZER_SIZE.x, ANALYZER_POS.y + ANALYZER_SIZE.y), colour, 3.0f, ImDrawFlags_RoundCornersAll);
+        _analyzer.draw(draw_list, ANALYZER_POS, ANALYZER_SIZE, ImColor(0xe0, 0xe0, 0xe0, 0xff), ImColor(0xf0, 0xa0, 0x40, 0xff));
+        _spectrogram.draw(draw_list, SPECTROGRAM_POS, SPECTROGRAM_SIZE);
+    }
+
+    /* Finally show some statistics on cpu usage. Not when replaying headless, as
+     * they are measured from the wall clock and the draw data would differ each run */
+    if (!_headless)
+    {
+        _draw_statistics();
+    }
+    ImGui::End();
+}
+
+void Editor::_draw_statistics()
+{
+    ImGui::BeginChild("Statistics", ImVec2(SCOPE_POS.x - 15, 0));
+    _text_cache.value(TIMING_TEXT_SLOT, _timings.draw, "Draw time: %.4f ms", 0.0001f);
+    _text_cache.value(TIMING_TEXT_SLOT + 1, _timings.render, "Render time: %.4f ms", 0.0001f);
+    _text_cache.value(TIMING_TEXT_SLOT + 2, _timings.gl_render, "Open GL render time: %.4f ms", 0.0001f);
+    _text_cache.value(TIMING_TEXT_SLOT + 3, _timings.swap, "Swap time: %.4f ms", 0.0001f);
+    if (_software)
+    {
+        const auto& soft_stats = ImGui_ImplSoft_GetFrameStats();
+        ImGui::Text("Software: %d triangles in %d tiles", soft_stats.Triangles, soft_stats.Tiles);
+        ImGui::Text("Rasterizer threads: %d", soft_stats.Threads);
+    }
+    else
+    {
+        const auto& gl_stats = ImGui_ImplOpenGL3_GetFrameStats();
+        ImGui::Text("GL upload: %.1f kB", (gl_stats.VertexBytes + gl_stats.IndexBytes + gl_stats.InstanceBytes + gl_stats.TextureBytes) / 1024.0f);
+        ImGui::Text("Texture upload: %.1f kB", gl_stats.TextureBytes / 1024.0f);
+        ImGui::Text("GL draw calls: %d", gl_stats.DrawCalls);
+    }
+    const auto& input_stats = ImGui_ImplGlfw_GetInputStats();
+    ImGui::Text("Input latency: %.1f ms (max %.1f ms)", input_stats.AverageLatencyMs, input_stats.MaxLatencyMs);
+    ImGui::Text("Window system requests: %d", ImGui_ImplGlfw_GetFrameStats().ServerRequests);
+    ImGui::Text("Suspended: %.1f s", _suspended_ns / 1'000'000'000.0f);
+    ImGui::Text("Scheduling delay: %.2f ms (max %.2f ms)", _scheduler_latency.run_delay_ms(), _scheduler_latency.max_run_delay_ms());
+    if (ThreadPolicy::from_environment().max_rendering > 0)
+    {
+        ImGui::Text("Render slot wait: %.2f ms", _render_wait_ms.load());
+    }
+    ImGui::Text("Quality: %s (%.1f of %.1f ms)", QualityGovernor::level_name(_governor.level()), _governor.cost_ms(), _governor.budget_ms());
+    auto memory = memory_stats();
+    ImGui::Text("Memory: %.1f MB, GPU: %.1f MB", memory.cpu_bytes / 1'048'576.0f,
+                (memory.gpu_buffer_bytes + memory.gpu_texture_bytes + memory.framebuffer_bytes) / 1'048'576.0f);
+    ImGui::Text("Images: %d, %.1f MB, %d loading", _images.cached(), _images.cached_bytes() / 1'048'576.0f, _images.pending());
+    ImGui::Text("Glyphs: %d on demand in %.2f ms, atlas %d x %d", _glyphs.glyphs(), _glyphs.rasterize_ms(),
+                ImGui::GetIO().Fonts->TexWidth, ImGui::GetIO().Fonts->TexHeight);
+    if (_capture.is_open())
+    {
+        ImGui::Text("Captured: %d frames, %.1f MB", _capture.frames(), _capture.bytes() / 1'048'576.0f);
+    }
+    if (_audio_fifo)
     {
-        glfwTerminate();
+        ImGui::Text("Decimation time: %.4f ms", _timings.decimation);
+        ImGui::Text("Analyzer time: %.4f ms", _timings.analyzer);
+        ImGui::Text("Audio overruns: %llu", static_cast<unsigned long long>(_audio_fifo->overruns()));
     }
+    ImGui::EndChild();
 }
 
 } // imgui_editor
@@ -2,13 +2,20 @@
 #define IMPLUGINGUI_EDITOR_H
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <thread>
 #include <cstdio>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #define NOMINMAX
 #include "aeffeditor.h"
 #include "imgui_editor/imgui_editor.h"
+#include "imgui_editor/sample_fifo.h"
 
 struct ImGuiContext;
 extern thread_local ImGuiContext* MyImGuiTLS;
@@ -16,6 +23,25 @@ extern thread_local ImGuiContext* MyImGuiTLS;
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
+#include "imgui_impl_soft.h"
+#include "scope.h"
+#include "spectrum.h"
+#include "spectrogram.h"
+#include "widgets.h"
+#include "image_service.h"
+#include "draw_capture.h"
+#include "glyph_atlas.h"
+#include "input_recording.h"
+#include "memory_account.h"
+#include "parallel_panels.h"
+#include "quality_governor.h"
+#include "stats_export.h"
+#include "text_cache.h"
+#include "thread_policy.h"
+#include "thread_reaper.h"
+#ifdef LINUX
+#include "event_thread.h"
+#endif
 
 //  OpenGl include macros From DearImgui example - not exactly sure why but it works.
 //  About Desktop OpenGL function loaders:
@@ -58,27 +84,170 @@ static void glfw_error_callback(int error, const char*description)
     std::cerr << "Glfw Error " << error << ", " << description << std::endl;
 }
 
+/* OpenGL versions tried in order, with the GLSL version of the OpenGL3 backend's
+ * shaders. Instanced widgets need 3.3, which many drivers only provide as a core
+ * profile, on 3.0 the backend draws them with regular primitives */
+struct GlVersion
+{
+    int         major;
+    int         minor;
+    bool        core_profile;
+    const char* glsl_version;
+};
+constexpr GlVersion GL_VERSIONS[] = {{3, 3, true, "#version 330 core"},
+                                     {3, 0, false, "#version 130"}};
+
 class Editor : public AEffEditor
 {
 public:
-    Editor(AudioEffect* instance);
+    Editor(AudioEffect* instance, SampleFifo* audio_fifo = nullptr);
+
+    /* Waits for the draw thread to finish tearing down if the editor was just closed */
+    ~Editor() override;
 
     bool getRect(ERect**rect) override;
 
+    /* Starts the draw thread and returns without waiting for it, ready() tells
+     * when the first frame is on screen */
     bool open(void* window) override;
 
+    /* Detaches the editor's window from the host's and returns, the draw thread
+     * tears down ImGui, the GL context and the window in the background */
     void close() override;
 
+    /* True once the first frame since open() is on screen, false if the editor
+     * was closed or failed to set up before that. This and closed() must be
+     * called from the thread calling open() and close() */
+    std::shared_future<bool> ready() const
+    {
+        return _ready;
+    }
+
+    /* Ready when the draw thread has finished tearing down after close() */
+    std::shared_future<void> closed() const
+    {
+        return _closed;
+    }
+
     void idle() override;
 
+    /* Run the widget code without a window, OpenGL context or draw thread, to
+     * benchmark it on its own by replaying recorded frames. All three must be
+     * called from the same thread and not while the editor is open */
+    bool open_headless();
+
+    void draw_headless(const RecordedFrame& frame);
+
+    void close_headless();
+
+    FrameTimeStats frame_time_stats();
+
+    LifecycleStats lifecycle_stats() const;
+
+    MemoryStats memory_stats() const;
+
+    SchedulingStats scheduling_stats() const;
+
 private:
+    /* Smoothed timings shown in the statistics, in ms */
+    struct Timings
+    {
+        float draw{0};
+        float render{0};
+        float gl_render{0};
+        float swap{0};
+        float decimation{0};
+        float analyzer{0};
+    };
+
     bool _setup_open_gl(void* host_window);
 
     bool _setup_imgui();
 
-    void _draw_loop(void* window);
+    /* Takes the editor out of the instance count, stopping the event thread and
+     * terminating GLFW if it was the last one. Call holding _lifecycle_lock but
+     * not _init_lock */
+    void _release_glfw();
+
+    void _create_imgui_context();
+
+    void _setup_parameters();
+
+    /* Builds the editor's window, between ImGui::NewFrame() and ImGui::Render() */
+    void _draw_widgets();
+
+    /* The statistics child window at the bottom left, part of _draw_widgets() */
+    void _draw_statistics();
+
+    /* Drains the audio fifo into the scope, analyzer and spectrogram */
+    void _process_audio();
+
+    /* Uploads the rows of the font atlas glyphs were added to since the last call */
+    void _upload_glyphs();
+
+    /* Renders draw_data with the software renderer and copies it to the window */
+    void _render_soft(ImDrawData* draw_data, int width, int height);
+
+    /* Deletes the texture and framebuffer the software renderer's frames are copied from */
+    void _release_soft();
+
+    /* One open() to close() of the editor, as seen by its draw thread */
+    /* How far the draw thread is with the X window. close() runs on the host's
+     * thread and moves the window out of the host's one without taking a lock,
+     * as the draw thread holding it may be running at idle priority */
+    enum class WindowState
+    {
+        NOT_CREATED,
+        CREATING,
+        ATTACHED,       // In the host's window
+        DETACHING,
+        DETACHED,       // Moved out of the host's window by close()
+        DESTROYING,     // Closed on its own, before close() was called
+        CLOSED
+    };
+
+    struct EmbeddedWindow
+    {
+        std::atomic<WindowState> state{WindowState::NOT_CREATED};
+        unsigned long            window{0};
+    };
+
+    struct DrawSession
+    {
+        int                      number;
+        std::promise<bool>       ready;
+        std::promise<void>       closed;
+        std::shared_future<void> previous;  // Teardown of the last session, which may still be running
+        std::shared_ptr<EmbeddedWindow> embedded;
+    };
+
+    void _draw_loop(void* window, DrawSession session);
+
+    /* False once the editor has been closed, or opened again, since session started */
+    bool _session_open(int session) const
+    {
+        return _running && _session == session;
+    }
+
+#ifdef LINUX
+    /* Moves the window out of the host's, so the host can destroy its window right
+     * away, or stops the draw thread from creating it if it hasn't yet */
+    void _detach_window();
+#endif
+
+    bool _visible();
+
+    /* Waits until the editor can be seen again or session is closed */
+    void _suspend(int session);
+
+    void _record_frame_time(float ms);
+
+    /* Publishes the statistics to the shared memory segment if it's time to */
+    void _publish_stats(int session, std::chrono::high_resolution_clock::time_point now);
 
     static std::atomic<int> instance_counter;
+    /* Numbers capture and recording files so each time an editor is opened gets its own */
+    static std::atomic<int> session_counter;
 
     int              _num_parameters;
     std::atomic_bool _running{false};
@@ -86,12 +255,88 @@ private:
     ERect            _rect;
 
     static std::mutex _init_lock;
+    /* Held while the instance count changes, together with GLFW's initialization
+     * and the event thread, always taken before _init_lock */
+    static std::mutex _lifecycle_lock;
+#ifdef LINUX
+    /* Dispatches events for all editors, lives from the first editor opened to the last one closed */
+    static std::unique_ptr<EventThread> _event_thread;
+    WindowVisibility _visibility;
+    /* The current session's window, only used by the host's thread */
+    std::shared_ptr<EmbeddedWindow> _embedded;
+#endif
+    /* Joins draw threads after close() so the host doesn't wait for their teardown */
+    static ThreadReaper _reaper;
+    /* Limits how many editors draw a frame at the same time, see ThreadPolicy */
+    static RenderSlots _render_slots;
+    std::shared_future<bool> _ready;
+    std::shared_future<void> _closed;
+    std::chrono::high_resolution_clock::time_point _close_time;
+    std::atomic<float>       _open_call_ms{0};
+    std::atomic<float>       _close_call_ms{0};
+    std::atomic<float>       _teardown_ms{-1.0f};
+    std::mutex              _visibility_lock;
+    std::condition_variable _visibility_changed;
+    std::atomic<int64_t>    _suspended_ns{0};
+
+    GLFWwindow* _window{nullptr};
+    /* Of the OpenGL context that could be created */
+    const char* _glsl_version{nullptr};
+
+    /* Render with the software renderer, OpenGL then only copies the frame to the window */
+    bool               _software;
+    /* Between open_headless() and close_headless() */
+    bool               _headless{false};
+    SampleFifo*        _audio_fifo;
+    std::vector<float> _audio_buffer;
+    Scope              _scope;
+    SpectrumAnalyzer   _analyzer;
+    Spectrogram        _spectrogram;
+    ImageService       _images;
+    DrawCaptureWriter  _capture;
+    InputRecorder      _recorder;
+    std::atomic<int>   _session{-1};
+    Timings            _timings;
+    QualityGovernor    _governor;
+    GlyphAtlas         _glyphs;
+    TextCache          _text_cache;
+    ParallelPanels     _panels;
+    SchedulerLatency   _scheduler_latency;
+    std::atomic<float> _render_wait_ms{0};
+
+    /* The most recent frame times in a ring buffer, read from other threads */
+    std::mutex         _frame_time_lock;
+    std::vector<float> _frame_times;
+    int                _frame_count{0};
+    std::chrono::high_resolution_clock::time_point _open_time;
+    std::atomic<float> _open_latency{-1.0f};
+
+    /* Only used by the draw thread */
+    StatsExport        _stats_export;
+    uint64_t           _skipped_frames{0};
+    int                _stats_publish_frames{0};
+    std::chrono::high_resolution_clock::time_point _stats_publish_time;
+
+    /* Everything ImGui allocates for this editor is charged to _memory, the rest
+     * is published by the draw thread every frame */
+    MemoryAccount        _memory;
+    std::atomic<int64_t> _backend_bytes{0};
+    std::atomic<int64_t> _gpu_buffer_bytes{0};
+    std::atomic<int64_t> _gpu_texture_bytes{0};
+    std::atomic<int64_t> _framebuffer_bytes{0};
+    std::atomic<int64_t> _thread_stack_bytes{0};
 
-    GLFWwindow* _window;
+    /* Only used by the draw thread, with the software renderer */
+    std::vector<ImU32> _soft_pixels;
+    GLuint             _soft_texture{0};
+    GLuint             _soft_framebuffer{0};
+    int                _soft_width{0};
+    int                _soft_height{0};
 
+    int                      _param_count{0};
+    std::vector<std::string> _param_names;
     float _slider_values[10];
     ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
-    ImVec2 slider_s{20, 105};
 };
 
 } // imgui_editor
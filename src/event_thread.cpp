@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <iostream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <X11/Xlib.h>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <GLFW/glfw3native.h>
+
+#include "event_thread.h"
+
+namespace imgui_editor {
+
+EventThread::EventThread(std::mutex& glfw_lock) : _glfw_lock(glfw_lock)
+{
+    /* Non-blocking, a full pipe already wakes the thread up */
+    if (pipe2(_wake_pipe, O_NONBLOCK | O_CLOEXEC) != 0)
+    {
+        std::cerr << "Failed to create event thread pipe" << std::endl;
+    }
+    _thread = std::thread(&EventThread::_run, this);
+}
+
+EventThread::~EventThread()
+{
+    _running = false;
+    _wake();
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+    close(_wake_pipe[0]);
+    close(_wake_pipe[1]);
+}
+
+void EventThread::xlib_used()
+{
+    /* Events Xlib has read off the connection since the thread last looked stay in
+     * its queue, without the file descriptor becoming readable for them */
+    Display* display = glfwGetX11Display();
+    if (display != nullptr && XEventsQueued(display, QueuedAlready) > 0)
+    {
+        _wake();
+    }
+}
+
+void EventThread::_wake()
+{
+    char wake = 0;
+    [[maybe_unused]] auto res = write(_wake_pipe[1], &wake, 1);
+}
+
+/* Picks out the events that change the visibility of a tracked window, GLFW ignores all of them */
+static Bool is_visibility_event([[maybe_unused]] Display* display, XEvent* event, XPointer arg)
+{
+    auto tracked = reinterpret_cast<const std::vector<WindowVisibility*>*>(arg);
+    for (const auto visibility : *tracked)
+    {
+        if (event->type == VisibilityNotify && event->xvisibility.window == visibility->window)
+        {
+            return True;
+        }
+        if (event->type == ReparentNotify && event->xany.window == visibility->window)
+        {
+            return True;
+        }
+        if ((event->type == MapNotify || event->type == UnmapNotify || event->type == ReparentNotify) &&
+            std::find(visibility->ancestors.begin(), visibility->ancestors.end(), event->xany.window) != visibility->ancestors.end())
+        {
+            return True;
+        }
+    }
+    return False;
+}
+
+static bool is_viewable(Display* display, Window window)
+{
+    XWindowAttributes attributes;
+    return XGetWindowAttributes(display, window, &attributes) == 0 || attributes.map_state == IsViewable;
+}
+
+static int ignore_x_error([[maybe_unused]] Display* display, [[maybe_unused]] XErrorEvent* error)
+{
+    return 0;
+}
+
+/* The host can destroy its windows at any time, and selecting input on a destroyed
+ * window is an error, which the default handler terminates the process for */
+static void select_input(Display* display, const std::vector<unsigned long>& windows, long mask)
+{
+    if (windows.empty())
+    {
+        return;
+    }
+    XSync(display, False);
+    auto previous_handler = XSetErrorHandler(ignore_x_error);
+    for (auto window : windows)
+    {
+        XSelectInput(display, window, mask);
+    }
+    XSync(display, False);
+    XSetErrorHandler(previous_handler);
+}
+
+void EventThread::track(WindowVisibility* visibility)
+{
+    Display* display = glfwGetX11Display();
+    if (display == nullptr)
+    {
+        return;
+    }
+    visibility->ancestors.clear();
+    _update_ancestors(visibility);
+    visibility->obscured = false;
+    _tracked.push_back(visibility);
+}
+
+void EventThread::untrack(WindowVisibility* visibility)
+{
+    _tracked.erase(std::remove(_tracked.begin(), _tracked.end(), visibility), _tracked.end());
+    Display* display = glfwGetX11Display();
+    if (display == nullptr)
+    {
+        return;
+    }
+    select_input(display, _released_ancestors(visibility, {}), NoEventMask);
+    visibility->ancestors.clear();
+    xlib_used();
+}
+
+void EventThread::_update_ancestors(WindowVisibility* visibility)
+{
+    Display* display = glfwGetX11Display();
+    /* Get map notifications for every ancestor below the root, i.e. the host's
+     * windows up to and including the window manager's frame */
+    std::vector<unsigned long> ancestors;
+    Window window = visibility->window;
+    Window root;
+    Window parent;
+    Window* children;
+    unsigned int child_count;
+    while (XQueryTree(display, window, &root, &parent, &children, &child_count) != 0)
+    {
+        if (children)
+        {
+            XFree(children);
+        }
+        if (parent == 0 || parent == root)
+        {
+            break;
+        }
+        ancestors.push_back(parent);
+        window = parent;
+    }
+    select_input(display, _released_ancestors(visibility, ancestors), NoEventMask);
+    select_input(display, ancestors, StructureNotifyMask);
+    visibility->ancestors = std::move(ancestors);
+    visibility->viewable = is_viewable(display, visibility->window);
+}
+
+std::vector<unsigned long> EventThread::_released_ancestors(const WindowVisibility* visibility,
+                                                            const std::vector<unsigned long>& keep) const
+{
+    /* Editors in the same host window share ancestors, and all share one connection */
+    std::vector<unsigned long> released;
+    for (auto ancestor : visibility->ancestors)
+    {
+        bool used = std::find(keep.begin(), keep.end(), ancestor) != keep.end();
+        for (const auto other : _tracked)
+        {
+            used = used || (other != visibility &&
+                            std::find(other->ancestors.begin(), other->ancestors.end(), ancestor) != other->ancestors.end());
+        }
+        if (!used)
+        {
+            released.push_back(ancestor);
+        }
+    }
+    return released;
+}
+
+void EventThread::_process_visibility_events()
+{
+    Display* display = glfwGetX11Display();
+    if (_tracked.empty() || XEventsQueued(display, QueuedAfterReading) == 0)
+    {
+        return;
+    }
+    XEvent event;
+    std::vector<XEvent> glfw_events;
+    while (XCheckIfEvent(display, &event, is_visibility_event, reinterpret_cast<XPointer>(&_tracked)))
+    {
+        bool for_glfw = false;
+        for (auto visibility : _tracked)
+        {
+            bool was_visible = visibility->visible();
+            bool from_ancestor = std::find(visibility->ancestors.begin(), visibility->ancestors.end(),
+                                           event.xany.window) != visibility->ancestors.end();
+            if (event.type == VisibilityNotify && event.xvisibility.window == visibility->window)
+            {
+                /* Only sent while the window is viewable */
+                visibility->viewable = true;
+                visibility->obscured = event.xvisibility.state == VisibilityFullyObscured;
+            }
+            else if (event.type == ReparentNotify && (event.xany.window == visibility->window || from_ancestor))
+            {
+                /* The window or an ancestor moved to another parent, i.e. a window
+                 * manager framed the host's window, so the ancestors changed */
+                for_glfw = for_glfw || event.xany.window == visibility->window;
+                _update_ancestors(visibility);
+            }
+            else if (event.type != VisibilityNotify && from_ancestor)
+            {
+                visibility->viewable = is_viewable(display, visibility->window);
+            }
+            if (visibility->visible() != was_visible && visibility->on_change)
+            {
+                visibility->on_change();
+            }
+        }
+        if (for_glfw)
+        {
+            glfw_events.push_back(event);
+        }
+    }
+    /* GLFW keeps track of its windows' parents, put their reparent events back in order */
+    for (auto i = glfw_events.rbegin(); i != glfw_events.rend(); ++i)
+    {
+        XPutBackEvent(display, &*i);
+    }
+}
+
+void EventThread::_run()
+{
+    Display* display = glfwGetX11Display();
+    if (display == nullptr)
+    {
+        std::cerr << "No X11 display, event thread not running" << std::endl;
+        return;
+    }
+    pollfd fds[2] = {{ConnectionNumber(display), POLLIN, 0},
+                     {_wake_pipe[0], POLLIN, 0}};
+    while (_running)
+    {
+        {
+            std::scoped_lock<std::mutex> lock(_glfw_lock);
+            _process_visibility_events();
+            glfwPollEvents();
+        }
+        if (XEventsQueued(display, QueuedAlready) > 0)
+        {
+            continue;
+        }
+        /* Events queued by other threads from now on are signalled through the pipe */
+        if (poll(fds, 2, -1) > 0 && (fds[1].revents & POLLIN))
+        {
+            char buffer[64];
+            while (read(_wake_pipe[0], buffer, sizeof(buffer)) > 0)
+            {}
+        }
+    }
+}
+
+} // imgui_editor
@@ -0,0 +1,84 @@
+#ifndef IMPLUGINGUI_EVENT_THREAD_H
+#define IMPLUGINGUI_EVENT_THREAD_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace imgui_editor {
+
+/* Whether an X11 window can be seen, kept up to date by the event thread from
+ * visibility notifications of the window and map notifications of its ancestors,
+ * as a window embedded in a host's window isn't told when the host hides it */
+struct WindowVisibility
+{
+    unsigned long              window{0};
+    std::vector<unsigned long> ancestors;
+    std::atomic_bool           viewable{true};
+    std::atomic_bool           obscured{false};
+    /* Called from the event thread when visible() changes */
+    std::function<void()>      on_change;
+
+    bool visible() const
+    {
+        return viewable && !obscured;
+    }
+};
+
+/* Dispatches X11 events for all open editors from a single thread.
+ * All GLFW windows in the process share one X connection, and GLFW doesn't
+ * support processing events for it from several threads at once. Instead of
+ * every editor thread calling glfwPollEvents() each frame, this thread sleeps
+ * on the connection's file descriptor and processes events only when there are
+ * any. The GLFW backend's callbacks route them to each window's own lock-free
+ * queue, and editor threads wait on their queue with ImGui_ImplGlfw_WaitForEvents().
+ * Xlib calls on other threads can read events off the connection into Xlib's
+ * queue, where this thread doesn't see them, so those threads must call
+ * xlib_used() after them. There is no timeout otherwise.
+ *
+ * glfw_lock is held while GLFW processes events, so windows can be created and
+ * destroyed safely by holding the same lock. Must be created after glfwInit()
+ * and destroyed before glfwTerminate(), without holding glfw_lock */
+class EventThread
+{
+public:
+    explicit EventThread(std::mutex& glfw_lock);
+
+    ~EventThread();
+
+    /* Start and stop updating visibility, both must be called holding glfw_lock.
+     * visibility->window must be set, and visibility must stay valid until untracked.
+     * The ancestors are followed as the window or any of them is reparented, and
+     * untracking stops selecting events on those no other tracked window shares */
+    void track(WindowVisibility* visibility);
+
+    void untrack(WindowVisibility* visibility);
+
+    /* Wakes the thread up if Xlib has queued events while the calling thread used
+     * the connection, i.e. swapped buffers. Can be called from any thread */
+    void xlib_used();
+
+private:
+    void _wake();
+
+    void _run();
+
+    void _process_visibility_events();
+
+    void _update_ancestors(WindowVisibility* visibility);
+
+    std::vector<unsigned long> _released_ancestors(const WindowVisibility* visibility,
+                                                   const std::vector<unsigned long>& keep) const;
+
+    std::mutex&      _glfw_lock;
+    std::vector<WindowVisibility*> _tracked;
+    /* Written to stop the thread or to make it look at Xlib's queue */
+    int              _wake_pipe[2]{-1, -1};
+    std::atomic_bool _running{true};
+    std::thread      _thread;
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_EVENT_THREAD_H
@@ -0,0 +1,159 @@
+#include <cmath>
+#include <cassert>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define FFT_USE_SSE
+#endif
+
+#include "fft.h"
+
+namespace imgui_editor {
+
+constexpr double PI = 3.14159265358979323846;
+
+RealFft::RealFft(int size) : _size(size),
+                             _half_size(size / 2),
+                             _bit_reverse(_half_size),
+                             _twiddle_re(_half_size),
+                             _twiddle_im(_half_size),
+                             _split_re(_half_size + 1),
+                             _split_im(_half_size + 1),
+                             _re(_half_size),
+                             _im(_half_size)
+{
+    assert(size >= 4 && (size & (size - 1)) == 0);
+
+    int bits = 0;
+    while ((1 << bits) < _half_size)
+    {
+        ++bits;
+    }
+    for (int i = 0; i < _half_size; ++i)
+    {
+        int reversed = 0;
+        for (int b = 0; b < bits; ++b)
+        {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        _bit_reverse[i] = reversed;
+    }
+
+    for (int span = 1; span < _half_size; span *= 2)
+    {
+        for (int j = 0; j < span; ++j)
+        {
+            double angle = -PI * j / span;
+            _twiddle_re[span - 1 + j] = static_cast<float>(std::cos(angle));
+            _twiddle_im[span - 1 + j] = static_cast<float>(std::sin(angle));
+        }
+    }
+
+    for (int k = 0; k <= _half_size; ++k)
+    {
+        double angle = -2.0 * PI * k / _size;
+        _split_re[k] = static_cast<float>(std::cos(angle));
+        _split_im[k] = static_cast<float>(std::sin(angle));
+    }
+}
+
+void RealFft::power_spectrum(const float* input, float* power_out)
+{
+    /* Pack even samples as the real part, odd as imaginary, in bit reversed order */
+    for (int i = 0; i < _half_size; ++i)
+    {
+        _re[_bit_reverse[i]] = input[2 * i];
+        _im[_bit_reverse[i]] = input[2 * i + 1];
+    }
+
+    _complex_fft();
+
+    /* Split the half size complex result into the spectrum of the real input */
+    const float* re = _re.data();
+    const float* im = _im.data();
+    for (int k = 0; k <= _half_size; ++k)
+    {
+        int k_a = k == _half_size ? 0 : k;
+        int k_b = k == 0 ? 0 : _half_size - k;
+        float even_re = 0.5f * (re[k_a] + re[k_b]);
+        float even_im = 0.5f * (im[k_a] - im[k_b]);
+        float odd_re = 0.5f * (im[k_a] + im[k_b]);
+        float odd_im = -0.5f * (re[k_a] - re[k_b]);
+        float x_re = even_re + _split_re[k] * odd_re - _split_im[k] * odd_im;
+        float x_im = even_im + _split_re[k] * odd_im + _split_im[k] * odd_re;
+        power_out[k] = x_re * x_re + x_im * x_im;
+    }
+}
+
+void RealFft::_complex_fft()
+{
+    float* re = _re.data();
+    float* im = _im.data();
+    int n = _half_size;
+
+    /* The first stages have spans too short to vectorise */
+    int span = 1;
+    for (; span < n && span < 4; span *= 2)
+    {
+        const float* tw_re = _twiddle_re.data() + span - 1;
+        const float* tw_im = _twiddle_im.data() + span - 1;
+        for (int i = 0; i < n; i += 2 * span)
+        {
+            for (int j = 0; j < span; ++j)
+            {
+                int a = i + j;
+                int b = a + span;
+                float v_re = re[b] * tw_re[j] - im[b] * tw_im[j];
+                float v_im = re[b] * tw_im[j] + im[b] * tw_re[j];
+                re[b] = re[a] - v_re;
+                im[b] = im[a] - v_im;
+                re[a] += v_re;
+                im[a] += v_im;
+            }
+        }
+    }
+
+    for (; span < n; span *= 2)
+    {
+        const float* tw_re = _twiddle_re.data() + span - 1;
+        const float* tw_im = _twiddle_im.data() + span - 1;
+        for (int i = 0; i < n; i += 2 * span)
+        {
+#ifdef FFT_USE_SSE
+            for (int j = 0; j < span; j += 4)
+            {
+                float* a_re = re + i + j;
+                float* a_im = im + i + j;
+                float* b_re = a_re + span;
+                float* b_im = a_im + span;
+                __m128 w_re = _mm_loadu_ps(tw_re + j);
+                __m128 w_im = _mm_loadu_ps(tw_im + j);
+                __m128 x_re = _mm_loadu_ps(b_re);
+                __m128 x_im = _mm_loadu_ps(b_im);
+                __m128 v_re = _mm_sub_ps(_mm_mul_ps(x_re, w_re), _mm_mul_ps(x_im, w_im));
+                __m128 v_im = _mm_add_ps(_mm_mul_ps(x_re, w_im), _mm_mul_ps(x_im, w_re));
+                __m128 u_re = _mm_loadu_ps(a_re);
+                __m128 u_im = _mm_loadu_ps(a_im);
+                _mm_storeu_ps(a_re, _mm_add_ps(u_re, v_re));
+                _mm_storeu_ps(a_im, _mm_add_ps(u_im, v_im));
+                _mm_storeu_ps(b_re, _mm_sub_ps(u_re, v_re));
+                _mm_storeu_ps(b_im, _mm_sub_ps(u_im, v_im));
+            }
+#else
+            for (int j = 0; j < span; ++j)
+            {
+                int a = i + j;
+                int b = a + span;
+                float v_re = re[b] * tw_re[j] - im[b] * tw_im[j];
+                float v_im = re[b] * tw_im[j] + im[b] * tw_re[j];
+                re[b] = re[a] - v_re;
+                im[b] = im[a] - v_im;
+                re[a] += v_re;
+                im[a] += v_im;
+            }
+#endif
+        }
+    }
+}
+
+} // imgui_editor
@@ -0,0 +1,44 @@
+#ifndef IMPLUGINGUI_FFT_H
+#define IMPLUGINGUI_FFT_H
+
+#include <vector>
+
+namespace imgui_editor {
+
+/* Real to complex fft of a fixed, power of 2 size. Computed as a complex
+ * fft of half the size followed by a split step. Data is kept in split
+ * real/imaginary arrays so the butterflies can be vectorised with SSE.
+ * All memory is allocated in the constructor */
+class RealFft
+{
+public:
+    explicit RealFft(int size);
+
+    int size() const
+    {
+        return _size;
+    }
+
+    /* Calculate the power spectrum |X(k)|^2 of size input samples, writes
+     * size / 2 + 1 values to power_out. input and power_out may not overlap */
+    void power_spectrum(const float* input, float* power_out);
+
+private:
+    void _complex_fft();
+
+    int                _size;
+    int                _half_size;
+    std::vector<int>   _bit_reverse;
+    /* Twiddle factors for all stages of the complex fft, the stage with
+     * butterfly span n starts at index n - 1 */
+    std::vector<float> _twiddle_re;
+    std::vector<float> _twiddle_im;
+    /* Twiddle factors for the real split step */
+    std::vector<float> _split_re;
+    std::vector<float> _split_im;
+    std::vector<float> _re;
+    std::vector<float> _im;
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_FFT_H
@@ -0,0 +1,26 @@
+#ifndef IMPLUGINGUI_FNV_HASH_H
+#define IMPLUGINGUI_FNV_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace imgui_editor {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+/* 64 bit FNV-1a of size bytes, continuing from hash, which is FNV_OFFSET for
+ * the first buffer. Fast and good enough for cache keys and comparing draw
+ * data, but not for anything an attacker controls */
+inline uint64_t fnv_hash(uint64_t hash, const void* data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+} // imgui_editor
+#endif //IMPLUGINGUI_FNV_HASH_H
@@ -0,0 +1,410 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <unordered_set>
+
+#include "glyph_atlas.h"
+#include "utf8.h"
+
+/* A private copy of stb_truetype, the one in Dear ImGui is static to
+ * imgui_draw.cpp. Glyphs are rasterized the same way as when building the atlas */
+#define STBTT_malloc(x, u)  ((void)(u), IM_ALLOC(x))
+#define STBTT_free(x, u)    ((void)(u), IM_FREE(x))
+#define STBTT_assert(x)     IM_ASSERT(x)
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic ignored "-Wimplicit-fallthrough"
+#endif
+#include "imstb_truetype.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace imgui_editor {
+
+/* The atlas doubles in height up to this, glyphs that don't fit after that are
+ * drawn as the fallback glyph */
+constexpr int MAX_ATLAS_HEIGHT = 4096;
+
+struct GlyphAtlas::Font
+{
+    ImFont*                     font;
+    const ImWchar*              ranges;
+    stbtt_fontinfo              info{};
+    float                       scale{0};
+    std::unordered_set<ImWchar> missing;    // Not in the ranges or the font file
+    std::vector<ImWchar>        pending;    // Waiting for the atlas to grow
+};
+
+static bool in_ranges(const ImWchar* ranges, ImWchar c)
+{
+    for (; ranges[0] != 0; ranges += 2)
+    {
+        if (c >= ranges[0] && c <= ranges[1])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Same as stb_truetype does for oversampled glyphs */
+static float oversample_shift(int oversample)
+{
+    return oversample > 1 ? -(oversample - 1) / (2.0f * oversample) : 0.0f;
+}
+
+GlyphAtlas::GlyphAtlas() = default;
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+void GlyphAtlas::add(ImFont* font, const ImWchar* ranges)
+{
+    auto entry = std::make_unique<Font>();
+    entry->font = font;
+    entry->ranges = ranges;
+    _fonts.push_back(std::move(entry));
+}
+
+void GlyphAtlas::clear()
+{
+    _fonts.clear();
+    _shelves.clear();
+    _atlas = nullptr;
+    _pixels = nullptr;
+    _shelves_end = 0;
+    _dirty_begin = 0;
+    _dirty_end = 0;
+}
+
+void GlyphAtlas::use(ImFont* font, const char* text, const char* text_end)
+{
+    Font* entry = _find(font);
+    if (entry == nullptr)
+    {
+        return;
+    }
+    if (text_end == nullptr)
+    {
+        text_end = text + std::strlen(text);
+    }
+    /* Until the atlas is built, or after it was rebuilt, glyphs wait for new_frame() */
+    bool ready = _atlas != nullptr && _atlas->TexPixelsRGBA32 == _pixels;
+    int added = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    while (text < text_end)
+    {
+        unsigned int c;
+        text += decode_utf8(text, text_end, &c);
+        if (c > IM_UNICODE_CODEPOINT_MAX || c == '\n' || c == '\r')
+        {
+            continue;
+        }
+        auto character = static_cast<ImWchar>(c);
+        /* The lookup table is only updated once the whole text is done, so
+         * look for glyphs added by this call among the last ones added */
+        if (font->FindGlyphNoFallback(character) != nullptr || entry->missing.count(character) != 0 ||
+            std::find(entry->pending.begin(), entry->pending.end(), character) != entry->pending.end() ||
+            std::any_of(font->Glyphs.end() - added, font->Glyphs.end(), [&](const ImFontGlyph& glyph) {return glyph.Codepoint == character;}))
+        {
+            continue;
+        }
+        Result result = ready ? _rasterize(*entry, character) : Result::NO_ROOM;
+        if (result == Result::NO_ROOM)
+        {
+            entry->pending.push_back(character);
+        }
+        added += result == Result::ADDED ? 1 : 0;
+    }
+    if (added > 0)
+    {
+        font->BuildLookupTable();
+        _rasterize_ms += (std::chrono::high_resolution_clock::now() - start).count() / 1'000'000.0f;
+    }
+}
+
+bool GlyphAtlas::new_frame()
+{
+    if (_fonts.empty())
+    {
+        return false;
+    }
+    bool rebuilt = _atlas == nullptr || _atlas->TexPixelsRGBA32 != _pixels;
+    if (rebuilt && !_init())
+    {
+        return false;
+    }
+    bool added = false;
+    bool grown = false;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& font : _fonts)
+    {
+        if (font->pending.empty())
+        {
+            continue;
+        }
+        bool font_added = false;
+        for (ImWchar character : font->pending)
+        {
+            if (font->font->FindGlyphNoFallback(character) != nullptr)
+            {
+                continue;
+            }
+            Result result = _rasterize(*font, character);
+            while (result == Result::NO_ROOM && _grow())
+            {
+                grown = true;
+                result = _rasterize(*font, character);
+            }
+            if (result == Result::NO_ROOM)
+            {
+                std::cerr << "Font atlas is full, can't add U+" << std::hex << character << std::dec << std::endl;
+                font->missing.insert(character);
+            }
+            font_added |= result == Result::ADDED;
+        }
+        font->pending.clear();
+        if (font_added)
+        {
+            font->font->BuildLookupTable();
+            added = true;
+        }
+    }
+    if (added)
+    {
+        _rasterize_ms += (std::chrono::high_resolution_clock::now() - start).count() / 1'000'000.0f;
+    }
+    return added || grown;
+}
+
+bool GlyphAtlas::take_dirty_rows(int& y, int& height)
+{
+    if (_dirty_end <= _dirty_begin)
+    {
+        return false;
+    }
+    y = _dirty_begin;
+    height = _dirty_end - _dirty_begin;
+    _dirty_begin = 0;
+    _dirty_end = 0;
+    return true;
+}
+
+bool GlyphAtlas::_init()
+{
+    _atlas = ImGui::GetIO().Fonts;
+    unsigned char* pixels;
+    int width;
+    int height;
+    _atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    if (pixels == nullptr)
+    {
+        _atlas = nullptr;
+        return false;
+    }
+    /* Glyphs are only added to the RGBA pixels, so the alpha copy would go stale */
+    if (_atlas->TexPixelsAlpha8 != nullptr)
+    {
+        IM_FREE(_atlas->TexPixelsAlpha8);
+        _atlas->TexPixelsAlpha8 = nullptr;
+    }
+    _pixels = _atlas->TexPixelsRGBA32;
+
+    /* New glyphs go below the last row the atlas build put anything in */
+    int used = height;
+    while (used > 0 && std::all_of(_pixels + (used - 1) * width, _pixels + used * width, [](unsigned int pixel) {return (pixel & IM_COL32_A_MASK) == 0;}))
+    {
+        used--;
+    }
+    _shelves.clear();
+    _shelves_end = used > 0 ? used + _atlas->TexGlyphPadding : 0;
+    _dirty_begin = 0;
+    _dirty_end = 0;
+
+    for (auto& font : _fonts)
+    {
+        font->missing.clear();
+        font->scale = 0;
+        const ImFontConfig* config = font->font->ConfigData;
+        auto data = config != nullptr ? static_cast<const unsigned char*>(config->FontData) : nullptr;
+        int offset = data != nullptr ? stbtt_GetFontOffsetForIndex(data, config->FontNo) : -1;
+        if (offset < 0 || !stbtt_InitFont(&font->info, data, offset))
+        {
+            std::cerr << "Can't load glyphs on demand, the font data is not available" << std::endl;
+            continue;
+        }
+        font->scale = config->SizePixels > 0 ? stbtt_ScaleForPixelHeight(&font->info, config->SizePixels) :
+                                               stbtt_ScaleForMappingEmToPixels(&font->info, -config->SizePixels);
+    }
+    return true;
+}
+
+GlyphAtlas::Font* GlyphAtlas::_find(ImFont* font)
+{
+    for (auto& entry : _fonts)
+    {
+        if (entry->font == font)
+        {
+            return entry.get();
+        }
+    }
+    return nullptr;
+}
+
+GlyphAtlas::Result GlyphAtlas::_rasterize(Font& font, ImWchar c)
+{
+    int glyph = font.scale > 0 && in_ranges(font.ranges, c) ? stbtt_FindGlyphIndex(&font.info, c) : 0;
+    if (glyph == 0)
+    {
+        font.missing.insert(c);
+        return Result::MISSING;
+    }
+    const ImFontConfig& config = *font.font->ConfigData;
+    int oversample_h = std::max(1, config.OversampleH);
+    int oversample_v = std::max(1, config.OversampleV);
+    float scale_x = font.scale * oversample_h;
+    float scale_y = font.scale * oversample_v;
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(&font.info, glyph, scale_x, scale_y, 0, 0, &x0, &y0, &x1, &y1);
+    int width = x1 > x0 ? x1 - x0 + oversample_h - 1 : 0;
+    int height = y1 > y0 ? y1 - y0 + oversample_v - 1 : 0;
+
+    /* Empty glyphs, like spaces, only need their advance */
+    ImVec2 uv0(0, 0);
+    ImVec2 uv1(0, 0);
+    if (width > 0 && height > 0)
+    {
+        int x;
+        int y;
+        int padding = _atlas->TexGlyphPadding;
+        if (!_allocate(width + padding, height + padding, x, y))
+        {
+            return Result::NO_ROOM;
+        }
+        _bitmap.assign(static_cast<size_t>(width) * height, 0);
+        float sub_x;
+        float sub_y;
+        stbtt_MakeGlyphBitmapSubpixelPrefilter(&font.info, _bitmap.data(), width, height, width, scale_x, scale_y, 0, 0,
+                                               oversample_h, oversample_v, &sub_x, &sub_y, glyph);
+        float multiply = config.RasterizerMultiply;
+        for (int row = 0; row < height; ++row)
+        {
+            const unsigned char* source = _bitmap.data() + row * width;
+            unsigned int* destination = _pixels + (y + row) * _atlas->TexWidth + x;
+            for (int column = 0; column < width; ++column)
+            {
+                int alpha = multiply == 1.0f ? source[column] : std::min(255, static_cast<int>(source[column] * multiply));
+                destination[column] = IM_COL32(255, 255, 255, alpha);
+            }
+        }
+        _mark_dirty(y, height);
+        uv0 = ImVec2(x * _atlas->TexUvScale.x, y * _atlas->TexUvScale.y);
+        uv1 = ImVec2((x + width) * _atlas->TexUvScale.x, (y + height) * _atlas->TexUvScale.y);
+    }
+
+    /* Placed as the atlas build does, see stbtt_GetPackedQuad() */
+    float offset_x = oversample_shift(oversample_h) + config.GlyphOffset.x;
+    float offset_y = oversample_shift(oversample_v) + config.GlyphOffset.y + static_cast<float>(static_cast<int>(font.font->Ascent + 0.5f));
+    int advance;
+    int left_side_bearing;
+    stbtt_GetGlyphHMetrics(&font.info, glyph, &advance, &left_side_bearing);
+
+    /* ImFont::BuildLookupTable() appends a copy of the space glyph for tabs
+     * unless it's already the last glyph, so take it out again first */
+    if (!font.font->Glyphs.empty() && font.font->Glyphs.back().Codepoint == '\t')
+    {
+        font.font->Glyphs.pop_back();
+    }
+    font.font->AddGlyph(&config, c,
+                        x0 / static_cast<float>(oversample_h) + offset_x, y0 / static_cast<float>(oversample_v) + offset_y,
+                        (x0 + width) / static_cast<float>(oversample_h) + offset_x, (y0 + height) / static_cast<float>(oversample_v) + offset_y,
+                        uv0.x, uv0.y, uv1.x, uv1.y, advance * font.scale);
+    _glyphs++;
+    return Result::ADDED;
+}
+
+bool GlyphAtlas::_allocate(int width, int height, int& x, int& y)
+{
+    /* Shelf packing, glyphs of similar height share a row. A glyph goes on the
+     * lowest shelf it fits on, unless that would waste more than half of it */
+    Shelf* best = nullptr;
+    for (auto& shelf : _shelves)
+    {
+        if (shelf.height >= height && shelf.x + width <= _atlas->TexWidth && (best == nullptr || shelf.height < best->height))
+        {
+            best = &shelf;
+        }
+    }
+    bool room_for_shelf = _shelves_end + height <= _atlas->TexHeight && width <= _atlas->TexWidth;
+    if (room_for_shelf && (best == nullptr || best->height > height * 2))
+    {
+        _shelves.push_back({_shelves_end, height, 0});
+        _shelves_end += height;
+        best = &_shelves.back();
+    }
+    if (best == nullptr)
+    {
+        return false;
+    }
+    x = best->x;
+    y = best->y;
+    best->x += width;
+    return true;
+}
+
+bool GlyphAtlas::_grow()
+{
+    int width = _atlas->TexWidth;
+    int height = _atlas->TexHeight;
+    if (height * 2 > MAX_ATLAS_HEIGHT)
+    {
+        return false;
+    }
+    size_t size = static_cast<size_t>(width) * height;
+    auto pixels = static_cast<unsigned int*>(IM_ALLOC(size * 2 * sizeof(unsigned int)));
+    std::memcpy(pixels, _pixels, size * sizeof(unsigned int));
+    std::fill(pixels + size, pixels + size * 2, IM_COL32(255, 255, 255, 0));
+    IM_FREE(_atlas->TexPixelsRGBA32);
+    _atlas->TexPixelsRGBA32 = pixels;
+    _atlas->TexHeight = height * 2;
+    _pixels = pixels;
+
+    /* Everything stays where it is in pixels, so only the vertical texture
+     * coordinates change, and they all halve */
+    _atlas->TexUvScale = ImVec2(1.0f / width, 1.0f / (height * 2));
+    _atlas->TexUvWhitePixel.y *= 0.5f;
+    for (auto& line : _atlas->TexUvLines)
+    {
+        line.y *= 0.5f;
+        line.w *= 0.5f;
+    }
+    for (ImFont* font : _atlas->Fonts)
+    {
+        for (auto& glyph : font->Glyphs)
+        {
+            glyph.V0 *= 0.5f;
+            glyph.V1 *= 0.5f;
+        }
+    }
+    _mark_dirty(0, height * 2);
+    return true;
+}
+
+void GlyphAtlas::_mark_dirty(int y, int height)
+{
+    if (_dirty_end <= _dirty_begin)
+    {
+        _dirty_begin = y;
+        _dirty_end = y + height;
+        return;
+    }
+    _dirty_begin = std::min(_dirty_begin, y);
+    _dirty_end = std::max(_dirty_end, y + height);
+}
+
+} // imgui_editor
@@ -0,0 +1,103 @@
+#ifndef IMPLUGINGUI_GLYPH_ATLAS_H
+#define IMPLUGINGUI_GLYPH_ATLAS_H
+
+#include <memory>
+#include <vector>
+
+#include "imgui.h"
+
+namespace imgui_editor {
+
+/* Rasterizes glyphs into the ImGui font atlas the first time they are drawn,
+ * instead of every glyph of every configured range when the atlas is built.
+ * Fonts are added with only the glyphs that are always needed, ASCII for
+ * example, and the ranges to load on demand are given here. Glyphs are packed
+ * into the free space below the built atlas, which grows by doubling its height
+ * when full, and only the rows that changed are uploaded again.
+ * Only text passed to use() loads glyphs, text drawn through TextCache does so
+ * automatically. Must be used from the thread owning the ImGui context */
+class GlyphAtlas
+{
+public:
+    GlyphAtlas();
+
+    ~GlyphAtlas();
+
+    /* Load glyphs of font in ranges on demand, ranges is a zero terminated list
+     * of pairs as for ImFontConfig::GlyphRanges and must stay valid. Call after
+     * adding the font and before the atlas is built */
+    void add(ImFont* font, const ImWchar* ranges);
+
+    /* Forget all fonts, call before destroying the ImGui context */
+    void clear();
+
+    /* Adds the glyphs of text that font doesn't have yet. Glyphs that fit in
+     * the atlas are usable right away, the others once the atlas has grown in
+     * the next new_frame() and are drawn as the fallback glyph until then */
+    void use(ImFont* font, const char* text, const char* text_end = nullptr);
+
+    /* Call before ImGui::NewFrame(), builds the atlas if needed and adds the
+     * glyphs that had to wait, growing the atlas if they don't fit. Returns true
+     * if glyphs were added or the atlas grew, text laid out before then shows
+     * the fallback glyph or uses stale texture coordinates */
+    bool new_frame();
+
+    /* The rows of the atlas changed since the last call, the whole atlas if
+     * it grew. False if nothing changed */
+    bool take_dirty_rows(int& y, int& height);
+
+    /* Glyphs rasterized on demand, for statistics */
+    int glyphs() const
+    {
+        return _glyphs;
+    }
+
+    float rasterize_ms() const
+    {
+        return _rasterize_ms;
+    }
+
+private:
+    enum class Result
+    {
+        ADDED,
+        MISSING,
+        NO_ROOM
+    };
+
+    /* Font file and glyphs of a font, defined with the private copy of stb_truetype */
+    struct Font;
+
+    struct Shelf
+    {
+        int y;
+        int height;
+        int x;
+    };
+
+    bool _init();
+
+    Font* _find(ImFont* font);
+
+    Result _rasterize(Font& font, ImWchar c);
+
+    bool _allocate(int width, int height, int& x, int& y);
+
+    bool _grow();
+
+    void _mark_dirty(int y, int height);
+
+    std::vector<std::unique_ptr<Font>> _fonts;
+    std::vector<Shelf> _shelves;
+    std::vector<unsigned char> _bitmap;
+    ImFontAtlas*  _atlas{nullptr};
+    unsigned int* _pixels{nullptr};   // To notice when the atlas is rebuilt
+    int   _shelves_end{0};
+    int   _dirty_begin{0};
+    int   _dirty_end{0};
+    int   _glyphs{0};
+    float _rasterize_ms{0};
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_GLYPH_ATLAS_H
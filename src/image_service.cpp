@@ -0,0 +1,304 @@
+#include <iostream>
+
+#ifdef WITH_LIBPNG
+#include <png.h>
+#endif
+
+#include "asset_pack.h"
+#include "image_service.h"
+#include "imgui_impl_opengl3.h"
+#include "imgui_impl_soft.h"
+
+namespace imgui_editor {
+
+constexpr size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+/* Spread uploads of large batches of images over several frames, at least one
+ * image is always uploaded per frame */
+constexpr size_t MAX_UPLOAD_BYTES_PER_FRAME = 4 * 1024 * 1024;
+constexpr uint32_t PLACEHOLDER_COLOUR = 0x40808080;
+
+std::atomic<size_t> ImageService::_memory_budget = DEFAULT_MEMORY_BUDGET;
+std::atomic<size_t> ImageService::_memory_used = 0;
+
+bool decode_png(const std::string& path, std::vector<uint8_t>& pixels, int& width, int& height)
+{
+#ifdef WITH_LIBPNG
+    png_image image{};
+    image.version = PNG_IMAGE_VERSION;
+    if (png_image_begin_read_from_file(&image, path.c_str()) == 0)
+    {
+        std::cerr << "Failed to read " << path << ": " << image.message << std::endl;
+        return false;
+    }
+    image.format = PNG_FORMAT_RGBA;
+    pixels.resize(PNG_IMAGE_SIZE(image));
+    if (png_image_finish_read(&image, nullptr, pixels.data(), 0, nullptr) == 0)
+    {
+        std::cerr << "Failed to decode " << path << ": " << image.message << std::endl;
+        png_image_free(&image);
+        return false;
+    }
+    width = static_cast<int>(image.width);
+    height = static_cast<int>(image.height);
+    return true;
+#else
+    (void) pixels;
+    (void) width;
+    (void) height;
+    std::cerr << "Can't load " << path << ", built without libpng" << std::endl;
+    return false;
+#endif
+}
+
+TextureFunctions opengl3_textures()
+{
+    return {ImGui_ImplOpenGL3_CreateTexture, ImGui_ImplOpenGL3_DestroyTexture};
+}
+
+TextureFunctions soft_textures()
+{
+    return {ImGui_ImplSoft_CreateTexture, ImGui_ImplSoft_DestroyTexture};
+}
+
+ImageService::ImageService(ImageDecoder decoder, TextureFunctions textures) : _decoder(std::move(decoder)),
+                                                                              _textures(textures)
+{}
+
+ImageService::~ImageService()
+{
+    {
+        std::scoped_lock<std::mutex> lock(_queue_lock);
+        _running = false;
+    }
+    _queue_notifier.notify_one();
+    if (_worker.joinable())
+    {
+        _worker.join();
+    }
+    /* Textures should have been deleted with clear() while the context was
+     * current, but the budget must be given back regardless */
+    _memory_used -= _cached_bytes;
+}
+
+ImTextureID ImageService::texture(const std::string& path, ImVec2* size)
+{
+    auto entry = _lookup.find(path);
+    if (entry == _lookup.end())
+    {
+        _images.push_front(Image{path});
+        _images.front().last_used = _frame;
+        _lookup[path] = _images.begin();
+        _request(path);
+        return _placeholder;
+    }
+
+    auto image = entry->second;
+    image->last_used = _frame;
+    if (image != _images.begin())
+    {
+        _images.splice(_images.begin(), _images, image);
+    }
+    if (image->state != State::READY)
+    {
+        return _placeholder;
+    }
+    if (size)
+    {
+        *size = ImVec2(static_cast<float>(image->width), static_cast<float>(image->height));
+    }
+    return image->texture;
+}
+
+ImageService::State ImageService::state(const std::string& path) const
+{
+    auto entry = _lookup.find(path);
+    return entry == _lookup.end() ? State::LOADING : entry->second->state;
+}
+
+void ImageService::new_frame()
+{
+    _frame++;
+    if (_placeholder == 0)
+    {
+        _placeholder = _textures.create(&PLACEHOLDER_COLOUR, 1, 1);
+    }
+
+    /* Take finished images one at a time so the worker is never blocked
+     * on the lock for the duration of an upload */
+    size_t uploaded = 0;
+    while (uploaded < MAX_UPLOAD_BYTES_PER_FRAME)
+    {
+        DecodedImage decoded;
+        {
+            std::scoped_lock<std::mutex> lock(_queue_lock);
+            if (_decoded.empty())
+            {
+                break;
+            }
+            decoded = std::move(_decoded.front());
+            _decoded.pop_front();
+        }
+        uploaded += static_cast<size_t>(decoded.width) * decoded.height * 4;
+        _upload(decoded);
+    }
+    _evict();
+}
+
+void ImageService::clear()
+{
+    {
+        std::scoped_lock<std::mutex> lock(_queue_lock);
+        _requests.clear();
+        _decoded.clear();
+    }
+    for (auto& image : _images)
+    {
+        if (image.state == State::READY)
+        {
+            _textures.destroy(image.texture);
+        }
+    }
+    _images.clear();
+    _lookup.clear();
+    _memory_used -= _cached_bytes;
+    _cached_bytes = 0;
+    if (_placeholder != 0)
+    {
+        _textures.destroy(_placeholder);
+        _placeholder = 0;
+    }
+}
+
+int ImageService::pending() const
+{
+    int count = 0;
+    for (const auto& image : _images)
+    {
+        count += image.state == State::LOADING ? 1 : 0;
+    }
+    return count;
+}
+
+int ImageService::cached() const
+{
+    int count = 0;
+    for (const auto& image : _images)
+    {
+        count += image.state == State::READY ? 1 : 0;
+    }
+    return count;
+}
+
+void ImageService::set_memory_budget(size_t bytes)
+{
+    _memory_budget = bytes;
+}
+
+size_t ImageService::memory_budget()
+{
+    return _memory_budget;
+}
+
+size_t ImageService::memory_used()
+{
+    return _memory_used;
+}
+
+void ImageService::_worker_loop()
+{
+    while (true)
+    {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(_queue_lock);
+            _queue_notifier.wait(lock, [this] {return !_requests.empty() || !_running;});
+            if (!_running)
+            {
+                return;
+            }
+            path = std::move(_requests.front());
+            _requests.pop_front();
+        }
+
+        DecodedImage decoded{path, false, {}, 0, 0};
+        decoded.success = _decoder(path, decoded.pixels, decoded.width, decoded.height);
+
+        std::scoped_lock<std::mutex> lock(_queue_lock);
+        _decoded.push_back(std::move(decoded));
+    }
+}
+
+void ImageService::_request(const std::string& path)
+{
+    /* Images in the asset pack are already decoded, so they skip the worker */
+    Asset asset;
+    const AssetPack* pack = AssetPack::process();
+    if (pack != nullptr && pack->find(path, asset) && asset.type == AssetType::IMAGE_RGBA)
+    {
+        std::scoped_lock<std::mutex> lock(_queue_lock);
+        _decoded.push_back({path, true, {}, asset.width, asset.height, asset.data});
+        return;
+    }
+    /* The worker is started on first use, so editors without
+     * any images don't have an extra thread hanging around */
+    if (!_worker.joinable())
+    {
+        _worker = std::thread(&ImageService::_worker_loop, this);
+    }
+    {
+        std::scoped_lock<std::mutex> lock(_queue_lock);
+        _requests.push_back(path);
+    }
+    _queue_notifier.notify_one();
+}
+
+void ImageService::_upload(DecodedImage& decoded)
+{
+    auto entry = _lookup.find(decoded.path);
+    if (entry == _lookup.end() || entry->second->state != State::LOADING)
+    {
+        /* Cleared while it was being decoded */
+        return;
+    }
+    Image& image = *entry->second;
+    if (!decoded.success || decoded.width <= 0 || decoded.height <= 0)
+    {
+        image.state = State::FAILED;
+        return;
+    }
+    const uint8_t* pixels = decoded.mapped ? decoded.mapped : decoded.pixels.data();
+    image.texture = _textures.create(pixels, decoded.width, decoded.height);
+    image.width = decoded.width;
+    image.height = decoded.height;
+    image.bytes = static_cast<size_t>(decoded.width) * decoded.height * 4;
+    image.state = State::READY;
+    _cached_bytes += image.bytes;
+    _memory_used += image.bytes;
+}
+
+void ImageService::_evict()
+{
+    /* Walk from the least recently used end and stop at the first
+     * image that was drawn in the last frame, as all images before
+     * that one in the list have been used more recently */
+    auto image = _images.end();
+    while (_memory_used > _memory_budget && image != _images.begin())
+    {
+        --image;
+        if (image->last_used + 1 >= _frame)
+        {
+            break;
+        }
+        if (image->state != State::READY)
+        {
+            continue;
+        }
+        _textures.destroy(image->texture);
+        _cached_bytes -= image->bytes;
+        _memory_used -= image->bytes;
+        _lookup.erase(image->path);
+        image = _images.erase(image);
+    }
+}
+
+} // imgui_editor
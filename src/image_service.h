@@ -0,0 +1,152 @@
+#ifndef IMPLUGINGUI_IMAGE_SERVICE_H
+#define IMPLUGINGUI_IMAGE_SERVICE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "imgui.h"
+
+namespace imgui_editor {
+
+/* Decodes the image file at path to 8 bit RGBA pixels, returns false on failure */
+using ImageDecoder = std::function<bool(const std::string& path, std::vector<uint8_t>& pixels, int& width, int& height)>;
+
+/* Decodes PNG files with libpng if the library was built with it, otherwise always fails */
+bool decode_png(const std::string& path, std::vector<uint8_t>& pixels, int& width, int& height);
+
+/* Creates and deletes textures with a renderer backend, pixels are 8 bit RGBA */
+struct TextureFunctions
+{
+    ImTextureID (*create)(const void* pixels, int width, int height);
+    void        (*destroy)(ImTextureID texture);
+};
+
+/* The OpenGL3 backend's textures */
+TextureFunctions opengl3_textures();
+
+/* The software renderer's textures */
+TextureFunctions soft_textures();
+
+/* Loads skin images in the background and keeps them as textures for one editor.
+ * Images are decoded on a worker thread and uploaded from the draw thread in
+ * new_frame(), texture() returns a placeholder until the image is ready, so
+ * opening an editor never stalls on image loading.
+ * Images found by path in the process's asset pack are uploaded straight from
+ * the pack, without decoding or copying them.
+ * Textures are kept in a least recently used cache. The memory budget is shared
+ * between all instances in the process, and when the total is over budget each
+ * instance evicts its own textures that were not used in the last frame, oldest
+ * first. An evicted image is loaded again the next time it is asked for.
+ * Except for the constructor and the static functions, all functions must be
+ * called from the draw thread with the editor's GL context current, if the
+ * textures are the OpenGL3 backend's */
+class ImageService
+{
+public:
+    enum class State
+    {
+        LOADING,
+        READY,
+        FAILED
+    };
+
+    explicit ImageService(ImageDecoder decoder = decode_png, TextureFunctions textures = opengl3_textures());
+
+    ~ImageService();
+
+    /* Returns the texture for the image at path, or a placeholder texture while
+     * it is loading or if it failed to load. size is set to the size of the image
+     * once it's ready and left untouched otherwise */
+    ImTextureID texture(const std::string& path, ImVec2* size = nullptr);
+
+    State state(const std::string& path) const;
+
+    /* Uploads decoded images and evicts textures if over budget, call once per
+     * frame before any calls to texture() */
+    void new_frame();
+
+    /* Deletes all textures, call before the GL context is destroyed */
+    void clear();
+
+    int pending() const;
+
+    int cached() const;
+
+    size_t cached_bytes() const
+    {
+        return _cached_bytes;
+    }
+
+    /* Texture memory budget shared by all instances, in bytes */
+    static void set_memory_budget(size_t bytes);
+
+    static size_t memory_budget();
+
+    /* Texture memory used by all instances, in bytes */
+    static size_t memory_used();
+
+private:
+    struct Image
+    {
+        std::string path;
+        State       state{State::LOADING};
+        ImTextureID texture{0};
+        int         width{0};
+        int         height{0};
+        size_t      bytes{0};
+        uint64_t    last_used{0};
+    };
+
+    struct DecodedImage
+    {
+        std::string          path;
+        bool                 success;
+        std::vector<uint8_t> pixels;
+        int                  width;
+        int                  height;
+        const uint8_t*       mapped{nullptr};   // Pixels in the asset pack, used instead of pixels
+    };
+
+    using ImageList = std::list<Image>;
+
+    void _worker_loop();
+
+    void _request(const std::string& path);
+
+    void _upload(DecodedImage& decoded);
+
+    void _evict();
+
+    ImageDecoder       _decoder;
+    TextureFunctions   _textures;
+
+    /* Most recently used first */
+    ImageList          _images;
+    std::unordered_map<std::string, ImageList::iterator> _lookup;
+    ImTextureID        _placeholder{0};
+    uint64_t           _frame{0};
+    size_t             _cached_bytes{0};
+
+    /* Shared with the worker thread */
+    mutable std::mutex        _queue_lock;
+    std::condition_variable   _queue_notifier;
+    std::deque<std::string>   _requests;
+    std::deque<DecodedImage>  _decoded;
+    bool                      _running{true};
+    std::thread               _worker;
+
+    static std::atomic<size_t> _memory_budget;
+    static std::atomic<size_t> _memory_used;
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_IMAGE_SERVICE_H
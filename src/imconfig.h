@@ -19,3 +19,60 @@ extern thread_local ImGuiContext* MyImGuiTLS;
 
 /* Starting fresh, don't want to keep any legacy crap around */
 #define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
+
+/* Compact 12 byte vertices instead of Dear ImGui's 20 bytes, enabled with the
+ * COMPACT_VERTICES cmake option. Positions are stored in signed 12.4 fixed point,
+ * -2048 to 2048 pixels in steps of 1/16 pixel, and texture coordinates in unsigned
+ * 2.14 fixed point, 0 to 4 as the ring textures wrap past 1. Colours are packed as usual.
+ * Dear ImGui writes vertices both as whole ImVec2s and one float component at a
+ * time (vtx->pos.x = x), so components convert to and from float on access.
+ * Coordinates outside the range are clamped, which distorts shapes that reach
+ * further than 2048 pixels from the window origin */
+#ifdef VSTIMGUI_COMPACT_VERTICES
+#define VSTIMGUI_VERTEX_POS_ONE 16
+#define VSTIMGUI_VERTEX_UV_ONE  16384
+
+template <typename T, int ONE, int MIN, int MAX>
+struct ImDrawVertFixed
+{
+    T raw;
+
+    ImDrawVertFixed& operator=(float value)
+    {
+        float scaled = value * ONE;
+        scaled = scaled > MAX ? MAX : (scaled >= MIN ? scaled : MIN);
+        raw = static_cast<T>(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+        return *this;
+    }
+
+    operator float() const
+    {
+        return static_cast<float>(raw) * (1.0f / ONE);
+    }
+
+    ImDrawVertFixed& operator+=(float value) { return *this = *this + value; }
+    ImDrawVertFixed& operator-=(float value) { return *this = *this - value; }
+    ImDrawVertFixed& operator*=(float value) { return *this = *this * value; }
+};
+
+/* Member functions using ImVec2 are defined with ImDrawVert itself, below ImVec2 in imgui.h */
+struct ImVec2;
+template <typename COMPONENT>
+struct ImDrawVertFixed2
+{
+    COMPONENT x, y;
+
+    ImDrawVertFixed2& operator=(const ImVec2& value);
+    operator ImVec2() const;
+};
+
+using ImDrawVertPos = ImDrawVertFixed2<ImDrawVertFixed<short, VSTIMGUI_VERTEX_POS_ONE, -32768, 32767>>;
+using ImDrawVertUV = ImDrawVertFixed2<ImDrawVertFixed<unsigned short, VSTIMGUI_VERTEX_UV_ONE, 0, 65535>>;
+
+#define IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT \
+    template <typename COMPONENT> inline ImDrawVertFixed2<COMPONENT>& ImDrawVertFixed2<COMPONENT>::operator=(const ImVec2& value) \
+    { x = value.x; y = value.y; return *this; } \
+    template <typename COMPONENT> inline ImDrawVertFixed2<COMPONENT>::operator ImVec2() const \
+    { return ImVec2(x, y); } \
+    struct ImDrawVert { ImDrawVertPos pos; ImDrawVertUV uv; ImU32 col; }
+#endif
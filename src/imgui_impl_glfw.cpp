@@ -3,6 +3,9 @@
  * * Uses thread local storage for each editor window and it glfw backend context
  * * Don't chain callbacks, the first window installs callbacks, the last window to close uninstalls them
  * * All threading and synchronization is the responsibility of the caller
+ * * Input is recorded by callbacks into a timestamped, lock-free event queue per window and applied in order in
+ *   NewFrame(). The callbacks may run on another thread that dispatches events for all windows, but not at the same
+ *   time as Init() or Shutdown() for the same window
  *
  */
 
@@ -23,6 +26,11 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  vstimgui: Inputs: Mouse position and buttons come from callbacks through a timestamped event queue instead of being polled each frame.
+//  vstimgui: Inputs: Added ImGui_ImplGlfw_FramePresented() and ImGui_ImplGlfw_GetInputStats() for input to present latency.
+//  vstimgui: Inputs: The input event queue is a lock-free single producer, single consumer ring. Added ImGui_ImplGlfw_WaitForEvents().
+//  vstimgui: Misc: Added ImGui_ImplGlfw_GetMemoryUsage().
+//  vstimgui: Misc: Window and framebuffer sizes are cached from callbacks, the OS cursor is only set when it changes. Added ImGui_ImplGlfw_GetFrameStats() to count window system requests.
 //  2020-01-17: Inputs: Disable error callback while assigning mouse cursors because some X11 setup don't have them and it generates errors.
 //  2019-12-05: Inputs: Added support for new mouse cursors added in GLFW 3.4+ (resizing cursors, not allowed cursor).
 //  2019-10-18: Misc: Previously installed user callbacks are now restored on shutdown.
@@ -47,6 +55,10 @@
 
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
+#include <float.h>      // FLT_MAX
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 // GLFW
 #include <GLFW/glfw3.h>
@@ -74,65 +86,179 @@ enum GlfwClientApi
     GlfwClientApi_Vulkan
 };
 
+enum GlfwInputEventType
+{
+    GlfwInputEventType_MousePos,
+    GlfwInputEventType_MouseLeave,
+    GlfwInputEventType_MouseButton,
+    GlfwInputEventType_Scroll,
+    GlfwInputEventType_Key,
+    GlfwInputEventType_Char
+};
+
+struct GlfwInputEvent
+{
+    GlfwInputEventType  Type;
+    double              Time;       // glfwGetTime() when the callback was called
+    float               X, Y;       // MousePos, Scroll
+    int                 Code;       // MouseButton, Key, Char
+    bool                Down;       // MouseButton, Key
+};
+
+// Enough for a few frames worth of events even when the mouse is moved fast
+static constexpr unsigned int INPUT_QUEUE_SIZE = 256;
+
 /* This is the entire GLFW backend state, one per open editor window */
 struct GLFWImplContext
 {
     GLFWwindow*     g_Window{nullptr};
     GlfwClientApi   g_ClientApi{GlfwClientApi_Unknown};
     double          g_Time{0.0};
-    bool            g_MouseJustPressed[5]{false};
     GLFWcursor*     g_MouseCursors[ImGuiMouseCursor_COUNT]{nullptr};
+    bool            g_InstalledCallbacks{false};
+
+    // Last cursor set on the window, so it's only changed when ImGui asks for a different one
+    ImGuiMouseCursor g_LastMouseCursor{ImGuiMouseCursor_COUNT};
+    bool            g_CursorHidden{false};
+    bool            g_GamepadEnabled{false};
+
+    // Written by the callbacks on the thread dispatching events, read by the thread drawing the window
+    GlfwInputEvent  g_InputQueue[INPUT_QUEUE_SIZE];
+    alignas(64) std::atomic<unsigned int> g_InputWritePos{0};
+    alignas(64) std::atomic<unsigned int> g_InputReadPos{0};
+    std::atomic<int> g_InputDropped{0};
+    std::atomic<int> g_WindowWidth{0}, g_WindowHeight{0};
+    std::atomic<int> g_FramebufferWidth{0}, g_FramebufferHeight{0};
+
+    // Only used to sleep in ImGui_ImplGlfw_WaitForEvents(), the queue itself doesn't take a lock
+    std::mutex      g_WaitMutex;
+    std::condition_variable g_WaitCondition;
+    std::atomic<bool> g_Waiting{false};
+    std::atomic<bool> g_Resized{false};
+
+    // Calls into GLFW that make a request to the window system, can be counted from any thread
+    std::atomic<int> g_ServerRequests{0};
+    ImGui_ImplGlfw_FrameStats g_FrameStats{};
+
+    // Oldest input event applied in the current frame, 0 if none
+    double          g_OldestInputTime{0.0};
+    ImGui_ImplGlfw_InputStats g_InputStats{};
 };
 
 thread_local static GLFWImplContext* _impl_ctx = nullptr;
 
+// Callbacks find their context through the window user pointer rather than _impl_ctx, as events can be dispatched
+// for all windows from one thread.
+static GLFWImplContext* ImGui_ImplGlfw_GetContext(GLFWwindow* window)
+{
+    return (GLFWImplContext*)glfwGetWindowUserPointer(window);
+}
+
+static void ImGui_ImplGlfw_WakeUp(GLFWImplContext* state)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (state->g_Waiting)
+    {
+        std::scoped_lock<std::mutex> lock(state->g_WaitMutex);
+        state->g_WaitCondition.notify_one();
+    }
+}
+
+static void ImGui_ImplGlfw_QueueEvent(GLFWwindow* window, const GlfwInputEvent& event, int server_requests = 0)
+{
+    GLFWImplContext* state = ImGui_ImplGlfw_GetContext(window);
+    if (state == nullptr)
+        return;
+    state->g_ServerRequests += server_requests;
+    unsigned int write_pos = state->g_InputWritePos.load(std::memory_order_relaxed);
+    if (write_pos - state->g_InputReadPos.load(std::memory_order_acquire) >= INPUT_QUEUE_SIZE)
+    {
+        state->g_InputDropped++;
+        return;
+    }
+    GlfwInputEvent& queued = state->g_InputQueue[write_pos % INPUT_QUEUE_SIZE];
+    queued = event;
+    queued.Time = glfwGetTime();
+    state->g_InputWritePos.store(write_pos + 1, std::memory_order_release);
+    ImGui_ImplGlfw_WakeUp(state);
+}
+
 static const char* ImGui_ImplGlfw_GetClipboardText(void* user_data)
 {
+    _impl_ctx->g_ServerRequests++;
     return glfwGetClipboardString((GLFWwindow*)user_data);
 }
 
 static void ImGui_ImplGlfw_SetClipboardText(void* user_data, const char* text)
 {
+    _impl_ctx->g_ServerRequests++;
     glfwSetClipboardString((GLFWwindow*)user_data, text);
 }
 
-void ImGui_ImplGlfw_MouseButtonCallback([[maybe_unused]] GLFWwindow* window, int button, int action, [[maybe_unused]] int mods)
+void ImGui_ImplGlfw_MouseButtonCallback(GLFWwindow* window, int button, int action, [[maybe_unused]] int mods)
 {
-    GLFWImplContext* state = _impl_ctx;
-    if (action == GLFW_PRESS && button >= 0 && button < IM_ARRAYSIZE(state->g_MouseJustPressed))
-        state->g_MouseJustPressed[button] = true;
+    if (button < 0 || button >= IM_ARRAYSIZE(ImGuiIO::MouseDown) || action == GLFW_REPEAT)
+        return;
+    ImGui_ImplGlfw_QueueEvent(window, {GlfwInputEventType_MouseButton, 0.0, 0.0f, 0.0f, button, action == GLFW_PRESS});
 }
 
-void ImGui_ImplGlfw_ScrollCallback([[maybe_unused]] GLFWwindow* window, double xoffset, double yoffset)
+void ImGui_ImplGlfw_CursorPosCallback(GLFWwindow* window, double x, double y)
 {
-    ImGuiIO& io = ImGui::GetIO();
-    io.MouseWheelH += (float)xoffset;
-    io.MouseWheel += (float)yoffset;
+    ImGui_ImplGlfw_QueueEvent(window, {GlfwInputEventType_MousePos, 0.0, (float)x, (float)y, 0, false});
 }
 
-void ImGui_ImplGlfw_KeyCallback([[maybe_unused]] GLFWwindow* window, int key, [[maybe_unused]] int scancode, int action, [[maybe_unused]] int mods)
+void ImGui_ImplGlfw_CursorEnterCallback(GLFWwindow* window, int entered)
 {
-    ImGuiIO& io = ImGui::GetIO();
-    if (action == GLFW_PRESS)
-        io.KeysDown[key] = true;
-    if (action == GLFW_RELEASE)
-        io.KeysDown[key] = false;
+    if (entered)
+    {
+        // Position is only reported on the next motion, pick it up right away so hovering works without moving
+        double x, y;
+        glfwGetCursorPos(window, &x, &y);
+        ImGui_ImplGlfw_QueueEvent(window, {GlfwInputEventType_MousePos, 0.0, (float)x, (float)y, 0, false}, 1);
+    }
+    else
+    {
+        ImGui_ImplGlfw_QueueEvent(window, {GlfwInputEventType_MouseLeave, 0.0, 0.0f, 0.0f, 0, false});
+    }
+}
 
-    // Modifiers are not reliable across systems
-    io.KeyCtrl = io.KeysDown[GLFW_KEY_LEFT_CONTROL] || io.KeysDown[GLFW_KEY_RIGHT_CONTROL];
-    io.KeyShift = io.KeysDown[GLFW_KEY_LEFT_SHIFT] || io.KeysDown[GLFW_KEY_RIGHT_SHIFT];
-    io.KeyAlt = io.KeysDown[GLFW_KEY_LEFT_ALT] || io.KeysDown[GLFW_KEY_RIGHT_ALT];
-#ifdef _WIN32
-    io.KeySuper = false;
-#else
-    io.KeySuper = io.KeysDown[GLFW_KEY_LEFT_SUPER] || io.KeysDown[GLFW_KEY_RIGHT_SUPER];
-#endif
+void ImGui_ImplGlfw_ScrollCallback(GLFWwindow* window, double xoffset, double yoffset)
+{
+    ImGui_ImplGlfw_QueueEvent(window, {GlfwInputEventType_Scroll, 0.0, (float)xoffset, (float)yoffset, 0, false});
 }
 
-void ImGui_ImplGlfw_CharCallback([[maybe_unused]] GLFWwindow* window, unsigned int c)
+void ImGui_ImplGlfw_KeyCallback(GLFWwindow* window, int key, [[maybe_unused]] int scancode, int action, [[maybe_unused]] int mods)
 {
-    ImGuiIO& io = ImGui::GetIO();
-    io.AddInputCharacter(c);
+    if (key < 0 || key >= IM_ARRAYSIZE(ImGuiIO::KeysDown) || action == GLFW_REPEAT)
+        return;
+    ImGui_ImplGlfw_QueueEvent(window, {GlfwInputEventType_Key, 0.0, 0.0f, 0.0f, key, action == GLFW_PRESS});
+}
+
+void ImGui_ImplGlfw_CharCallback(GLFWwindow* window, unsigned int c)
+{
+    ImGui_ImplGlfw_QueueEvent(window, {GlfwInputEventType_Char, 0.0, 0.0f, 0.0f, (int)c, false});
+}
+
+void ImGui_ImplGlfw_WindowSizeCallback(GLFWwindow* window, int width, int height)
+{
+    if (GLFWImplContext* state = ImGui_ImplGlfw_GetContext(window))
+    {
+        state->g_WindowWidth = width;
+        state->g_WindowHeight = height;
+        state->g_Resized = true;
+        ImGui_ImplGlfw_WakeUp(state);
+    }
+}
+
+void ImGui_ImplGlfw_FramebufferSizeCallback(GLFWwindow* window, int width, int height)
+{
+    if (GLFWImplContext* state = ImGui_ImplGlfw_GetContext(window))
+    {
+        state->g_FramebufferWidth = width;
+        state->g_FramebufferHeight = height;
+        state->g_Resized = true;
+        ImGui_ImplGlfw_WakeUp(state);
+    }
 }
 
 static bool ImGui_ImplGlfw_Init([[maybe_unused]] GLFWwindow* window, bool install_callbacks, GlfwClientApi client_api)
@@ -203,9 +329,23 @@ static bool ImGui_ImplGlfw_Init([[maybe_unused]] GLFWwindow* window, bool instal
 #endif
     glfwSetErrorCallback(prev_error_callback);
 
+    // Sizes are queried once here, after that they are only updated by the callbacks
+    int w, h;
+    glfwGetWindowSize(window, &w, &h);
+    state->g_WindowWidth = w;
+    state->g_WindowHeight = h;
+    glfwGetFramebufferSize(window, &w, &h);
+    state->g_FramebufferWidth = w;
+    state->g_FramebufferHeight = h;
+    glfwSetWindowUserPointer(window, state);
+    state->g_InstalledCallbacks = install_callbacks;
     if (install_callbacks)
     {
+        glfwSetWindowSizeCallback(window, ImGui_ImplGlfw_WindowSizeCallback);
+        glfwSetFramebufferSizeCallback(window, ImGui_ImplGlfw_FramebufferSizeCallback);
         glfwSetMouseButtonCallback(window, ImGui_ImplGlfw_MouseButtonCallback);
+        glfwSetCursorPosCallback(window, ImGui_ImplGlfw_CursorPosCallback);
+        glfwSetCursorEnterCallback(window, ImGui_ImplGlfw_CursorEnterCallback);
         glfwSetScrollCallback(window, ImGui_ImplGlfw_ScrollCallback);
         glfwSetKeyCallback(window, ImGui_ImplGlfw_KeyCallback);
         glfwSetCharCallback(window, ImGui_ImplGlfw_CharCallback);
@@ -228,9 +368,15 @@ bool ImGui_ImplGlfw_InitForVulkan(GLFWwindow* window, bool install_callbacks)
 void ImGui_ImplGlfw_Shutdown(bool remove_callbacks)
 {
     GLFWImplContext* state = _impl_ctx;
+    // After this no callback can reach the context, even if the window stays alive and another thread dispatches events
+    glfwSetWindowUserPointer(state->g_Window, nullptr);
     if (remove_callbacks)
     {
+        glfwSetWindowSizeCallback(state->g_Window, nullptr);
+        glfwSetFramebufferSizeCallback(state->g_Window, nullptr);
         glfwSetMouseButtonCallback(state->g_Window, nullptr);
+        glfwSetCursorPosCallback(state->g_Window, nullptr);
+        glfwSetCursorEnterCallback(state->g_Window, nullptr);
         glfwSetScrollCallback(state->g_Window, nullptr);
         glfwSetKeyCallback(state->g_Window, nullptr);
         glfwSetCharCallback(state->g_Window, nullptr);
@@ -243,43 +389,88 @@ void ImGui_ImplGlfw_Shutdown(bool remove_callbacks)
     }
     state->g_ClientApi = GlfwClientApi_Unknown;
     delete _impl_ctx;
+    _impl_ctx = nullptr;
 }
 
-static void ImGui_ImplGlfw_UpdateMousePosAndButtons()
+// Apply queued input events in the order they came. ImGui only sees one state per frame, so the queue is trickled:
+// a second change of the same button or key, or mouse movement after a button change, is left for the next frame.
+// That way a click shorter than a frame is still seen as pressed for one frame and released the next, and at the
+// position where it happened.
+static void ImGui_ImplGlfw_UpdateInputEvents()
 {
-    // Update buttons
     ImGuiIO& io = ImGui::GetIO();
     GLFWImplContext* state = _impl_ctx;
-
-    for (int i = 0; i < IM_ARRAYSIZE(io.MouseDown); i++)
+    unsigned int read_pos = state->g_InputReadPos.load(std::memory_order_relaxed);
+    unsigned int write_pos = state->g_InputWritePos.load(std::memory_order_acquire);
+
+    bool buttons_changed[IM_ARRAYSIZE(io.MouseDown)] = {};
+    bool any_button_changed = false;
+    bool keys_changed = false;
+    int applied = 0;
+    state->g_OldestInputTime = 0.0;
+    for (; read_pos + applied != write_pos; applied++)
     {
-        // If a mouse press event came, always pass it as "mouse held this frame", so we don't miss click-release events that are shorter than 1 frame.
-        io.MouseDown[i] = state->g_MouseJustPressed[i] || glfwGetMouseButton(state->g_Window, i) != 0;
-        state->g_MouseJustPressed[i] = false;
+        const GlfwInputEvent& event = state->g_InputQueue[(read_pos + applied) % INPUT_QUEUE_SIZE];
+        bool defer = false;
+        switch (event.Type)
+        {
+            case GlfwInputEventType_MousePos:
+                if (any_button_changed) { defer = true; break; }
+                io.MousePos = ImVec2(event.X, event.Y);
+                break;
+            case GlfwInputEventType_MouseLeave:
+                if (any_button_changed) { defer = true; break; }
+                io.MousePos = ImVec2(-FLT_MAX, -FLT_MAX);
+                break;
+            case GlfwInputEventType_MouseButton:
+                if (buttons_changed[event.Code]) { defer = true; break; }
+                buttons_changed[event.Code] = io.MouseDown[event.Code] != event.Down;
+                any_button_changed |= buttons_changed[event.Code];
+                io.MouseDown[event.Code] = event.Down;
+                break;
+            case GlfwInputEventType_Scroll:
+                io.MouseWheelH += event.X;
+                io.MouseWheel += event.Y;
+                break;
+            case GlfwInputEventType_Key:
+                if (keys_changed && io.KeysDown[event.Code] != event.Down) { defer = true; break; }
+                keys_changed |= io.KeysDown[event.Code] != event.Down;
+                io.KeysDown[event.Code] = event.Down;
+                break;
+            case GlfwInputEventType_Char:
+                io.AddInputCharacter((unsigned int)event.Code);
+                break;
+        }
+        if (defer)
+            break;
+        if (state->g_OldestInputTime == 0.0)
+            state->g_OldestInputTime = event.Time;
     }
+    state->g_InputReadPos.store(read_pos + applied, std::memory_order_release);
+    state->g_InputStats.EventsApplied = applied;
+    state->g_InputStats.EventsDeferred = (int)(write_pos - read_pos) - applied;
+    state->g_InputStats.EventsDropped = state->g_InputDropped;
 
-    // Update mouse position
-    const ImVec2 mouse_pos_backup = io.MousePos;
-    io.MousePos = ImVec2(-FLT_MAX, -FLT_MAX);
-#ifdef __EMSCRIPTEN__
-    const bool focused = true; // Emscripten
+    // Modifiers are not reliable across systems
+    io.KeyCtrl = io.KeysDown[GLFW_KEY_LEFT_CONTROL] || io.KeysDown[GLFW_KEY_RIGHT_CONTROL];
+    io.KeyShift = io.KeysDown[GLFW_KEY_LEFT_SHIFT] || io.KeysDown[GLFW_KEY_RIGHT_SHIFT];
+    io.KeyAlt = io.KeysDown[GLFW_KEY_LEFT_ALT] || io.KeysDown[GLFW_KEY_RIGHT_ALT];
+#ifdef _WIN32
+    io.KeySuper = false;
 #else
-    /* A plugin window is docked as a child window and doesn't neccesarily
-       get focused, Mouse could still be valid though */
-    const bool focused = true;// glfwGetWindowAttrib(state->g_Window, GLFW_FOCUSED) != 0;
+    io.KeySuper = io.KeysDown[GLFW_KEY_LEFT_SUPER] || io.KeysDown[GLFW_KEY_RIGHT_SUPER];
 #endif
-    if (focused)
+}
+
+static void ImGui_ImplGlfw_UpdateMousePos()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    GLFWImplContext* state = _impl_ctx;
+    // The position itself comes from the cursor callbacks, only navigation requests are handled here
+    if (io.WantSetMousePos)
     {
-        if (io.WantSetMousePos)
-        {
-            glfwSetCursorPos(state->g_Window, (double)mouse_pos_backup.x, (double)mouse_pos_backup.y);
-        }
-        else
-        {
-            double mouse_x, mouse_y;
-            glfwGetCursorPos(state->g_Window, &mouse_x, &mouse_y);
-            io.MousePos = ImVec2((float)mouse_x, (float)mouse_y);
-        }
+        glfwSetCursorPos(state->g_Window, (double)io.MousePos.x, (double)io.MousePos.y);
+        state->g_ServerRequests++;
     }
 }
 
@@ -291,28 +482,57 @@ static void ImGui_ImplGlfw_UpdateMouseCursor()
     if ((io.ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange) || glfwGetInputMode(state->g_Window, GLFW_CURSOR) == GLFW_CURSOR_DISABLED)
         return;
 
+    // glfwGetInputMode() only reads GLFW's own state, while setting the cursor or input mode are window system requests.
+    // These are only made when the cursor changes.
     ImGuiMouseCursor imgui_cursor = ImGui::GetMouseCursor();
     if (imgui_cursor == ImGuiMouseCursor_None || io.MouseDrawCursor)
     {
         // Hide OS mouse cursor if imgui is drawing it or if it wants no cursor
-        glfwSetInputMode(state->g_Window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
+        if (!state->g_CursorHidden)
+        {
+            glfwSetInputMode(state->g_Window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
+            state->g_ServerRequests++;
+            state->g_CursorHidden = true;
+        }
     }
     else
     {
         // Show OS mouse cursor
         // FIXME-PLATFORM: Unfocused windows seems to fail changing the mouse cursor with GLFW 3.2, but 3.3 works here.
-        glfwSetCursor(state->g_Window, state->g_MouseCursors[imgui_cursor] ? state->g_MouseCursors[imgui_cursor] : state->g_MouseCursors[ImGuiMouseCursor_Arrow]);
-        glfwSetInputMode(state->g_Window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+        if (imgui_cursor != state->g_LastMouseCursor)
+        {
+            glfwSetCursor(state->g_Window, state->g_MouseCursors[imgui_cursor] ? state->g_MouseCursors[imgui_cursor] : state->g_MouseCursors[ImGuiMouseCursor_Arrow]);
+            state->g_ServerRequests++;
+            state->g_LastMouseCursor = imgui_cursor;
+        }
+        if (state->g_CursorHidden)
+        {
+            glfwSetInputMode(state->g_Window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+            state->g_ServerRequests++;
+            state->g_CursorHidden = false;
+        }
     }
 }
 
 static void ImGui_ImplGlfw_UpdateGamepads()
 {
     ImGuiIO& io = ImGui::GetIO();
+    GLFWImplContext* state = _impl_ctx;
 
-    memset(io.NavInputs, 0, sizeof(io.NavInputs));
+    // Joysticks are never touched unless gamepad navigation is enabled, as the first call initializes joystick
+    // support in GLFW and polling them means reading devices every frame
     if ((io.ConfigFlags & ImGuiConfigFlags_NavEnableGamepad) == 0)
+    {
+        if (state->g_GamepadEnabled)
+        {
+            memset(io.NavInputs, 0, sizeof(io.NavInputs));
+            io.BackendFlags &= ~ImGuiBackendFlags_HasGamepad;
+            state->g_GamepadEnabled = false;
+        }
         return;
+    }
+    state->g_GamepadEnabled = true;
+    memset(io.NavInputs, 0, sizeof(io.NavInputs));
 
     // Update gamepad inputs
     #define MAP_BUTTON(NAV_NO, BUTTON_NO)       { if (buttons_count > BUTTON_NO && buttons[BUTTON_NO] == GLFW_PRESS) io.NavInputs[NAV_NO] = 1.0f; }
@@ -351,11 +571,27 @@ void ImGui_ImplGlfw_NewFrame()
 
     IM_ASSERT(io.Fonts->IsBuilt() && "Font atlas not built! It is generally built by the renderer back-end. Missing call to renderer _NewFrame() function? e.g. ImGui_ImplOpenGL3_NewFrame().");
 
+    // Requests counted since the last frame, including the ones made by callbacks while polling events
+    state->g_FrameStats.ServerRequests = state->g_ServerRequests.exchange(0);
+
     // Setup display size (every frame to accommodate for window resizing)
+    // Without callbacks the sizes have to be asked for every frame, which means two round trips to the X server
     int w, h;
     int display_w, display_h;
-    glfwGetWindowSize(state->g_Window, &w, &h);
-    glfwGetFramebufferSize(state->g_Window, &display_w, &display_h);
+    if (state->g_InstalledCallbacks)
+    {
+        state->g_Resized = false;
+        w = state->g_WindowWidth;
+        h = state->g_WindowHeight;
+        display_w = state->g_FramebufferWidth;
+        display_h = state->g_FramebufferHeight;
+    }
+    else
+    {
+        glfwGetWindowSize(state->g_Window, &w, &h);
+        glfwGetFramebufferSize(state->g_Window, &display_w, &display_h);
+        state->g_ServerRequests += 2;
+    }
     io.DisplaySize = ImVec2((float)w, (float)h);
     if (w > 0 && h > 0)
         io.DisplayFramebufferScale = ImVec2((float)display_w / w, (float)display_h / h);
@@ -365,9 +601,64 @@ void ImGui_ImplGlfw_NewFrame()
     io.DeltaTime = state->g_Time > 0.0 ? (float)(current_time - state->g_Time) : (float)(1.0f/60.0f);
     state->g_Time = current_time;
 
-    ImGui_ImplGlfw_UpdateMousePosAndButtons();
+    ImGui_ImplGlfw_UpdateMousePos();
+    ImGui_ImplGlfw_UpdateInputEvents();
     ImGui_ImplGlfw_UpdateMouseCursor();
 
     // Update game controllers (if enabled and available)
     ImGui_ImplGlfw_UpdateGamepads();
 }
+
+void ImGui_ImplGlfw_FramePresented()
+{
+    GLFWImplContext* state = _impl_ctx;
+    if (state->g_OldestInputTime == 0.0)
+        return;
+    ImGui_ImplGlfw_InputStats& stats = state->g_InputStats;
+    float latency = (float)((glfwGetTime() - state->g_OldestInputTime) * 1000.0);
+    stats.LastLatencyMs = latency;
+    stats.AverageLatencyMs = stats.MeasuredFrames == 0 ? latency : stats.AverageLatencyMs + 0.05f * (latency - stats.AverageLatencyMs);
+    stats.MaxLatencyMs = latency > stats.MaxLatencyMs ? latency : stats.MaxLatencyMs;
+    stats.MeasuredFrames++;
+    state->g_OldestInputTime = 0.0;
+}
+
+const ImGui_ImplGlfw_InputStats& ImGui_ImplGlfw_GetInputStats()
+{
+    // Latency is only measured for input the callbacks timestamped, without a window (e.g. replaying headless) all zero
+    static const ImGui_ImplGlfw_InputStats no_stats{};
+    return _impl_ctx ? _impl_ctx->g_InputStats : no_stats;
+}
+
+bool ImGui_ImplGlfw_WaitForEvents(double timeout)
+{
+    GLFWImplContext* state = _impl_ctx;
+    auto has_events = [state]()
+    {
+        return state->g_InputWritePos.load(std::memory_order_acquire) != state->g_InputReadPos.load(std::memory_order_relaxed) ||
+               state->g_Resized.exchange(false);
+    };
+    if (has_events())
+        return true;
+
+    // g_Waiting is set before the queue is checked again under the lock, and callbacks check it after writing to the
+    // queue, so an event can't slip in between the check and going to sleep without a notification
+    std::unique_lock<std::mutex> lock(state->g_WaitMutex);
+    state->g_Waiting = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool woken = state->g_WaitCondition.wait_for(lock, std::chrono::duration<double>(timeout), has_events);
+    state->g_Waiting = false;
+    return woken;
+}
+
+const ImGui_ImplGlfw_FrameStats& ImGui_ImplGlfw_GetFrameStats()
+{
+    // Headless the backend isn't initialized and makes no window system requests, so report none
+    static const ImGui_ImplGlfw_FrameStats no_stats{};
+    return _impl_ctx ? _impl_ctx->g_FrameStats : no_stats;
+}
+
+size_t ImGui_ImplGlfw_GetMemoryUsage()
+{
+    return _impl_ctx ? sizeof(GLFWImplContext) : 0;
+}
@@ -7,6 +7,7 @@
 //  [X] Platform: Gamepad support. Enable with 'io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad'.
 //  [x] Platform: Mouse cursor shape and visibility. Disable with 'io.ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange'. FIXME: 3 cursors types are missing from GLFW.
 //  [X] Platform: Keyboard arrays indexed using GLFW_KEY_* codes, e.g. ImGui::IsKeyPressed(GLFW_KEY_SPACE).
+//  [X] Platform: Timestamped input event queue fed by the callbacks, requires 'install_callbacks=true'. (vstimgui addition)
 
 // You can copy and use unmodified imgui_impl_* files in your project. See main.cpp for an example of using this.
 // If you are new to dear imgui, read examples/README.txt and read the documentation at the top of imgui.cpp.
@@ -30,6 +31,47 @@ IMGUI_IMPL_API void     ImGui_ImplGlfw_NewFrame();
 // - When calling Init with 'install_callbacks=true': GLFW callbacks will be installed for you. They will call user's previously installed callbacks, if any.
 // - When calling Init with 'install_callbacks=false': GLFW callbacks won't be installed. You will need to call those function yourself from your own GLFW callbacks.
 IMGUI_IMPL_API void     ImGui_ImplGlfw_MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+IMGUI_IMPL_API void     ImGui_ImplGlfw_CursorPosCallback(GLFWwindow* window, double x, double y);
+IMGUI_IMPL_API void     ImGui_ImplGlfw_CursorEnterCallback(GLFWwindow* window, int entered);
+IMGUI_IMPL_API void     ImGui_ImplGlfw_WindowSizeCallback(GLFWwindow* window, int width, int height);
+IMGUI_IMPL_API void     ImGui_ImplGlfw_FramebufferSizeCallback(GLFWwindow* window, int width, int height);
 IMGUI_IMPL_API void     ImGui_ImplGlfw_ScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
 IMGUI_IMPL_API void     ImGui_ImplGlfw_KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 IMGUI_IMPL_API void     ImGui_ImplGlfw_CharCallback(GLFWwindow* window, unsigned int c);
+
+// Input latency (vstimgui addition)
+// Input events are timestamped when the callbacks receive them. Call ImGui_ImplGlfw_FramePresented() right after the
+// frame is presented (i.e. after glfwSwapBuffers()) to measure the time from the oldest input event applied in that
+// frame until it was presented. Frames without input are not measured.
+struct ImGui_ImplGlfw_InputStats
+{
+    float   LastLatencyMs;
+    float   AverageLatencyMs;
+    float   MaxLatencyMs;
+    int     MeasuredFrames;     // Number of frames with input
+    int     EventsApplied;      // Input events applied in the last frame
+    int     EventsDeferred;     // Input events left for the next frame, e.g. a release following a press in the same frame
+    int     EventsDropped;      // Input events lost because the queue was full, in total
+};
+IMGUI_IMPL_API void     ImGui_ImplGlfw_FramePresented();
+IMGUI_IMPL_API const ImGui_ImplGlfw_InputStats& ImGui_ImplGlfw_GetInputStats();
+
+// Window system requests (vstimgui addition)
+// Counts the calls into GLFW made by the backend that result in a request to the window system (on X11 a request to
+// the X server, some of them round trips), from one call to ImGui_ImplGlfw_NewFrame() to the next. With callbacks
+// installed an idle window makes none.
+struct ImGui_ImplGlfw_FrameStats
+{
+    int     ServerRequests;
+};
+IMGUI_IMPL_API const ImGui_ImplGlfw_FrameStats& ImGui_ImplGlfw_GetFrameStats();
+
+// Memory used by the calling thread's backend state (vstimgui addition)
+// The state is allocated with operator new rather than through ImGui's allocator, as it needs cache line alignment.
+IMGUI_IMPL_API size_t   ImGui_ImplGlfw_GetMemoryUsage();
+
+// Waiting for input (vstimgui addition)
+// Blocks the calling thread until there are input events queued for its window, the window is resized or timeout
+// seconds have passed. Returns true if there are new events. Meant for when events are dispatched for all windows from
+// another thread, so a window's own thread only needs to wake up when there's input for it.
+IMGUI_IMPL_API bool     ImGui_ImplGlfw_WaitForEvents(double timeout);
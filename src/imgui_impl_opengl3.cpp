@@ -13,6 +13,16 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  vstimgui: OpenGL: Added ImGui_ImplOpenGL3_GetPolyline(), ImGui_ImplOpenGL3_GetWidgets() and the Set counterparts for capturing draw callbacks.
+//  vstimgui: OpenGL: Added ImGui_ImplOpenGL3_HasInstancedWidgets().
+//  vstimgui: OpenGL: Added ImGui_ImplOpenGL3_UpdateFontsTexture() for glyphs added to the font atlas after it was uploaded.
+//  vstimgui: OpenGL: Support for the compact fixed point vertex layout in imconfig.h (VSTIMGUI_COMPACT_VERTICES).
+//  vstimgui: OpenGL: Added ImGui_ImplOpenGL3_GetMemoryStats(), the size of all buffers and textures created by the backend.
+//  vstimgui: OpenGL: Added streaming ring textures, ImGui_ImplOpenGL3_CreateRingTexture() etc.
+//  vstimgui: OpenGL: Added ImGui_ImplOpenGL3_CreateTexture() and ImGui_ImplOpenGL3_DestroyTexture(), uploading through a pixel buffer object.
+//  vstimgui: OpenGL: Added ImGui_ImplOpenGL3_AddWidgetInstance() for instanced rendering of sliders and knobs.
+//  vstimgui: OpenGL: Added ImGui_ImplOpenGL3_GetFrameStats().
+//  vstimgui: OpenGL: Added ImGui_ImplOpenGL3_AddPolyline() for rendering dense polylines in a vertex shader.
 //  2021-01-03: OpenGL: Backup, setup and restore GL_STENCIL_TEST state.
 //  2020-10-23: OpenGL: Backup, setup and restore GL_PRIMITIVE_RESTART state.
 //  2020-10-15: OpenGL: Use glGetString(GL_VERSION) instead of glGetIntegerv(GL_MAJOR_VERSION, ...) when the later returns zero (e.g. Desktop GL 2.x)
@@ -79,6 +89,8 @@
 #include "imgui.h"
 #include "imgui_impl_opengl3.h"
 #include <stdio.h>
+#include <string.h>     // memcpy, memset
+#include <math.h>       // sinf, cosf
 #if defined(_MSC_VER) && _MSC_VER <= 1500 // MSVC 2008 or earlier
 #include <stddef.h>     // intptr_t
 #else
@@ -136,20 +148,130 @@ using namespace gl;
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.3+ has instanced arrays (glVertexAttribDivisor)
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_3_3)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+#endif
+
 // Desktop GL 3.1+ has GL_PRIMITIVE_RESTART state
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_3_1)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
 #endif
 
+// Compact vertices (vstimgui addition, see imconfig.h) store positions and texture coordinates as 16-bit
+// fixed point integers, which the vertex shader scales back to floats.
+#define IMGUI_IMPL_OPENGL_STRINGIFY2(_X) #_X
+#define IMGUI_IMPL_OPENGL_STRINGIFY(_X) IMGUI_IMPL_OPENGL_STRINGIFY2(_X)
+#ifdef VSTIMGUI_COMPACT_VERTICES
+#define IMGUI_IMPL_OPENGL_VTX_POS_TYPE      GL_SHORT
+#define IMGUI_IMPL_OPENGL_VTX_UV_TYPE       GL_UNSIGNED_SHORT
+#define IMGUI_IMPL_OPENGL_VTX_POS_SCALE     "(1.0 / " IMGUI_IMPL_OPENGL_STRINGIFY(VSTIMGUI_VERTEX_POS_ONE) ".0)"
+#define IMGUI_IMPL_OPENGL_VTX_UV_SCALE      "(1.0 / " IMGUI_IMPL_OPENGL_STRINGIFY(VSTIMGUI_VERTEX_UV_ONE) ".0)"
+#else
+#define IMGUI_IMPL_OPENGL_VTX_POS_TYPE      GL_FLOAT
+#define IMGUI_IMPL_OPENGL_VTX_UV_TYPE       GL_FLOAT
+#define IMGUI_IMPL_OPENGL_VTX_POS_SCALE     "1.0"
+#define IMGUI_IMPL_OPENGL_VTX_UV_SCALE      "1.0"
+#endif
+
 // OpenGL Data
 static GLuint       g_GlVersion = 0;                // Extracted at runtime using GL_MAJOR_VERSION, GL_MINOR_VERSION queries (e.g. 320 for GL 3.2)
 static char         g_GlslVersionString[32] = "";   // Specified by user or detected based on compile time GL settings.
 thread_local static GLuint       g_FontTexture = 0;
+thread_local static int          g_FontTextureWidth = 0, g_FontTextureHeight = 0;
 thread_local static GLuint       g_ShaderHandle = 0, g_VertHandle = 0, g_FragHandle = 0;
 thread_local static int          g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;                                // Uniforms location
 thread_local static int          g_AttribLocationVtxPos = 0, g_AttribLocationVtxUV = 0, g_AttribLocationVtxColor = 0; // Vertex attributes location
 thread_local static unsigned int g_VboHandle = 0, g_ElementsHandle = 0;
 
+// Polyline rendering data. Points for all polylines of a frame are collected in g_LineData and uploaded to
+// a RG32F texture the first time a polyline callback is run, each line is then drawn without vertex attributes
+// by fetching its points in the vertex shader with gl_VertexID.
+struct ImGui_ImplOpenGL3_LineBatch
+{
+    int     Offset;
+    int     Count;
+    ImVec4  Color;
+    float   Thickness;
+};
+static const int                 LINE_TEXTURE_WIDTH = 1024;   // Must match the index arithmetic in the line vertex shader
+thread_local static bool         g_LinesSupported = false;     // Needs texelFetch() and gl_VertexID, i.e. GLSL 130+
+thread_local static GLuint       g_LineShaderHandle = 0, g_LineVertHandle = 0, g_LineFragHandle = 0;
+thread_local static int          g_LineLocationProjMtx = 0, g_LineLocationPoints = 0, g_LineLocationFirst = 0;
+thread_local static int          g_LineLocationHalfWidth = 0, g_LineLocationHalfThickness = 0, g_LineLocationColor = 0;
+thread_local static GLuint       g_LineTexture = 0, g_LineVao = 0;
+thread_local static int          g_LineTextureRows = 0;
+thread_local static bool         g_LinePointsUploaded = false;
+struct ImGui_ImplOpenGL3_LineData
+{
+    ImVector<ImVec2>                        Points;
+    ImVector<ImGui_ImplOpenGL3_LineBatch>   Batches;
+};
+thread_local static ImGui_ImplOpenGL3_LineData g_LineData;
+
+// Instanced widget data. Instances are collected in one batch per draw list and widget type each frame, a batch is
+// uploaded and drawn with one glDrawElementsInstanced() call from a callback in the draw list. The unit quad drawn
+// per instance is static. Batch vectors are reused between frames, only BatchCount is reset.
+struct ImGui_ImplOpenGL3_WidgetBatch
+{
+    const ImDrawList*                           DrawList;
+    ImGui_ImplOpenGL3_WidgetType                Type;
+    ImVector<ImGui_ImplOpenGL3_WidgetInstance>  Instances;
+};
+struct ImGui_ImplOpenGL3_WidgetData
+{
+    ImVector<ImGui_ImplOpenGL3_WidgetBatch>     Batches;
+    int                                         BatchCount = 0;
+};
+static const float               WIDGET_GRAB_PADDING = 2.0f;  // Same as the grab padding in ImGui's sliders
+thread_local static bool         g_WidgetsSupported = false;
+thread_local static GLuint       g_WidgetShaderHandle = 0, g_WidgetVertHandle = 0, g_WidgetFragHandle = 0;
+thread_local static int          g_WidgetLocationProjMtx = 0, g_WidgetLocationType = 0, g_WidgetLocationGrabSize = 0, g_WidgetLocationGrabPadding = 0;
+thread_local static GLuint       g_WidgetVao = 0, g_WidgetQuadVbo = 0, g_WidgetQuadElements = 0, g_WidgetInstanceVbo = 0;
+thread_local static ImGui_ImplOpenGL3_WidgetData g_WidgetData;
+
+// Render state shared with draw callbacks
+thread_local static float        g_ProjMtx[4][4];
+thread_local static ImVec2       g_ClipOff, g_ClipScale;
+thread_local static int          g_FbWidth = 0, g_FbHeight = 0;
+thread_local static ImGui_ImplOpenGL3_FrameStats g_FrameStats, g_LastFrameStats;  // Accumulated during the frame, published after rendering
+
+// Texture uploads (ImGui_ImplOpenGL3_CreateTexture) go through a pixel unpack buffer where available, reused between uploads
+thread_local static bool         g_PixelBuffersSupported = false;
+thread_local static GLuint       g_UploadPbo = 0;
+
+// Estimated GPU memory, the size each buffer and texture was last allocated with by handle
+thread_local static ImGuiStorage g_BufferSizes, g_TextureSizes;
+thread_local static ImGui_ImplOpenGL3_MemoryStats g_MemoryStats;
+
+struct ImGui_ImplOpenGL3_RingTexture
+{
+    GLuint  Texture;
+    GLuint  Pbos[2];        // Written alternately, so a new line never waits for the transfer of the previous one
+    int     PboIndex;
+    int     LineLength;
+    int     LineCount;
+    int     Head;           // Next line to be written, also the oldest line
+};
+
+static void ImGui_ImplOpenGL3_RenderPolyline(const ImDrawList* parent_list, const ImDrawCmd* cmd);
+static void ImGui_ImplOpenGL3_RenderWidgets(const ImDrawList* parent_list, const ImDrawCmd* cmd);
+
+// Record the size a buffer or texture was allocated with, 0 when deleted. The totals wrap around correctly when shrinking.
+static void ImGui_ImplOpenGL3_TrackBuffer(GLuint buffer, size_t size)
+{
+    int* tracked = g_BufferSizes.GetIntRef((ImGuiID)buffer, 0);
+    g_MemoryStats.BufferBytes += size - (size_t)*tracked;
+    *tracked = (int)size;
+}
+
+static void ImGui_ImplOpenGL3_TrackTexture(GLuint texture, size_t size)
+{
+    int* tracked = g_TextureSizes.GetIntRef((ImGuiID)texture, 0);
+    g_MemoryStats.TextureBytes += size - (size_t)*tracked;
+    *tracked = (int)size;
+}
+
 // Functions
 bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 {
@@ -197,6 +319,18 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     strcpy(g_GlslVersionString, glsl_version);
     strcat(g_GlslVersionString, "\n");
 
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    int glsl_version_number = 130;
+    sscanf(g_GlslVersionString, "#version %d", &glsl_version_number);
+    g_LinesSupported = g_GlVersion >= 300 && glsl_version_number >= 130;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    g_WidgetsSupported = g_GlVersion >= 330 && glsl_version_number >= 130;
+#endif
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    g_PixelBuffersSupported = g_GlVersion >= 300;
+#endif
+
     // Debugging construct to make it easily visible in the IDE and debugger which GL loader has been selected.
     // The code actually never uses the 'gl_loader' variable! It is only here so you can read it!
     // If auto-detection fails or doesn't select the same GL loader file as used by your application,
@@ -234,12 +368,30 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 void    ImGui_ImplOpenGL3_Shutdown()
 {
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
+    g_BufferSizes.Clear();
+    g_TextureSizes.Clear();
+    memset(&g_MemoryStats, 0, sizeof(g_MemoryStats));
 }
 
 void    ImGui_ImplOpenGL3_NewFrame()
 {
     if (!g_ShaderHandle)
         ImGui_ImplOpenGL3_CreateDeviceObjects();
+
+    // Polylines and widgets from the previous frame have been rendered
+    g_LineData.Points.resize(0);
+    g_LineData.Batches.resize(0);
+    g_WidgetData.BatchCount = 0;
+}
+
+const ImGui_ImplOpenGL3_FrameStats& ImGui_ImplOpenGL3_GetFrameStats()
+{
+    return g_LastFrameStats;
+}
+
+const ImGui_ImplOpenGL3_MemoryStats& ImGui_ImplOpenGL3_GetMemoryStats()
+{
+    return g_MemoryStats;
 }
 
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
@@ -285,6 +437,7 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
+    memcpy(g_ProjMtx, ortho_projection, sizeof(g_ProjMtx));
     glUseProgram(g_ShaderHandle);
     glUniform1i(g_AttribLocationTex, 0);
     glUniformMatrix4fv(g_AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
@@ -305,8 +458,8 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glEnableVertexAttribArray(g_AttribLocationVtxPos);
     glEnableVertexAttribArray(g_AttribLocationVtxUV);
     glEnableVertexAttribArray(g_AttribLocationVtxColor);
-    glVertexAttribPointer(g_AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
-    glVertexAttribPointer(g_AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
+    glVertexAttribPointer(g_AttribLocationVtxPos,   2, IMGUI_IMPL_OPENGL_VTX_POS_TYPE, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
+    glVertexAttribPointer(g_AttribLocationVtxUV,    2, IMGUI_IMPL_OPENGL_VTX_UV_TYPE,  GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
     glVertexAttribPointer(g_AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
 }
 
@@ -365,6 +518,11 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+    g_ClipOff = clip_off;
+    g_ClipScale = clip_scale;
+    g_FbWidth = fb_width;
+    g_FbHeight = fb_height;
+    g_LinePointsUploaded = false;
 
     // Render command lists
     for (int n = 0; n < draw_data->CmdListsCount; n++)
@@ -374,6 +532,10 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         // Upload vertex/index buffers
         glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+        g_FrameStats.VertexBytes += cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
+        g_FrameStats.IndexBytes += cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+        ImGui_ImplOpenGL3_TrackBuffer(g_VboHandle, (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        ImGui_ImplOpenGL3_TrackBuffer(g_ElementsHandle, (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -384,6 +546,16 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                else if (pcmd->UserCallback == ImGui_ImplOpenGL3_RenderPolyline || pcmd->UserCallback == ImGui_ImplOpenGL3_RenderWidgets)
+                {
+                    // Only the program, vertex array and vertex buffer need to be put back, textures are bound per draw call
+                    pcmd->UserCallback(cmd_list, pcmd);
+                    glUseProgram(g_ShaderHandle);
+#ifndef IMGUI_IMPL_OPENGL_ES2
+                    glBindVertexArray(vertex_array_object);
+#endif
+                    glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
@@ -403,6 +575,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 
                     // Bind texture, Draw
                     glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
+                    g_FrameStats.DrawCalls++;
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                     if (g_GlVersion >= 320)
                         glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
@@ -447,6 +620,9 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 #endif
     glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
     glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+
+    g_LastFrameStats = g_FrameStats;
+    memset(&g_FrameStats, 0, sizeof(g_FrameStats));
 }
 
 bool ImGui_ImplOpenGL3_CreateFontsTexture()
@@ -468,6 +644,9 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 #endif
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    ImGui_ImplOpenGL3_TrackTexture(g_FontTexture, (size_t)width * height * 4);
+    g_FontTextureWidth = width;
+    g_FontTextureHeight = height;
 
     // Store our identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)g_FontTexture);
@@ -484,11 +663,469 @@ void ImGui_ImplOpenGL3_DestroyFontsTexture()
     {
         ImGuiIO& io = ImGui::GetIO();
         glDeleteTextures(1, &g_FontTexture);
+        ImGui_ImplOpenGL3_TrackTexture(g_FontTexture, 0);
         io.Fonts->SetTexID(0);
         g_FontTexture = 0;
     }
 }
 
+void ImGui_ImplOpenGL3_UpdateFontsTexture(int y, int height)
+{
+    // Nothing to update before the texture is created with the whole atlas
+    if (!g_FontTexture)
+        return;
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels;
+    int atlas_width, atlas_height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &atlas_width, &atlas_height);
+
+    // The atlas grew, the texture has to be created again at the new size
+    if (atlas_width != g_FontTextureWidth || atlas_height != g_FontTextureHeight)
+    {
+        ImGui_ImplOpenGL3_DestroyFontsTexture();
+        ImGui_ImplOpenGL3_CreateFontsTexture();
+        g_FrameStats.TextureBytes += atlas_width * atlas_height * 4;
+        return;
+    }
+    if (y < 0)
+    {
+        height += y;
+        y = 0;
+    }
+    if (y + height > atlas_height)
+        height = atlas_height - y;
+    if (height <= 0)
+        return;
+
+    // Whole rows, so the changed part of the atlas is contiguous in memory
+    GLint last_texture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+#ifdef GL_UNPACK_ROW_LENGTH
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, atlas_width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (size_t)y * atlas_width * 4);
+    g_FrameStats.TextureBytes += atlas_width * height * 4;
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+}
+
+ImTextureID ImGui_ImplOpenGL3_CreateTexture(const void* pixels, int width, int height)
+{
+    GLint last_texture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+#ifdef GL_UNPACK_ROW_LENGTH
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    GLsizeiptr size = (GLsizeiptr)width * height * 4;
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    if (g_PixelBuffersSupported)
+    {
+        // Orphan the previous contents so the copy doesn't wait for an earlier upload to finish, the driver can then
+        // transfer the texture from the buffer without the caller's memory having to stay valid
+        if (g_UploadPbo == 0)
+            glGenBuffers(1, &g_UploadPbo);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, g_UploadPbo);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        ImGui_ImplOpenGL3_TrackBuffer(g_UploadPbo, (size_t)size);
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (mapped != NULL)
+        {
+            memcpy(mapped, pixels, (size_t)size);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const GLvoid*)0);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (mapped == NULL)
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+    else
+#endif
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+    g_FrameStats.TextureBytes += (int)size;
+    ImGui_ImplOpenGL3_TrackTexture(texture, (size_t)size);
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+    return (ImTextureID)(intptr_t)texture;
+}
+
+void ImGui_ImplOpenGL3_DestroyTexture(ImTextureID texture)
+{
+    GLuint handle = (GLuint)(intptr_t)texture;
+    if (handle != 0)
+    {
+        glDeleteTextures(1, &handle);
+        ImGui_ImplOpenGL3_TrackTexture(handle, 0);
+    }
+}
+
+ImGui_ImplOpenGL3_RingTexture* ImGui_ImplOpenGL3_CreateRingTexture(int line_length, int line_count)
+{
+    ImGui_ImplOpenGL3_RingTexture* ring = IM_NEW(ImGui_ImplOpenGL3_RingTexture);
+    memset(ring, 0, sizeof(*ring));
+    ring->LineLength = line_length;
+    ring->LineCount = line_count;
+
+    // Start out cleared, lines are stored as texture rows so each new line is one contiguous upload
+    ImVector<ImU32> clear_pixels;
+    clear_pixels.resize(line_length * line_count, 0);
+    GLint last_texture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glGenTextures(1, &ring->Texture);
+    glBindTexture(GL_TEXTURE_2D, ring->Texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+#ifdef GL_UNPACK_ROW_LENGTH
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, line_length, line_count, 0, GL_RGBA, GL_UNSIGNED_BYTE, clear_pixels.Data);
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+    clear_pixels.clear();
+    g_FrameStats.TextureBytes += line_length * line_count * 4;
+    ImGui_ImplOpenGL3_TrackTexture(ring->Texture, (size_t)line_length * line_count * 4);
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    if (g_PixelBuffersSupported)
+        glGenBuffers(2, ring->Pbos);
+#endif
+    return ring;
+}
+
+void ImGui_ImplOpenGL3_DestroyRingTexture(ImGui_ImplOpenGL3_RingTexture* ring)
+{
+    if (ring == NULL)
+        return;
+    glDeleteTextures(1, &ring->Texture);
+    ImGui_ImplOpenGL3_TrackTexture(ring->Texture, 0);
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    if (ring->Pbos[0])
+    {
+        glDeleteBuffers(2, ring->Pbos);
+        ImGui_ImplOpenGL3_TrackBuffer(ring->Pbos[0], 0);
+        ImGui_ImplOpenGL3_TrackBuffer(ring->Pbos[1], 0);
+    }
+#endif
+    IM_DELETE(ring);
+}
+
+void ImGui_ImplOpenGL3_PushRingTextureLines(ImGui_ImplOpenGL3_RingTexture* ring, const ImU32* pixels, int lines)
+{
+    // Only the last LineCount lines would be visible
+    if (lines > ring->LineCount)
+    {
+        pixels += (size_t)(lines - ring->LineCount) * ring->LineLength;
+        lines = ring->LineCount;
+    }
+    if (lines <= 0)
+        return;
+
+    GLint last_texture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glBindTexture(GL_TEXTURE_2D, ring->Texture);
+#ifdef GL_UNPACK_ROW_LENGTH
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    while (lines > 0)
+    {
+        // At most two uploads, split where the write head wraps around
+        int chunk = lines < ring->LineCount - ring->Head ? lines : ring->LineCount - ring->Head;
+        GLsizeiptr size = (GLsizeiptr)chunk * ring->LineLength * 4;
+        const GLvoid* source = pixels;
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+        if (ring->Pbos[0])
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ring->Pbos[ring->PboIndex]);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+            ImGui_ImplOpenGL3_TrackBuffer(ring->Pbos[ring->PboIndex], (size_t)size);
+            ring->PboIndex ^= 1;
+            void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (mapped != NULL)
+            {
+                memcpy(mapped, pixels, (size_t)size);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                source = (const GLvoid*)0;
+            }
+            else
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+        }
+#endif
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, ring->Head, ring->LineLength, chunk, GL_RGBA, GL_UNSIGNED_BYTE, source);
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+        if (ring->Pbos[0])
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+#endif
+        g_FrameStats.TextureBytes += (int)size;
+        ring->Head = (ring->Head + chunk) % ring->LineCount;
+        pixels += (size_t)chunk * ring->LineLength;
+        lines -= chunk;
+    }
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+}
+
+void ImGui_ImplOpenGL3_AddRingTextureImage(ImDrawList* draw_list, const ImGui_ImplOpenGL3_RingTexture* ring, const ImVec2& p_min, const ImVec2& p_max, bool horizontal)
+{
+    // The texture repeats along the lines, so the view from the oldest to the newest line is one continuous range of v
+    ImTextureID texture = (ImTextureID)(intptr_t)ring->Texture;
+    float v_oldest = (float)ring->Head / ring->LineCount;
+    float v_newest = v_oldest + 1.0f;
+    if (horizontal)
+        draw_list->AddImageQuad(texture, p_min, ImVec2(p_max.x, p_min.y), p_max, ImVec2(p_min.x, p_max.y),
+                                ImVec2(1.0f, v_oldest), ImVec2(1.0f, v_newest), ImVec2(0.0f, v_newest), ImVec2(0.0f, v_oldest));
+    else
+        draw_list->AddImage(texture, p_min, p_max, ImVec2(0.0f, v_newest), ImVec2(1.0f, v_oldest));
+}
+
+// Copies the points of a polyline for this frame, returns the batch index for the callback
+static int ImGui_ImplOpenGL3_PushLineBatch(const ImVec2* points, int points_count, ImU32 col, float thickness)
+{
+    ImGui_ImplOpenGL3_LineBatch batch;
+    batch.Offset = g_LineData.Points.Size;
+    batch.Count = points_count;
+    batch.Color = ImGui::ColorConvertU32ToFloat4(col);
+    batch.Thickness = thickness;
+    g_LineData.Points.resize(g_LineData.Points.Size + points_count);
+    memcpy(g_LineData.Points.Data + batch.Offset, points, (size_t)points_count * sizeof(ImVec2));
+    g_LineData.Batches.push_back(batch);
+    return g_LineData.Batches.Size - 1;
+}
+
+void ImGui_ImplOpenGL3_AddPolyline(ImDrawList* draw_list, const ImVec2* points, int points_count, ImU32 col, float thickness)
+{
+    if (!g_LinesSupported)
+    {
+        draw_list->AddPolyline(points, points_count, col, ImDrawFlags_None, thickness);
+        return;
+    }
+    if (points_count < 2 || (col & IM_COL32_A_MASK) == 0)
+        return;
+
+    draw_list->AddCallback(ImGui_ImplOpenGL3_RenderPolyline, (void*)(intptr_t)ImGui_ImplOpenGL3_PushLineBatch(points, points_count, col, thickness));
+}
+
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+static void ImGui_ImplOpenGL3_UploadLinePoints()
+{
+    // Pad to full texture rows and grow the texture if needed, then upload all points of the frame in one go
+    int rows = (g_LineData.Points.Size + LINE_TEXTURE_WIDTH - 1) / LINE_TEXTURE_WIDTH;
+    g_LineData.Points.resize(rows * LINE_TEXTURE_WIDTH, ImVec2(0.0f, 0.0f));
+    glBindTexture(GL_TEXTURE_2D, g_LineTexture);
+#ifdef GL_UNPACK_ROW_LENGTH
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    if (rows > g_LineTextureRows)
+    {
+        g_LineTextureRows = rows;
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32F, LINE_TEXTURE_WIDTH, rows, 0, GL_RG, GL_FLOAT, g_LineData.Points.Data);
+        ImGui_ImplOpenGL3_TrackTexture(g_LineTexture, (size_t)LINE_TEXTURE_WIDTH * rows * sizeof(ImVec2));
+    }
+    else
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, LINE_TEXTURE_WIDTH, rows, GL_RG, GL_FLOAT, g_LineData.Points.Data);
+    }
+    g_LinePointsUploaded = true;
+    g_FrameStats.VertexBytes += g_LineData.Points.size_in_bytes();
+}
+#endif
+
+// Apply the clipping rectangle of a callback command, returns false if it is entirely outside the framebuffer
+static bool ImGui_ImplOpenGL3_SetCallbackScissor(const ImDrawCmd* cmd)
+{
+    ImVec4 clip_rect;
+    clip_rect.x = (cmd->ClipRect.x - g_ClipOff.x) * g_ClipScale.x;
+    clip_rect.y = (cmd->ClipRect.y - g_ClipOff.y) * g_ClipScale.y;
+    clip_rect.z = (cmd->ClipRect.z - g_ClipOff.x) * g_ClipScale.x;
+    clip_rect.w = (cmd->ClipRect.w - g_ClipOff.y) * g_ClipScale.y;
+    if (clip_rect.x >= g_FbWidth || clip_rect.y >= g_FbHeight || clip_rect.z < 0.0f || clip_rect.w < 0.0f)
+        return false;
+    glScissor((int)clip_rect.x, (int)(g_FbHeight - clip_rect.w), (int)(clip_rect.z - clip_rect.x), (int)(clip_rect.w - clip_rect.y));
+    return true;
+}
+
+static void ImGui_ImplOpenGL3_RenderPolyline(const ImDrawList* parent_list, const ImDrawCmd* cmd)
+{
+    IM_UNUSED(parent_list);
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    const ImGui_ImplOpenGL3_LineBatch& batch = g_LineData.Batches[(int)(intptr_t)cmd->UserCallbackData];
+    if (!g_LinePointsUploaded)
+        ImGui_ImplOpenGL3_UploadLinePoints();
+
+    if (!ImGui_ImplOpenGL3_SetCallbackScissor(cmd))
+        return;
+
+    // Lines are widened by 1 pixel on each side for the anti-aliased fringe
+    glUseProgram(g_LineShaderHandle);
+    glUniformMatrix4fv(g_LineLocationProjMtx, 1, GL_FALSE, &g_ProjMtx[0][0]);
+    glUniform1i(g_LineLocationPoints, 0);
+    glUniform1i(g_LineLocationFirst, batch.Offset);
+    glUniform1f(g_LineLocationHalfThickness, batch.Thickness * 0.5f);
+    glUniform1f(g_LineLocationHalfWidth, batch.Thickness * 0.5f + 1.0f);
+    glUniform4f(g_LineLocationColor, batch.Color.x, batch.Color.y, batch.Color.z, batch.Color.w);
+    glBindVertexArray(g_LineVao);
+    glBindTexture(GL_TEXTURE_2D, g_LineTexture);
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(batch.Count - 1) * 6);
+    g_FrameStats.DrawCalls++;
+#else
+    IM_UNUSED(cmd);
+#endif
+}
+
+bool ImGui_ImplOpenGL3_HasInstancedWidgets()
+{
+    return g_WidgetsSupported;
+}
+
+// Starts an empty batch for this frame, drawn by the callback with the index BatchCount - 1
+static ImGui_ImplOpenGL3_WidgetBatch* ImGui_ImplOpenGL3_NewWidgetBatch(const ImDrawList* draw_list, ImGui_ImplOpenGL3_WidgetType type)
+{
+    if (g_WidgetData.BatchCount == g_WidgetData.Batches.Size)
+    {
+        // Same as ImDrawListSplitter, ImVector doesn't construct its elements
+        g_WidgetData.Batches.resize(g_WidgetData.BatchCount + 1);
+        IM_PLACEMENT_NEW(&g_WidgetData.Batches[g_WidgetData.BatchCount]) ImGui_ImplOpenGL3_WidgetBatch();
+    }
+    ImGui_ImplOpenGL3_WidgetBatch* batch = &g_WidgetData.Batches[g_WidgetData.BatchCount];
+    batch->DrawList = draw_list;
+    batch->Type = type;
+    batch->Instances.resize(0);
+    g_WidgetData.BatchCount++;
+    return batch;
+}
+
+void ImGui_ImplOpenGL3_AddWidgetInstance(ImDrawList* draw_list, ImGui_ImplOpenGL3_WidgetType type, const ImVec2& pos, const ImVec2& size, float value, ImU32 frame_col, ImU32 grab_col)
+{
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    if (!g_WidgetsSupported)
+    {
+        // Draw the same widget with regular primitives
+        ImVec2 max(pos.x + size.x, pos.y + size.y);
+        if (type == ImGui_ImplOpenGL3_WidgetType_VSlider)
+        {
+            float grab_size = ImGui::GetStyle().GrabMinSize;
+            float grab_top = pos.y + WIDGET_GRAB_PADDING + (1.0f - value) * (size.y - 2.0f * WIDGET_GRAB_PADDING - grab_size);
+            draw_list->AddRectFilled(pos, max, frame_col);
+            draw_list->AddRectFilled(ImVec2(pos.x + WIDGET_GRAB_PADDING, grab_top), ImVec2(max.x - WIDGET_GRAB_PADDING, grab_top + grab_size), grab_col);
+        }
+        else
+        {
+            float radius = (size.x < size.y ? size.x : size.y) * 0.5f;
+            ImVec2 centre(pos.x + size.x * 0.5f, pos.y + size.y * 0.5f);
+            float angle = (value - 0.5f) * 4.71238898f;
+            float length = radius - WIDGET_GRAB_PADDING;
+            draw_list->AddCircleFilled(centre, radius, frame_col);
+            draw_list->AddLine(centre, ImVec2(centre.x + sinf(angle) * length, centre.y - cosf(angle) * length), grab_col, 3.0f);
+        }
+        return;
+    }
+
+    // Find this frame's batch for the draw list and widget type, or start a new one
+    ImGui_ImplOpenGL3_WidgetBatch* batch = NULL;
+    for (int i = g_WidgetData.BatchCount - 1; i >= 0; i--)
+    {
+        ImGui_ImplOpenGL3_WidgetBatch& candidate = g_WidgetData.Batches[i];
+        if (candidate.DrawList == draw_list && candidate.Type == type)
+        {
+            batch = &candidate;
+            break;
+        }
+    }
+    if (batch == NULL)
+    {
+        batch = ImGui_ImplOpenGL3_NewWidgetBatch(draw_list, type);
+        draw_list->AddCallback(ImGui_ImplOpenGL3_RenderWidgets, (void*)(intptr_t)(g_WidgetData.BatchCount - 1));
+    }
+
+    ImGui_ImplOpenGL3_WidgetInstance instance;
+    instance.Pos = pos;
+    instance.Size = size;
+    instance.Value = value;
+    instance.FrameCol = frame_col;
+    instance.GrabCol = grab_col;
+    batch->Instances.push_back(instance);
+}
+
+static void ImGui_ImplOpenGL3_RenderWidgets(const ImDrawList* parent_list, const ImDrawCmd* cmd)
+{
+    IM_UNUSED(parent_list);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    const ImGui_ImplOpenGL3_WidgetBatch& batch = g_WidgetData.Batches[(int)(intptr_t)cmd->UserCallbackData];
+    if (batch.Instances.Size == 0 || !ImGui_ImplOpenGL3_SetCallbackScissor(cmd))
+        return;
+
+    glUseProgram(g_WidgetShaderHandle);
+    glUniformMatrix4fv(g_WidgetLocationProjMtx, 1, GL_FALSE, &g_ProjMtx[0][0]);
+    glUniform1i(g_WidgetLocationType, (GLint)batch.Type);
+    glUniform1f(g_WidgetLocationGrabSize, ImGui::GetStyle().GrabMinSize);
+    glUniform1f(g_WidgetLocationGrabPadding, WIDGET_GRAB_PADDING);
+    glBindVertexArray(g_WidgetVao);
+    glBindBuffer(GL_ARRAY_BUFFER, g_WidgetInstanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)batch.Instances.size_in_bytes(), (const GLvoid*)batch.Instances.Data, GL_STREAM_DRAW);
+    ImGui_ImplOpenGL3_TrackBuffer(g_WidgetInstanceVbo, (size_t)batch.Instances.size_in_bytes());
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, (void*)0, (GLsizei)batch.Instances.Size);
+    g_FrameStats.InstanceBytes += batch.Instances.size_in_bytes();
+    g_FrameStats.DrawCalls++;
+#else
+    IM_UNUSED(cmd);
+#endif
+}
+
+bool ImGui_ImplOpenGL3_GetPolyline(const ImDrawCmd* cmd, const ImVec2** points, int* points_count, ImU32* col, float* thickness)
+{
+    if (cmd->UserCallback != ImGui_ImplOpenGL3_RenderPolyline)
+        return false;
+    const ImGui_ImplOpenGL3_LineBatch& batch = g_LineData.Batches[(int)(intptr_t)cmd->UserCallbackData];
+    *points = g_LineData.Points.Data + batch.Offset;
+    *points_count = batch.Count;
+    *col = ImGui::ColorConvertFloat4ToU32(batch.Color);
+    *thickness = batch.Thickness;
+    return true;
+}
+
+bool ImGui_ImplOpenGL3_GetWidgets(const ImDrawCmd* cmd, ImGui_ImplOpenGL3_WidgetType* type, const ImGui_ImplOpenGL3_WidgetInstance** instances, int* instances_count)
+{
+    if (cmd->UserCallback != ImGui_ImplOpenGL3_RenderWidgets)
+        return false;
+    const ImGui_ImplOpenGL3_WidgetBatch& batch = g_WidgetData.Batches[(int)(intptr_t)cmd->UserCallbackData];
+    *type = batch.Type;
+    *instances = batch.Instances.Data;
+    *instances_count = batch.Instances.Size;
+    return true;
+}
+
+bool ImGui_ImplOpenGL3_SetPolyline(ImDrawCmd* cmd, const ImVec2* points, int points_count, ImU32 col, float thickness)
+{
+    if (!g_LinesSupported || points_count < 2)
+        return false;
+    cmd->UserCallback = ImGui_ImplOpenGL3_RenderPolyline;
+    cmd->UserCallbackData = (void*)(intptr_t)ImGui_ImplOpenGL3_PushLineBatch(points, points_count, col, thickness);
+    cmd->ElemCount = 0;
+    return true;
+}
+
+bool ImGui_ImplOpenGL3_SetWidgets(ImDrawCmd* cmd, ImGui_ImplOpenGL3_WidgetType type, const ImGui_ImplOpenGL3_WidgetInstance* instances, int instances_count)
+{
+    if (!g_WidgetsSupported || type < 0 || type >= ImGui_ImplOpenGL3_WidgetType_COUNT)
+        return false;
+    // Not looked up by AddWidgetInstance(), as no draw list is built for it
+    ImGui_ImplOpenGL3_WidgetBatch* batch = ImGui_ImplOpenGL3_NewWidgetBatch(NULL, type);
+    batch->Instances.resize(instances_count);
+    if (instances_count > 0)
+        memcpy(batch->Instances.Data, instances, (size_t)instances_count * sizeof(ImGui_ImplOpenGL3_WidgetInstance));
+    cmd->UserCallback = ImGui_ImplOpenGL3_RenderWidgets;
+    cmd->UserCallbackData = (void*)(intptr_t)(g_WidgetData.BatchCount - 1);
+    cmd->ElemCount = 0;
+    return true;
+}
+
 // If you get an error please report on github. You may try different GL context version or GLSL version. See GL<>GLSL version table at the top of this file.
 static bool CheckShader(GLuint handle, const char* desc)
 {
@@ -549,9 +1186,9 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "varying vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "    Frag_UV = UV;\n"
+        "    Frag_UV = UV * " IMGUI_IMPL_OPENGL_VTX_UV_SCALE ";\n"
         "    Frag_Color = Color;\n"
-        "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
+        "    gl_Position = ProjMtx * vec4(Position.xy * " IMGUI_IMPL_OPENGL_VTX_POS_SCALE ",0,1);\n"
         "}\n";
 
     const GLchar* vertex_shader_glsl_130 =
@@ -563,9 +1200,9 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "out vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "    Frag_UV = UV;\n"
+        "    Frag_UV = UV * " IMGUI_IMPL_OPENGL_VTX_UV_SCALE ";\n"
         "    Frag_Color = Color;\n"
-        "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
+        "    gl_Position = ProjMtx * vec4(Position.xy * " IMGUI_IMPL_OPENGL_VTX_POS_SCALE ",0,1);\n"
         "}\n";
 
     const GLchar* vertex_shader_glsl_300_es =
@@ -578,9 +1215,9 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "out vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "    Frag_UV = UV;\n"
+        "    Frag_UV = UV * " IMGUI_IMPL_OPENGL_VTX_UV_SCALE ";\n"
         "    Frag_Color = Color;\n"
-        "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
+        "    gl_Position = ProjMtx * vec4(Position.xy * " IMGUI_IMPL_OPENGL_VTX_POS_SCALE ",0,1);\n"
         "}\n";
 
     const GLchar* vertex_shader_glsl_410_core =
@@ -592,9 +1229,9 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "out vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "    Frag_UV = UV;\n"
+        "    Frag_UV = UV * " IMGUI_IMPL_OPENGL_VTX_UV_SCALE ";\n"
         "    Frag_Color = Color;\n"
-        "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
+        "    gl_Position = ProjMtx * vec4(Position.xy * " IMGUI_IMPL_OPENGL_VTX_POS_SCALE ",0,1);\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_120 =
@@ -693,6 +1330,209 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     glGenBuffers(1, &g_VboHandle);
     glGenBuffers(1, &g_ElementsHandle);
 
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    if (g_LinesSupported)
+    {
+        // Each line segment is drawn as 2 triangles, corners 1, 2, 4 are at the end point and 2, 4, 5 on the positive side
+        const GLchar* line_vertex_shader =
+            "#ifdef GL_ES\n"
+            "    precision highp float;\n"
+            "#endif\n"
+            "uniform mat4 ProjMtx;\n"
+            "uniform sampler2D Points;\n"
+            "uniform int First;\n"
+            "uniform float HalfWidth;\n"
+            "out float Frag_Dist;\n"
+            "vec2 fetch_point(int index)\n"
+            "{\n"
+            "    return texelFetch(Points, ivec2(index & 1023, index >> 10), 0).xy;\n"
+            "}\n"
+            "void main()\n"
+            "{\n"
+            "    int segment = gl_VertexID / 6;\n"
+            "    int corner = gl_VertexID - segment * 6;\n"
+            "    vec2 p0 = fetch_point(First + segment);\n"
+            "    vec2 p1 = fetch_point(First + segment + 1);\n"
+            "    vec2 dir = p1 - p0;\n"
+            "    float len = length(dir);\n"
+            "    dir = len > 0.0 ? dir / len : vec2(1.0, 0.0);\n"
+            "    vec2 normal = vec2(-dir.y, dir.x);\n"
+            "    bool at_end = corner == 1 || corner == 2 || corner == 4;\n"
+            "    float side = (corner == 2 || corner == 4 || corner == 5) ? 1.0 : -1.0;\n"
+            "    vec2 pos = (at_end ? p1 : p0) + normal * side * HalfWidth;\n"
+            "    Frag_Dist = side * HalfWidth;\n"
+            "    gl_Position = ProjMtx * vec4(pos.xy,0,1);\n"
+            "}\n";
+
+        const GLchar* line_fragment_shader =
+            "#ifdef GL_ES\n"
+            "    precision mediump float;\n"
+            "#endif\n"
+            "uniform vec4 Color;\n"
+            "uniform float HalfThickness;\n"
+            "in float Frag_Dist;\n"
+            "out vec4 Out_Color;\n"
+            "void main()\n"
+            "{\n"
+            "    float coverage = clamp(HalfThickness + 0.5 - abs(Frag_Dist), 0.0, 1.0);\n"
+            "    Out_Color = vec4(Color.rgb, Color.a * coverage);\n"
+            "}\n";
+
+        const GLchar* line_vertex_shader_with_version[2] = { g_GlslVersionString, line_vertex_shader };
+        g_LineVertHandle = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(g_LineVertHandle, 2, line_vertex_shader_with_version, NULL);
+        glCompileShader(g_LineVertHandle);
+        CheckShader(g_LineVertHandle, "line vertex shader");
+
+        const GLchar* line_fragment_shader_with_version[2] = { g_GlslVersionString, line_fragment_shader };
+        g_LineFragHandle = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(g_LineFragHandle, 2, line_fragment_shader_with_version, NULL);
+        glCompileShader(g_LineFragHandle);
+        CheckShader(g_LineFragHandle, "line fragment shader");
+
+        g_LineShaderHandle = glCreateProgram();
+        glAttachShader(g_LineShaderHandle, g_LineVertHandle);
+        glAttachShader(g_LineShaderHandle, g_LineFragHandle);
+        glLinkProgram(g_LineShaderHandle);
+        g_LinesSupported = CheckProgram(g_LineShaderHandle, "line shader program");
+
+        g_LineLocationProjMtx = glGetUniformLocation(g_LineShaderHandle, "ProjMtx");
+        g_LineLocationPoints = glGetUniformLocation(g_LineShaderHandle, "Points");
+        g_LineLocationFirst = glGetUniformLocation(g_LineShaderHandle, "First");
+        g_LineLocationHalfWidth = glGetUniformLocation(g_LineShaderHandle, "HalfWidth");
+        g_LineLocationHalfThickness = glGetUniformLocation(g_LineShaderHandle, "HalfThickness");
+        g_LineLocationColor = glGetUniformLocation(g_LineShaderHandle, "Color");
+
+        // Lines don't use any vertex attributes, but core profiles need a vertex array bound to draw
+        glGenVertexArrays(1, &g_LineVao);
+        glGenTextures(1, &g_LineTexture);
+        glBindTexture(GL_TEXTURE_2D, g_LineTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        g_LineTextureRows = 0;
+    }
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    if (g_WidgetsSupported)
+    {
+        // One unit quad per instance, the widget is drawn in the fragment shader in pixel coordinates local to the widget
+        const GLchar* widget_vertex_shader =
+            "uniform mat4 ProjMtx;\n"
+            "in vec2 Corner;\n"
+            "in vec4 Rect;\n"
+            "in float Value;\n"
+            "in vec4 FrameColor;\n"
+            "in vec4 GrabColor;\n"
+            "out vec2 Frag_Local;\n"
+            "flat out vec2 Frag_Size;\n"
+            "flat out float Frag_Value;\n"
+            "flat out vec4 Frag_FrameColor;\n"
+            "flat out vec4 Frag_GrabColor;\n"
+            "void main()\n"
+            "{\n"
+            "    Frag_Local = Corner * Rect.zw;\n"
+            "    Frag_Size = Rect.zw;\n"
+            "    Frag_Value = Value;\n"
+            "    Frag_FrameColor = FrameColor;\n"
+            "    Frag_GrabColor = GrabColor;\n"
+            "    gl_Position = ProjMtx * vec4(Rect.xy + Frag_Local,0,1);\n"
+            "}\n";
+
+        const GLchar* widget_fragment_shader =
+            "uniform int WidgetType;\n"
+            "uniform float GrabSize;\n"
+            "uniform float GrabPadding;\n"
+            "in vec2 Frag_Local;\n"
+            "flat in vec2 Frag_Size;\n"
+            "flat in float Frag_Value;\n"
+            "flat in vec4 Frag_FrameColor;\n"
+            "flat in vec4 Frag_GrabColor;\n"
+            "out vec4 Out_Color;\n"
+            "void main()\n"
+            "{\n"
+            "    vec4 color = Frag_FrameColor;\n"
+            "    if (WidgetType == 0)\n"
+            "    {\n"
+            "        float grab_top = GrabPadding + (1.0 - Frag_Value) * (Frag_Size.y - 2.0 * GrabPadding - GrabSize);\n"
+            "        if (Frag_Local.y >= grab_top && Frag_Local.y < grab_top + GrabSize && Frag_Local.x >= GrabPadding && Frag_Local.x < Frag_Size.x - GrabPadding)\n"
+            "            color = Frag_GrabColor;\n"
+            "    }\n"
+            "    else\n"
+            "    {\n"
+            "        vec2 d = Frag_Local - Frag_Size * 0.5;\n"
+            "        float radius = min(Frag_Size.x, Frag_Size.y) * 0.5;\n"
+            "        float angle = (Frag_Value - 0.5) * 4.71238898;\n"
+            "        vec2 dir = vec2(sin(angle), -cos(angle));\n"
+            "        float along = clamp(dot(d, dir), 0.0, radius - GrabPadding);\n"
+            "        float pointer = clamp(2.0 - length(d - dir * along), 0.0, 1.0);\n"
+            "        color = mix(Frag_FrameColor, Frag_GrabColor, pointer);\n"
+            "        color.a *= clamp(radius - length(d), 0.0, 1.0);\n"
+            "    }\n"
+            "    Out_Color = color;\n"
+            "}\n";
+
+        const GLchar* widget_vertex_shader_with_version[2] = { g_GlslVersionString, widget_vertex_shader };
+        g_WidgetVertHandle = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(g_WidgetVertHandle, 2, widget_vertex_shader_with_version, NULL);
+        glCompileShader(g_WidgetVertHandle);
+        CheckShader(g_WidgetVertHandle, "widget vertex shader");
+
+        const GLchar* widget_fragment_shader_with_version[2] = { g_GlslVersionString, widget_fragment_shader };
+        g_WidgetFragHandle = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(g_WidgetFragHandle, 2, widget_fragment_shader_with_version, NULL);
+        glCompileShader(g_WidgetFragHandle);
+        CheckShader(g_WidgetFragHandle, "widget fragment shader");
+
+        g_WidgetShaderHandle = glCreateProgram();
+        glAttachShader(g_WidgetShaderHandle, g_WidgetVertHandle);
+        glAttachShader(g_WidgetShaderHandle, g_WidgetFragHandle);
+        glLinkProgram(g_WidgetShaderHandle);
+        g_WidgetsSupported = CheckProgram(g_WidgetShaderHandle, "widget shader program");
+
+        g_WidgetLocationProjMtx = glGetUniformLocation(g_WidgetShaderHandle, "ProjMtx");
+        g_WidgetLocationType = glGetUniformLocation(g_WidgetShaderHandle, "WidgetType");
+        g_WidgetLocationGrabSize = glGetUniformLocation(g_WidgetShaderHandle, "GrabSize");
+        g_WidgetLocationGrabPadding = glGetUniformLocation(g_WidgetShaderHandle, "GrabPadding");
+        GLint corner_location = glGetAttribLocation(g_WidgetShaderHandle, "Corner");
+        GLint rect_location = glGetAttribLocation(g_WidgetShaderHandle, "Rect");
+        GLint value_location = glGetAttribLocation(g_WidgetShaderHandle, "Value");
+        GLint frame_color_location = glGetAttribLocation(g_WidgetShaderHandle, "FrameColor");
+        GLint grab_color_location = glGetAttribLocation(g_WidgetShaderHandle, "GrabColor");
+
+        // The vertex array holds the static quad and the per instance attribute layout, only the instance data is uploaded per frame
+        static const float quad_corners[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+        static const unsigned short quad_indices[] = { 0, 1, 2, 0, 2, 3 };
+        glGenVertexArrays(1, &g_WidgetVao);
+        glBindVertexArray(g_WidgetVao);
+        glGenBuffers(1, &g_WidgetQuadVbo);
+        glGenBuffers(1, &g_WidgetQuadElements);
+        glGenBuffers(1, &g_WidgetInstanceVbo);
+        glBindBuffer(GL_ARRAY_BUFFER, g_WidgetQuadVbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(quad_corners), quad_corners, GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_WidgetQuadElements);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(quad_indices), quad_indices, GL_STATIC_DRAW);
+        ImGui_ImplOpenGL3_TrackBuffer(g_WidgetQuadVbo, sizeof(quad_corners));
+        ImGui_ImplOpenGL3_TrackBuffer(g_WidgetQuadElements, sizeof(quad_indices));
+        glEnableVertexAttribArray(corner_location);
+        glVertexAttribPointer(corner_location, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (GLvoid*)0);
+
+        glBindBuffer(GL_ARRAY_BUFFER, g_WidgetInstanceVbo);
+        glEnableVertexAttribArray(rect_location);
+        glEnableVertexAttribArray(value_location);
+        glEnableVertexAttribArray(frame_color_location);
+        glEnableVertexAttribArray(grab_color_location);
+        glVertexAttribPointer(rect_location,        4, GL_FLOAT,         GL_FALSE, sizeof(ImGui_ImplOpenGL3_WidgetInstance), (GLvoid*)IM_OFFSETOF(ImGui_ImplOpenGL3_WidgetInstance, Pos));
+        glVertexAttribPointer(value_location,       1, GL_FLOAT,         GL_FALSE, sizeof(ImGui_ImplOpenGL3_WidgetInstance), (GLvoid*)IM_OFFSETOF(ImGui_ImplOpenGL3_WidgetInstance, Value));
+        glVertexAttribPointer(frame_color_location, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImGui_ImplOpenGL3_WidgetInstance), (GLvoid*)IM_OFFSETOF(ImGui_ImplOpenGL3_WidgetInstance, FrameCol));
+        glVertexAttribPointer(grab_color_location,  4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImGui_ImplOpenGL3_WidgetInstance), (GLvoid*)IM_OFFSETOF(ImGui_ImplOpenGL3_WidgetInstance, GrabCol));
+        glVertexAttribDivisor(rect_location, 1);
+        glVertexAttribDivisor(value_location, 1);
+        glVertexAttribDivisor(frame_color_location, 1);
+        glVertexAttribDivisor(grab_color_location, 1);
+    }
+#endif
+
     ImGui_ImplOpenGL3_CreateFontsTexture();
 
     // Restore modified GL state
@@ -707,13 +1547,43 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
 void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
-    if (g_VboHandle)        { glDeleteBuffers(1, &g_VboHandle); g_VboHandle = 0; }
-    if (g_ElementsHandle)   { glDeleteBuffers(1, &g_ElementsHandle); g_ElementsHandle = 0; }
+    if (g_VboHandle)        { glDeleteBuffers(1, &g_VboHandle); ImGui_ImplOpenGL3_TrackBuffer(g_VboHandle, 0); g_VboHandle = 0; }
+    if (g_ElementsHandle)   { glDeleteBuffers(1, &g_ElementsHandle); ImGui_ImplOpenGL3_TrackBuffer(g_ElementsHandle, 0); g_ElementsHandle = 0; }
     if (g_ShaderHandle && g_VertHandle) { glDetachShader(g_ShaderHandle, g_VertHandle); }
     if (g_ShaderHandle && g_FragHandle) { glDetachShader(g_ShaderHandle, g_FragHandle); }
     if (g_VertHandle)       { glDeleteShader(g_VertHandle); g_VertHandle = 0; }
     if (g_FragHandle)       { glDeleteShader(g_FragHandle); g_FragHandle = 0; }
     if (g_ShaderHandle)     { glDeleteProgram(g_ShaderHandle); g_ShaderHandle = 0; }
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    if (g_LineShaderHandle && g_LineVertHandle) { glDetachShader(g_LineShaderHandle, g_LineVertHandle); }
+    if (g_LineShaderHandle && g_LineFragHandle) { glDetachShader(g_LineShaderHandle, g_LineFragHandle); }
+    if (g_LineVertHandle)   { glDeleteShader(g_LineVertHandle); g_LineVertHandle = 0; }
+    if (g_LineFragHandle)   { glDeleteShader(g_LineFragHandle); g_LineFragHandle = 0; }
+    if (g_LineShaderHandle) { glDeleteProgram(g_LineShaderHandle); g_LineShaderHandle = 0; }
+    if (g_LineVao)          { glDeleteVertexArrays(1, &g_LineVao); g_LineVao = 0; }
+    if (g_LineTexture)      { glDeleteTextures(1, &g_LineTexture); ImGui_ImplOpenGL3_TrackTexture(g_LineTexture, 0); g_LineTexture = 0; g_LineTextureRows = 0; }
+#endif
+    g_LineData.Points.clear();
+    g_LineData.Batches.clear();
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    if (g_UploadPbo)        { glDeleteBuffers(1, &g_UploadPbo); ImGui_ImplOpenGL3_TrackBuffer(g_UploadPbo, 0); g_UploadPbo = 0; }
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    if (g_WidgetShaderHandle && g_WidgetVertHandle) { glDetachShader(g_WidgetShaderHandle, g_WidgetVertHandle); }
+    if (g_WidgetShaderHandle && g_WidgetFragHandle) { glDetachShader(g_WidgetShaderHandle, g_WidgetFragHandle); }
+    if (g_WidgetVertHandle)     { glDeleteShader(g_WidgetVertHandle); g_WidgetVertHandle = 0; }
+    if (g_WidgetFragHandle)     { glDeleteShader(g_WidgetFragHandle); g_WidgetFragHandle = 0; }
+    if (g_WidgetShaderHandle)   { glDeleteProgram(g_WidgetShaderHandle); g_WidgetShaderHandle = 0; }
+    if (g_WidgetVao)            { glDeleteVertexArrays(1, &g_WidgetVao); g_WidgetVao = 0; }
+    if (g_WidgetQuadVbo)        { glDeleteBuffers(1, &g_WidgetQuadVbo); ImGui_ImplOpenGL3_TrackBuffer(g_WidgetQuadVbo, 0); g_WidgetQuadVbo = 0; }
+    if (g_WidgetQuadElements)   { glDeleteBuffers(1, &g_WidgetQuadElements); ImGui_ImplOpenGL3_TrackBuffer(g_WidgetQuadElements, 0); g_WidgetQuadElements = 0; }
+    if (g_WidgetInstanceVbo)    { glDeleteBuffers(1, &g_WidgetInstanceVbo); ImGui_ImplOpenGL3_TrackBuffer(g_WidgetInstanceVbo, 0); g_WidgetInstanceVbo = 0; }
+#endif
+    for (int i = 0; i < g_WidgetData.Batches.Size; i++)
+        g_WidgetData.Batches[i].Instances.clear();
+    g_WidgetData.Batches.clear();
+    g_WidgetData.BatchCount = 0;
 
     ImGui_ImplOpenGL3_DestroyFontsTexture();
 }
@@ -36,6 +36,88 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 
+// Font atlas updates (vstimgui addition)
+// Uploads rows y to y + height of the font atlas to the font texture, after glyphs were added to the atlas's RGBA pixels
+// since it was uploaded. If the atlas changed size, the texture is created again instead and the atlas texture id changes.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_UpdateFontsTexture(int y, int height);
+
+// Texture helpers (vstimgui addition)
+// Creates a texture from RGBA 8 bit pixels for use with ImGui::Image() and ImDrawList::AddImage(). The pixels are copied
+// through a pixel buffer object with GL 3.0 / ES 3, and only need to be valid during the call.
+IMGUI_IMPL_API ImTextureID ImGui_ImplOpenGL3_CreateTexture(const void* pixels, int width, int height);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyTexture(ImTextureID texture);
+
+// Streaming ring textures (vstimgui addition)
+// A texture of line_count lines of line_length RGBA pixels with a circular write head, for scrolling displays like
+// spectrograms. Only new lines are uploaded, through alternating pixel buffer objects with GL 3.0 / ES 3, and the
+// wrap around is handled with texture coordinates when drawing, so the contents never need to be moved.
+// The oldest line is drawn at the left (horizontal) or bottom (vertical) and the newest at the right or top.
+// With horizontal scrolling the first pixel of a line is drawn at the bottom, with vertical scrolling at the left.
+struct ImGui_ImplOpenGL3_RingTexture;
+IMGUI_IMPL_API ImGui_ImplOpenGL3_RingTexture* ImGui_ImplOpenGL3_CreateRingTexture(int line_length, int line_count);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyRingTexture(ImGui_ImplOpenGL3_RingTexture* ring);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_PushRingTextureLines(ImGui_ImplOpenGL3_RingTexture* ring, const ImU32* pixels, int lines);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_AddRingTextureImage(ImDrawList* draw_list, const ImGui_ImplOpenGL3_RingTexture* ring, const ImVec2& p_min, const ImVec2& p_max, bool horizontal);
+
+// GPU polyline rendering (vstimgui addition)
+// Draws an anti-aliased polyline through an ImDrawList callback. The points are uploaded as they are, once per frame,
+// and expanded into strips in the vertex shader, so dense curves don't need any CPU tessellation.
+// Points are copied and only need to be valid during the call. Falls back to ImDrawList::AddPolyline() with GL ES 2 / GLSL < 130.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_AddPolyline(ImDrawList* draw_list, const ImVec2* points, int points_count, ImU32 col, float thickness);
+
+// Instanced widget rendering (vstimgui addition)
+// Widgets of the same type added to the same draw list during a frame are drawn with a single instanced draw call,
+// at the position in the draw list where the first of them was added. Only the position, size, value (0 - 1) and
+// colours of each widget are uploaded, the widget itself is drawn in the fragment shader.
+// Falls back to regular ImDrawList primitives if the context doesn't support instanced arrays (GL 3.3).
+enum ImGui_ImplOpenGL3_WidgetType
+{
+    ImGui_ImplOpenGL3_WidgetType_VSlider,   // Frame with a grab of style.GrabMinSize, like ImGui::VSliderFloat()
+    ImGui_ImplOpenGL3_WidgetType_Knob,      // Round knob with a pointer going from -135 to 135 degrees
+    ImGui_ImplOpenGL3_WidgetType_COUNT
+};
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_AddWidgetInstance(ImDrawList* draw_list, ImGui_ImplOpenGL3_WidgetType type, const ImVec2& pos, const ImVec2& size, float value, ImU32 frame_col, ImU32 grab_col);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_HasInstancedWidgets();    // False if widgets fall back to regular primitives
+
+// Draw callback contents (vstimgui addition)
+// The Get functions read back the polyline or widgets a draw callback of this backend draws, e.g. to store draw data
+// in a capture, and return false for any other command. The data stays valid until the next NewFrame().
+// The Set functions turn a command of draw data not built by ImGui into one drawing a copy of the given polyline or
+// widgets, e.g. to replay a capture. Call after NewFrame(), they return false if the context can't draw them.
+struct ImGui_ImplOpenGL3_WidgetInstance
+{
+    ImVec2  Pos;
+    ImVec2  Size;
+    float   Value;
+    ImU32   FrameCol;
+    ImU32   GrabCol;
+};
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_GetPolyline(const ImDrawCmd* cmd, const ImVec2** points, int* points_count, ImU32* col, float* thickness);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_GetWidgets(const ImDrawCmd* cmd, ImGui_ImplOpenGL3_WidgetType* type, const ImGui_ImplOpenGL3_WidgetInstance** instances, int* instances_count);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetPolyline(ImDrawCmd* cmd, const ImVec2* points, int points_count, ImU32 col, float thickness);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetWidgets(ImDrawCmd* cmd, ImGui_ImplOpenGL3_WidgetType type, const ImGui_ImplOpenGL3_WidgetInstance* instances, int instances_count);
+
+// Statistics from the last call to ImGui_ImplOpenGL3_RenderDrawData() (vstimgui addition)
+struct ImGui_ImplOpenGL3_FrameStats
+{
+    int     VertexBytes;        // Vertex and polyline point data uploaded
+    int     IndexBytes;         // Index data uploaded
+    int     InstanceBytes;      // Per instance widget data uploaded
+    int     TextureBytes;       // Texture data uploaded since the previous frame was rendered
+    int     DrawCalls;
+};
+IMGUI_IMPL_API const ImGui_ImplOpenGL3_FrameStats& ImGui_ImplOpenGL3_GetFrameStats();
+
+// Estimated GPU memory of the calling thread's backend state (vstimgui addition)
+// Buffers and textures created by the backend, including ImGui_ImplOpenGL3_CreateTexture() and ring textures, at the
+// size they were last allocated with. The framebuffer and any driver overhead are not included.
+struct ImGui_ImplOpenGL3_MemoryStats
+{
+    size_t  BufferBytes;
+    size_t  TextureBytes;
+};
+IMGUI_IMPL_API const ImGui_ImplOpenGL3_MemoryStats& ImGui_ImplOpenGL3_GetMemoryStats();
+
 // Specific OpenGL ES versions
 //#define IMGUI_IMPL_OPENGL_ES2     // Auto-detected on Emscripten
 //#define IMGUI_IMPL_OPENGL_ES3     // Auto-detected on iOS/Android
@@ -0,0 +1,691 @@
+// dear imgui: Renderer Backend rasterizing on the CPU into a memory framebuffer (vstimgui addition)
+// See imgui_impl_soft.h for what is implemented.
+
+// CHANGELOG
+//  vstimgui: Initial version with tile binning, SSE2 span filling and a pool of worker threads.
+//  vstimgui: Round colours half up with SSE2 as well, like without. Added ImGui_ImplSoft_UpdateFontsTexture() and ring textures.
+
+#include "imgui.h"
+#include "imgui_impl_soft.h"
+#include <math.h>
+#include <string.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define IMGUI_IMPL_SOFT_USE_SSE2
+#endif
+
+// Tiles are a multiple of 4 pixels wide, so a block of 4 pixels never crosses into a tile drawn by another thread
+static constexpr int TILE_SIZE = 64;
+
+struct ImGui_ImplSoft_Texture
+{
+    int     Width;
+    int     Height;
+    ImU32*  Pixels;
+};
+
+// Everything needed to rasterize a triangle, set up once and shared by all the tiles it touches
+struct ImGui_ImplSoft_Triangle
+{
+    int     MinX, MinY, MaxX, MaxY;         // Pixel bounds clipped to the clip rect, max exclusive
+    float   EdgeA[3], EdgeB[3], EdgeC[3];   // Edge functions A * x + B * y + C, positive inside
+    bool    TopLeft[3];                     // Pixel centres exactly on this edge belong to this triangle
+    float   Plane[6][3];                    // R, G, B, A (0 - 255) and U, V (in texels) as a * x + b * y + c
+    const ImGui_ImplSoft_Texture* Texture;
+    bool    Flat;                           // Same colour and texel over the whole triangle, i.e. solid fills
+    ImU32   FlatColor;                      // Texel modulated by the vertex colour if Flat
+};
+
+struct ImGui_ImplSoft_RingTexture
+{
+    ImGui_ImplSoft_Texture* Texture;
+    int     LineLength;
+    int     LineCount;
+    int     Head;                           // Row the next line is written to, i.e. the oldest one
+};
+
+struct ImGui_ImplSoft_Data
+{
+    ImVector<ImGui_ImplSoft_Triangle> Triangles;
+    ImVector<int>   TileOffsets;            // Start of each tile's triangles in TileTriangles, plus the total at the end
+    ImVector<int>   TileCursors;
+    ImVector<int>   TileTriangles;
+    ImVector<int>   ActiveTiles;
+    int             TilesX{0};
+    ImU32*          Pixels{nullptr};
+    int             Width{0}, Height{0}, Stride{0};
+
+    ImGui_ImplSoft_Texture* FontTexture{nullptr};
+    ImGui_ImplSoft_FrameStats Stats{};
+
+    // Each frame the workers and the rendering thread take tiles from NextTile until there are none left
+    std::vector<std::thread> Workers;
+    std::mutex      Mutex;
+    std::condition_variable StartCondition;
+    std::condition_variable DoneCondition;
+    unsigned int    Frame{0};
+    int             WorkersBusy{0};
+    bool            Quit{false};
+    std::atomic<int> NextTile{0};
+};
+
+thread_local static ImGui_ImplSoft_Data* g_Data = nullptr;
+
+template<typename T> static inline T ImGui_ImplSoft_Min(T a, T b) { return a < b ? a : b; }
+template<typename T> static inline T ImGui_ImplSoft_Max(T a, T b) { return a > b ? a : b; }
+
+static inline void ImGui_ImplSoft_ColorToFloat(ImU32 col, float* out)
+{
+    out[0] = (float)((col >> IM_COL32_R_SHIFT) & 0xFF);
+    out[1] = (float)((col >> IM_COL32_G_SHIFT) & 0xFF);
+    out[2] = (float)((col >> IM_COL32_B_SHIFT) & 0xFF);
+    out[3] = (float)((col >> IM_COL32_A_SHIFT) & 0xFF);
+}
+
+static inline int ImGui_ImplSoft_TexelIndex(const ImGui_ImplSoft_Texture* tex, float u, float v)
+{
+    int x = (int)(u < 0.0f ? 0.0f : u);
+    int y = (int)(v < 0.0f ? 0.0f : v);
+    x = x < tex->Width ? x : tex->Width - 1;
+    y = y < tex->Height ? y : tex->Height - 1;
+    return y * tex->Width + x;
+}
+
+static inline ImU32 ImGui_ImplSoft_Modulate(ImU32 a, ImU32 b)
+{
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= ((((a >> shift) & 0xFF) * ((b >> shift) & 0xFF) + 127) / 255) << shift;
+    return out;
+}
+
+static bool ImGui_ImplSoft_SetupTriangle(ImGui_ImplSoft_Triangle& tri, const ImDrawVert* v[3], const ImVec2& clip_off, const ImVec2& clip_scale,
+                                         const int clip[4], const ImGui_ImplSoft_Texture* tex)
+{
+    ImVec2 p[3];
+    for (int i = 0; i < 3; i++)
+        p[i] = ImVec2((v[i]->pos.x - clip_off.x) * clip_scale.x, (v[i]->pos.y - clip_off.y) * clip_scale.y);
+    float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+    if (area == 0.0f)
+        return false;
+
+    float min_x = p[0].x, max_x = p[0].x, min_y = p[0].y, max_y = p[0].y;
+    for (int i = 1; i < 3; i++)
+    {
+        min_x = p[i].x < min_x ? p[i].x : min_x;
+        max_x = p[i].x > max_x ? p[i].x : max_x;
+        min_y = p[i].y < min_y ? p[i].y : min_y;
+        max_y = p[i].y > max_y ? p[i].y : max_y;
+    }
+    tri.MinX = ImGui_ImplSoft_Max((int)floorf(min_x), clip[0]);
+    tri.MinY = ImGui_ImplSoft_Max((int)floorf(min_y), clip[1]);
+    tri.MaxX = ImGui_ImplSoft_Min((int)ceilf(max_x), clip[2]);
+    tri.MaxY = ImGui_ImplSoft_Min((int)ceilf(max_y), clip[3]);
+    if (tri.MinX >= tri.MaxX || tri.MinY >= tri.MaxY)
+        return false;
+
+    // Edge i goes from vertex i to the next one and is opposite vertex i + 2. Triangles come in both windings,
+    // the edges are flipped as needed so the inside is always positive.
+    float sign = area > 0.0f ? 1.0f : -1.0f;
+    area *= sign;
+    for (int i = 0; i < 3; i++)
+    {
+        const ImVec2& a = p[i];
+        const ImVec2& b = p[(i + 1) % 3];
+        tri.EdgeA[i] = (a.y - b.y) * sign;
+        tri.EdgeB[i] = (b.x - a.x) * sign;
+        tri.EdgeC[i] = -(tri.EdgeA[i] * a.x + tri.EdgeB[i] * a.y);
+        // Of two triangles sharing an edge, exactly one sees it as top-left, so no pixel is blended twice
+        tri.TopLeft[i] = tri.EdgeA[i] > 0.0f || (tri.EdgeA[i] == 0.0f && tri.EdgeB[i] > 0.0f);
+    }
+
+    float attributes[3][6];
+    for (int i = 0; i < 3; i++)
+    {
+        ImGui_ImplSoft_ColorToFloat(v[i]->col, attributes[i]);
+        attributes[i][4] = v[i]->uv.x * tex->Width;
+        attributes[i][5] = v[i]->uv.y * tex->Height;
+    }
+    // The weight of vertex i + 2 is edge function i over the area
+    float inv_area = 1.0f / area;
+    for (int n = 0; n < 6; n++)
+    {
+        float f0 = attributes[2][n], f1 = attributes[0][n], f2 = attributes[1][n];
+        tri.Plane[n][0] = (f0 * tri.EdgeA[0] + f1 * tri.EdgeA[1] + f2 * tri.EdgeA[2]) * inv_area;
+        tri.Plane[n][1] = (f0 * tri.EdgeB[0] + f1 * tri.EdgeB[1] + f2 * tri.EdgeB[2]) * inv_area;
+        tri.Plane[n][2] = (f0 * tri.EdgeC[0] + f1 * tri.EdgeC[1] + f2 * tri.EdgeC[2]) * inv_area;
+    }
+
+    // If all corners are within the same texel, so is everything in between
+    int texel = ImGui_ImplSoft_TexelIndex(tex, attributes[0][4], attributes[0][5]);
+    tri.Texture = tex;
+    tri.Flat = v[0]->col == v[1]->col && v[0]->col == v[2]->col &&
+               texel == ImGui_ImplSoft_TexelIndex(tex, attributes[1][4], attributes[1][5]) &&
+               texel == ImGui_ImplSoft_TexelIndex(tex, attributes[2][4], attributes[2][5]);
+    tri.FlatColor = tri.Flat ? ImGui_ImplSoft_Modulate(tex->Pixels[texel], v[0]->col) : 0;
+    return true;
+}
+
+#ifdef IMGUI_IMPL_SOFT_USE_SSE2
+static inline void ImGui_ImplSoft_Unpack(__m128i c, __m128& r, __m128& g, __m128& b, __m128& a)
+{
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    r = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c, IM_COL32_R_SHIFT), mask));
+    g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c, IM_COL32_G_SHIFT), mask));
+    b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c, IM_COL32_B_SHIFT), mask));
+    a = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c, IM_COL32_A_SHIFT), mask));
+}
+
+static inline __m128i ImGui_ImplSoft_Pack(__m128 r, __m128 g, __m128 b, __m128 a)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    // Rounded half up, the same as without SSE2. _mm_cvtps_epi32() would round half to even and be off by one on ties
+    __m128i ri = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(r, zero), max), half));
+    __m128i gi = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(g, zero), max), half));
+    __m128i bi = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(b, zero), max), half));
+    __m128i ai = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(a, zero), max), half));
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(ri, IM_COL32_R_SHIFT), _mm_slli_epi32(gi, IM_COL32_G_SHIFT)),
+                        _mm_or_si128(_mm_slli_epi32(bi, IM_COL32_B_SHIFT), _mm_slli_epi32(ai, IM_COL32_A_SHIFT)));
+}
+
+// Fills pixels [x0, x1) of a row, 4 at a time. The edge functions decide which pixels are covered, the span only
+// needs to contain them.
+static void ImGui_ImplSoft_FillSpan(const ImGui_ImplSoft_Triangle& tri, ImU32* row, int x0, int x1, float py)
+{
+    const __m128 lane_offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 px = _mm_add_ps(_mm_set1_ps((float)x0), lane_offsets);
+
+    // Edges and attributes are evaluated from scratch for each block rather than stepped, so rounding doesn't add up
+    // along the span and coverage is exactly the same as without SSE2
+    __m128 edge_a[3], edge_row[3], top_left[3];
+    for (int i = 0; i < 3; i++)
+    {
+        edge_a[i] = _mm_set1_ps(tri.EdgeA[i]);
+        edge_row[i] = _mm_set1_ps(tri.EdgeB[i] * py + tri.EdgeC[i]);
+        top_left[i] = _mm_castsi128_ps(_mm_set1_epi32(tri.TopLeft[i] ? -1 : 0));
+    }
+
+    __m128 attr_a[6], attr_row[6];
+    __m128 flat_r, flat_g, flat_b, flat_a;
+    if (tri.Flat)
+    {
+        ImGui_ImplSoft_Unpack(_mm_set1_epi32((int)tri.FlatColor), flat_r, flat_g, flat_b, flat_a);
+    }
+    else
+    {
+        for (int n = 0; n < 6; n++)
+        {
+            attr_a[n] = _mm_set1_ps(tri.Plane[n][0]);
+            attr_row[n] = _mm_set1_ps(tri.Plane[n][1] * py + tri.Plane[n][2]);
+        }
+    }
+    const __m128 px_step = _mm_set1_ps(4.0f);
+    const ImGui_ImplSoft_Texture* tex = tri.Texture;
+    const __m128 tex_max_u = _mm_set1_ps((float)(tex->Width - 1));
+    const __m128 tex_max_v = _mm_set1_ps((float)(tex->Height - 1));
+    const __m128 inv_255 = _mm_set1_ps(1.0f / 255.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (int x = x0; x < x1; x += 4)
+    {
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int i = 0; i < 3; i++)
+        {
+            __m128 edge = _mm_add_ps(_mm_mul_ps(edge_a[i], px), edge_row[i]);
+            __m128 covered = _mm_or_ps(_mm_cmpgt_ps(edge, zero), _mm_and_ps(_mm_cmpeq_ps(edge, zero), top_left[i]));
+            inside = _mm_and_ps(inside, covered);
+        }
+        bool partial = x + 4 > x1;
+        if (partial)
+            inside = _mm_and_ps(inside, _mm_cmplt_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps((float)(x1 - x))));
+
+        if (_mm_movemask_ps(inside) != 0)
+        {
+            __m128 src_r, src_g, src_b, src_a;
+            if (tri.Flat)
+            {
+                src_r = flat_r;
+                src_g = flat_g;
+                src_b = flat_b;
+                src_a = flat_a;
+            }
+            else
+            {
+                __m128 attr[6];
+                for (int n = 0; n < 6; n++)
+                    attr[n] = _mm_add_ps(_mm_mul_ps(attr_a[n], px), attr_row[n]);
+                alignas(16) int tex_x[4], tex_y[4];
+                _mm_store_si128((__m128i*)tex_x, _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(attr[4], zero), tex_max_u)));
+                _mm_store_si128((__m128i*)tex_y, _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(attr[5], zero), tex_max_v)));
+                const ImU32* texels = tex->Pixels;
+                int w = tex->Width;
+                __m128i texel = _mm_set_epi32((int)texels[tex_y[3] * w + tex_x[3]], (int)texels[tex_y[2] * w + tex_x[2]],
+                                              (int)texels[tex_y[1] * w + tex_x[1]], (int)texels[tex_y[0] * w + tex_x[0]]);
+                ImGui_ImplSoft_Unpack(texel, src_r, src_g, src_b, src_a);
+                src_r = _mm_mul_ps(_mm_mul_ps(src_r, attr[0]), inv_255);
+                src_g = _mm_mul_ps(_mm_mul_ps(src_g, attr[1]), inv_255);
+                src_b = _mm_mul_ps(_mm_mul_ps(src_b, attr[2]), inv_255);
+                src_a = _mm_mul_ps(_mm_mul_ps(src_a, attr[3]), inv_255);
+            }
+
+            // The last few pixels of a span can be at the end of the framebuffer, only touch the ones in the span
+            alignas(16) ImU32 tail[4];
+            ImU32* dst_ptr = row + x;
+            if (partial)
+            {
+                memcpy(tail, dst_ptr, (size_t)(x1 - x) * sizeof(ImU32));
+                dst_ptr = tail;
+            }
+            __m128i dst = _mm_loadu_si128((const __m128i*)dst_ptr);
+            __m128 dst_r, dst_g, dst_b, dst_a;
+            ImGui_ImplSoft_Unpack(dst, dst_r, dst_g, dst_b, dst_a);
+
+            // Same as glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA)
+            __m128 alpha = _mm_mul_ps(src_a, inv_255);
+            __m128 inv_alpha = _mm_sub_ps(one, alpha);
+            __m128i blended = ImGui_ImplSoft_Pack(_mm_add_ps(dst_r, _mm_mul_ps(_mm_sub_ps(src_r, dst_r), alpha)),
+                                                  _mm_add_ps(dst_g, _mm_mul_ps(_mm_sub_ps(src_g, dst_g), alpha)),
+                                                  _mm_add_ps(dst_b, _mm_mul_ps(_mm_sub_ps(src_b, dst_b), alpha)),
+                                                  _mm_add_ps(src_a, _mm_mul_ps(dst_a, inv_alpha)));
+            __m128i mask = _mm_castps_si128(inside);
+            _mm_storeu_si128((__m128i*)dst_ptr, _mm_or_si128(_mm_and_si128(mask, blended), _mm_andnot_si128(mask, dst)));
+            if (partial)
+                memcpy(row + x, tail, (size_t)(x1 - x) * sizeof(ImU32));
+        }
+
+        px = _mm_add_ps(px, px_step);
+    }
+}
+#else
+static void ImGui_ImplSoft_FillSpan(const ImGui_ImplSoft_Triangle& tri, ImU32* row, int x0, int x1, float py)
+{
+    for (int x = x0; x < x1; x++)
+    {
+        float px = (float)x + 0.5f;
+        bool inside = true;
+        for (int i = 0; i < 3 && inside; i++)
+        {
+            float e = tri.EdgeA[i] * px + (tri.EdgeB[i] * py + tri.EdgeC[i]);
+            inside = e > 0.0f || (e == 0.0f && tri.TopLeft[i]);
+        }
+        if (!inside)
+            continue;
+
+        float src[4];
+        if (tri.Flat)
+        {
+            ImGui_ImplSoft_ColorToFloat(tri.FlatColor, src);
+        }
+        else
+        {
+            float attr[6];
+            for (int n = 0; n < 6; n++)
+                attr[n] = tri.Plane[n][0] * px + (tri.Plane[n][1] * py + tri.Plane[n][2]);
+            ImGui_ImplSoft_ColorToFloat(tri.Texture->Pixels[ImGui_ImplSoft_TexelIndex(tri.Texture, attr[4], attr[5])], src);
+            for (int c = 0; c < 4; c++)
+                src[c] *= attr[c] * (1.0f / 255.0f);
+        }
+        float dst[4];
+        ImGui_ImplSoft_ColorToFloat(row[x], dst);
+        float alpha = src[3] * (1.0f / 255.0f);
+        float out[4] = {dst[0] + (src[0] - dst[0]) * alpha, dst[1] + (src[1] - dst[1]) * alpha,
+                        dst[2] + (src[2] - dst[2]) * alpha, src[3] + dst[3] * (1.0f - alpha)};
+        ImU32 col = 0;
+        for (int c = 0; c < 4; c++)
+        {
+            float v = out[c] < 0.0f ? 0.0f : (out[c] > 255.0f ? 255.0f : out[c]);
+            col |= (ImU32)(v + 0.5f) << (c * 8);
+        }
+        row[x] = col;
+    }
+}
+#endif
+
+static void ImGui_ImplSoft_RasterizeTriangle(const ImGui_ImplSoft_Data* bd, const ImGui_ImplSoft_Triangle& tri, int tile_x0, int tile_y0, int tile_x1, int tile_y1)
+{
+    int x_min = ImGui_ImplSoft_Max(tri.MinX, tile_x0);
+    int x_max = ImGui_ImplSoft_Min(tri.MaxX, tile_x1);
+    int y_min = ImGui_ImplSoft_Max(tri.MinY, tile_y0);
+    int y_max = ImGui_ImplSoft_Min(tri.MaxY, tile_y1);
+    for (int y = y_min; y < y_max; y++)
+    {
+        // Narrow the span down to where each edge function can be positive at this row, ImGui draws lots of thin
+        // and diagonal triangles (anti-aliasing fringes, rounded corners) whose bounding box is mostly empty
+        float py = (float)y + 0.5f;
+        float span_x0 = (float)x_min;
+        float span_x1 = (float)x_max;
+        for (int i = 0; i < 3; i++)
+        {
+            float a = tri.EdgeA[i];
+            float r = tri.EdgeB[i] * py + tri.EdgeC[i];
+            if (a > 0.0f)
+                span_x0 = ImGui_ImplSoft_Max(span_x0, -r / a - 0.5f);
+            else if (a < 0.0f)
+                span_x1 = ImGui_ImplSoft_Min(span_x1, -r / a + 0.5f);
+            else if (r < 0.0f)
+                span_x1 = span_x0;
+        }
+        if (span_x0 >= span_x1)
+            continue;
+        int x0 = ImGui_ImplSoft_Max(x_min, (int)floorf(span_x0));
+        int x1 = ImGui_ImplSoft_Min(x_max, (int)ceilf(span_x1) + 1);
+        if (x0 < x1)
+            ImGui_ImplSoft_FillSpan(tri, bd->Pixels + (size_t)y * bd->Stride, x0, x1, py);
+    }
+}
+
+static void ImGui_ImplSoft_RasterizeTiles(ImGui_ImplSoft_Data* bd)
+{
+    while (true)
+    {
+        int active = bd->NextTile.fetch_add(1);
+        if (active >= bd->ActiveTiles.Size)
+            break;
+        int tile = bd->ActiveTiles[active];
+        int x0 = (tile % bd->TilesX) * TILE_SIZE;
+        int y0 = (tile / bd->TilesX) * TILE_SIZE;
+        int x1 = ImGui_ImplSoft_Min(x0 + TILE_SIZE, bd->Width);
+        int y1 = ImGui_ImplSoft_Min(y0 + TILE_SIZE, bd->Height);
+        for (int n = bd->TileOffsets[tile]; n < bd->TileOffsets[tile + 1]; n++)
+            ImGui_ImplSoft_RasterizeTriangle(bd, bd->Triangles[bd->TileTriangles[n]], x0, y0, x1, y1);
+    }
+}
+
+static void ImGui_ImplSoft_WorkerLoop(ImGui_ImplSoft_Data* bd)
+{
+    unsigned int frame = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(bd->Mutex);
+            bd->StartCondition.wait(lock, [bd, frame]() { return bd->Quit || bd->Frame != frame; });
+            if (bd->Quit)
+                return;
+            frame = bd->Frame;
+        }
+        ImGui_ImplSoft_RasterizeTiles(bd);
+        {
+            std::scoped_lock<std::mutex> lock(bd->Mutex);
+            bd->WorkersBusy--;
+        }
+        bd->DoneCondition.notify_one();
+    }
+}
+
+bool ImGui_ImplSoft_Init(int thread_count)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IM_ASSERT(g_Data == nullptr && "Already initialized a renderer backend!");
+    ImGui_ImplSoft_Data* bd = new ImGui_ImplSoft_Data();
+    g_Data = bd;
+    io.BackendRendererName = "imgui_impl_soft";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    if (thread_count <= 0)
+        thread_count = (int)std::thread::hardware_concurrency();
+    for (int i = 1; i < thread_count; i++)
+        bd->Workers.emplace_back(ImGui_ImplSoft_WorkerLoop, bd);
+    return true;
+}
+
+void ImGui_ImplSoft_Shutdown()
+{
+    ImGui_ImplSoft_Data* bd = g_Data;
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    {
+        std::scoped_lock<std::mutex> lock(bd->Mutex);
+        bd->Quit = true;
+    }
+    bd->StartCondition.notify_all();
+    for (std::thread& worker : bd->Workers)
+        worker.join();
+
+    if (bd->FontTexture)
+    {
+        ImGui_ImplSoft_DestroyTexture((ImTextureID)bd->FontTexture);
+        ImGui::GetIO().Fonts->SetTexID(0);
+    }
+    ImGui::GetIO().BackendRendererName = nullptr;
+    delete bd;
+    g_Data = nullptr;
+}
+
+void ImGui_ImplSoft_NewFrame()
+{
+    ImGui_ImplSoft_Data* bd = g_Data;
+    if (bd->FontTexture == nullptr)
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        unsigned char* pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        bd->FontTexture = (ImGui_ImplSoft_Texture*)ImGui_ImplSoft_CreateTexture(pixels, width, height);
+        io.Fonts->SetTexID((ImTextureID)bd->FontTexture);
+    }
+}
+
+void ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, ImU32* pixels, int width, int height, int stride)
+{
+    ImGui_ImplSoft_Data* bd = g_Data;
+    bd->Stats = ImGui_ImplSoft_FrameStats();
+    bd->Stats.Threads = (int)bd->Workers.size() + 1;
+    if (width <= 0 || height <= 0)
+        return;
+    bd->Pixels = pixels;
+    bd->Width = width;
+    bd->Height = height;
+    bd->Stride = stride;
+
+    // Set up all triangles first, calling user callbacks in order
+    ImVec2 clip_off = draw_data->DisplayPos;
+    ImVec2 clip_scale = draw_data->FramebufferScale;
+    bd->Triangles.resize(0);
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data;
+        const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data;
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                // There is no render state to reset
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+            const ImGui_ImplSoft_Texture* tex = (const ImGui_ImplSoft_Texture*)pcmd->TextureId;
+            if (tex == nullptr)
+                continue;
+            int clip[4] = {ImGui_ImplSoft_Max((int)((pcmd->ClipRect.x - clip_off.x) * clip_scale.x), 0),
+                           ImGui_ImplSoft_Max((int)((pcmd->ClipRect.y - clip_off.y) * clip_scale.y), 0),
+                           ImGui_ImplSoft_Min((int)((pcmd->ClipRect.z - clip_off.x) * clip_scale.x), width),
+                           ImGui_ImplSoft_Min((int)((pcmd->ClipRect.w - clip_off.y) * clip_scale.y), height)};
+            if (clip[0] >= clip[2] || clip[1] >= clip[3])
+                continue;
+
+            const ImDrawIdx* idx = idx_buffer + pcmd->IdxOffset;
+            const ImDrawVert* vtx = vtx_buffer + pcmd->VtxOffset;
+            for (unsigned int i = 0; i + 2 < pcmd->ElemCount; i += 3)
+            {
+                const ImDrawVert* v[3] = {vtx + idx[i], vtx + idx[i + 1], vtx + idx[i + 2]};
+                bd->Triangles.resize(bd->Triangles.Size + 1);
+                if (!ImGui_ImplSoft_SetupTriangle(bd->Triangles.back(), v, clip_off, clip_scale, clip, tex))
+                    bd->Triangles.pop_back();
+            }
+        }
+    }
+
+    // Bin triangles to tiles with a counting sort, which keeps them in draw order within each tile
+    bd->TilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    int tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+    int tile_count = bd->TilesX * tiles_y;
+    bd->TileOffsets.resize(tile_count + 1);
+    memset(bd->TileOffsets.Data, 0, (size_t)bd->TileOffsets.size_in_bytes());
+    for (const ImGui_ImplSoft_Triangle& tri : bd->Triangles)
+        for (int ty = tri.MinY / TILE_SIZE; ty <= (tri.MaxY - 1) / TILE_SIZE; ty++)
+            for (int tx = tri.MinX / TILE_SIZE; tx <= (tri.MaxX - 1) / TILE_SIZE; tx++)
+                bd->TileOffsets[ty * bd->TilesX + tx + 1]++;
+    bd->ActiveTiles.resize(0);
+    for (int tile = 0; tile < tile_count; tile++)
+    {
+        if (bd->TileOffsets[tile + 1] > 0)
+            bd->ActiveTiles.push_back(tile);
+        bd->TileOffsets[tile + 1] += bd->TileOffsets[tile];
+    }
+    bd->TileCursors.resize(tile_count);
+    memcpy(bd->TileCursors.Data, bd->TileOffsets.Data, (size_t)bd->TileCursors.size_in_bytes());
+    bd->TileTriangles.resize(bd->TileOffsets[tile_count]);
+    for (int n = 0; n < bd->Triangles.Size; n++)
+    {
+        const ImGui_ImplSoft_Triangle& tri = bd->Triangles[n];
+        for (int ty = tri.MinY / TILE_SIZE; ty <= (tri.MaxY - 1) / TILE_SIZE; ty++)
+            for (int tx = tri.MinX / TILE_SIZE; tx <= (tri.MaxX - 1) / TILE_SIZE; tx++)
+                bd->TileTriangles[bd->TileCursors[ty * bd->TilesX + tx]++] = n;
+    }
+    bd->Stats.Triangles = bd->Triangles.Size;
+    bd->Stats.BinnedTriangles = bd->TileTriangles.Size;
+    bd->Stats.Tiles = bd->ActiveTiles.Size;
+
+    // Rasterize, with the workers if there is more than one tile to share
+    bd->NextTile = 0;
+    bool parallel = !bd->Workers.empty() && bd->ActiveTiles.Size > 1;
+    if (parallel)
+    {
+        {
+            std::scoped_lock<std::mutex> lock(bd->Mutex);
+            bd->Frame++;
+            bd->WorkersBusy = (int)bd->Workers.size();
+        }
+        bd->StartCondition.notify_all();
+    }
+    ImGui_ImplSoft_RasterizeTiles(bd);
+    if (parallel)
+    {
+        std::unique_lock<std::mutex> lock(bd->Mutex);
+        bd->DoneCondition.wait(lock, [bd]() { return bd->WorkersBusy == 0; });
+    }
+}
+
+void ImGui_ImplSoft_UpdateFontsTexture(int y, int height)
+{
+    // Nothing to update before the texture is created with the whole atlas
+    ImGui_ImplSoft_Data* bd = g_Data;
+    if (bd->FontTexture == nullptr)
+        return;
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels;
+    int atlas_width, atlas_height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &atlas_width, &atlas_height);
+
+    // The atlas grew, the texture has to be created again at the new size
+    if (atlas_width != bd->FontTexture->Width || atlas_height != bd->FontTexture->Height)
+    {
+        ImGui_ImplSoft_DestroyTexture((ImTextureID)bd->FontTexture);
+        bd->FontTexture = (ImGui_ImplSoft_Texture*)ImGui_ImplSoft_CreateTexture(pixels, atlas_width, atlas_height);
+        io.Fonts->SetTexID((ImTextureID)bd->FontTexture);
+        return;
+    }
+    y = ImGui_ImplSoft_Max(y, 0);
+    height = ImGui_ImplSoft_Min(height, atlas_height - y);
+    if (height > 0)
+        memcpy(bd->FontTexture->Pixels + (size_t)y * atlas_width, pixels + (size_t)y * atlas_width * 4, (size_t)atlas_width * height * sizeof(ImU32));
+}
+
+ImTextureID ImGui_ImplSoft_CreateTexture(const void* pixels, int width, int height)
+{
+    ImGui_ImplSoft_Texture* tex = IM_NEW(ImGui_ImplSoft_Texture)();
+    tex->Width = width;
+    tex->Height = height;
+    tex->Pixels = (ImU32*)IM_ALLOC((size_t)width * height * sizeof(ImU32));
+    memcpy(tex->Pixels, pixels, (size_t)width * height * sizeof(ImU32));
+    return (ImTextureID)tex;
+}
+
+void ImGui_ImplSoft_DestroyTexture(ImTextureID texture)
+{
+    ImGui_ImplSoft_Texture* tex = (ImGui_ImplSoft_Texture*)texture;
+    if (tex == nullptr)
+        return;
+    IM_FREE(tex->Pixels);
+    IM_DELETE(tex);
+}
+
+ImGui_ImplSoft_RingTexture* ImGui_ImplSoft_CreateRingTexture(int line_length, int line_count)
+{
+    ImGui_ImplSoft_RingTexture* ring = IM_NEW(ImGui_ImplSoft_RingTexture)();
+    ring->LineLength = line_length;
+    ring->LineCount = line_count;
+    ring->Head = 0;
+
+    // Start out cleared
+    ImVector<ImU32> clear_pixels;
+    clear_pixels.resize(line_length * line_count, 0);
+    ring->Texture = (ImGui_ImplSoft_Texture*)ImGui_ImplSoft_CreateTexture(clear_pixels.Data, line_length, line_count);
+    return ring;
+}
+
+void ImGui_ImplSoft_DestroyRingTexture(ImGui_ImplSoft_RingTexture* ring)
+{
+    if (ring == nullptr)
+        return;
+    ImGui_ImplSoft_DestroyTexture((ImTextureID)ring->Texture);
+    IM_DELETE(ring);
+}
+
+void ImGui_ImplSoft_PushRingTextureLines(ImGui_ImplSoft_RingTexture* ring, const ImU32* pixels, int lines)
+{
+    // Only the last LineCount lines would be visible
+    if (lines > ring->LineCount)
+    {
+        pixels += (size_t)(lines - ring->LineCount) * ring->LineLength;
+        lines = ring->LineCount;
+    }
+    while (lines > 0)
+    {
+        // At most two copies, split where the write head wraps around
+        int chunk = ImGui_ImplSoft_Min(lines, ring->LineCount - ring->Head);
+        memcpy(ring->Texture->Pixels + (size_t)ring->Head * ring->LineLength, pixels, (size_t)chunk * ring->LineLength * sizeof(ImU32));
+        ring->Head = (ring->Head + chunk) % ring->LineCount;
+        pixels += (size_t)chunk * ring->LineLength;
+        lines -= chunk;
+    }
+}
+
+void ImGui_ImplSoft_AddRingTextureImage(ImDrawList* draw_list, const ImGui_ImplSoft_RingTexture* ring, const ImVec2& p_min, const ImVec2& p_max, bool horizontal)
+{
+    // Textures are clamped rather than repeated, so the view from the oldest to the newest line is drawn in two parts,
+    // split where the lines wrap around to the start of the texture
+    ImTextureID texture = (ImTextureID)ring->Texture;
+    float v_head = (float)ring->Head / ring->LineCount;
+    float oldest = 1.0f - v_head;       // Part of the view taken by the lines from the head to the end of the texture
+    if (horizontal)
+    {
+        float x = p_min.x + (p_max.x - p_min.x) * oldest;
+        draw_list->AddImageQuad(texture, p_min, ImVec2(x, p_min.y), ImVec2(x, p_max.y), ImVec2(p_min.x, p_max.y),
+                                ImVec2(1.0f, v_head), ImVec2(1.0f, 1.0f), ImVec2(0.0f, 1.0f), ImVec2(0.0f, v_head));
+        draw_list->AddImageQuad(texture, ImVec2(x, p_min.y), ImVec2(p_max.x, p_min.y), p_max, ImVec2(x, p_max.y),
+                                ImVec2(1.0f, 0.0f), ImVec2(1.0f, v_head), ImVec2(0.0f, v_head), ImVec2(0.0f, 0.0f));
+    }
+    else
+    {
+        float y = p_max.y - (p_max.y - p_min.y) * oldest;
+        draw_list->AddImage(texture, p_min, ImVec2(p_max.x, y), ImVec2(0.0f, v_head), ImVec2(1.0f, 0.0f));
+        draw_list->AddImage(texture, ImVec2(p_min.x, y), p_max, ImVec2(0.0f, 1.0f), ImVec2(1.0f, v_head));
+    }
+}
+
+const ImGui_ImplSoft_FrameStats& ImGui_ImplSoft_GetFrameStats()
+{
+    return g_Data->Stats;
+}
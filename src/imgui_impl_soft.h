@@ -0,0 +1,54 @@
+// dear imgui: Renderer Backend rasterizing on the CPU into a memory framebuffer (vstimgui addition)
+// For hosts without usable OpenGL, i.e. in virtual machines or remote sessions, and for rendering in CI without any GL
+// stack. This needs to be used along with a Platform Backend, or with display size and time step set directly.
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use the ImTextureID returned by ImGui_ImplSoft_CreateTexture() with ImGui::Image().
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Textured, vertex coloured and scissored triangles, alpha blended like the OpenGL3 backend.
+//  [ ] Renderer: Textures are sampled with nearest filtering, which is exact for the font atlas as text is pixel aligned.
+
+// The framebuffer is split into tiles, triangles are binned to the tiles they touch and the tiles are rasterized in
+// parallel by a pool of worker threads, each one filling spans of 4 pixels at a time with SSE2 where available.
+// Triangles are drawn in order within a tile, so the result is the same regardless of the number of threads.
+// User callbacks are called in order while binning, before anything is rasterized, so they can't draw themselves.
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+
+// Backend API
+// thread_count is the total number of threads rasterizing, including the one calling ImGui_ImplSoft_RenderDrawData(),
+// 0 uses one per hardware thread.
+IMGUI_IMPL_API bool     ImGui_ImplSoft_Init(int thread_count = 0);
+IMGUI_IMPL_API void     ImGui_ImplSoft_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoft_NewFrame();
+// Renders into width * height RGBA 8 bit pixels in the IM_COL32() byte order, with stride pixels between the start of
+// each row. The framebuffer is blended onto as it is, clearing it is up to the caller.
+IMGUI_IMPL_API void     ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, ImU32* pixels, int width, int height, int stride);
+
+// Updates rows [y, y + height) of the font texture from the font atlas, or creates it again at the new size if the
+// atlas grew. Same as ImGui_ImplOpenGL3_UpdateFontsTexture(), for atlases that get glyphs added after being built.
+IMGUI_IMPL_API void     ImGui_ImplSoft_UpdateFontsTexture(int y, int height);
+
+// Texture helpers, the pixels are RGBA 8 bit and copied
+IMGUI_IMPL_API ImTextureID ImGui_ImplSoft_CreateTexture(const void* pixels, int width, int height);
+IMGUI_IMPL_API void     ImGui_ImplSoft_DestroyTexture(ImTextureID texture);
+
+// Ring texture for scrolling images, with the same interface as the OpenGL3 backend's. Each line is a texture row of
+// line_length pixels and the newest line_count lines are kept, a pushed line replaces the oldest one.
+struct ImGui_ImplSoft_RingTexture;
+IMGUI_IMPL_API ImGui_ImplSoft_RingTexture* ImGui_ImplSoft_CreateRingTexture(int line_length, int line_count);
+IMGUI_IMPL_API void     ImGui_ImplSoft_DestroyRingTexture(ImGui_ImplSoft_RingTexture* ring);
+IMGUI_IMPL_API void     ImGui_ImplSoft_PushRingTextureLines(ImGui_ImplSoft_RingTexture* ring, const ImU32* pixels, int lines);
+// Draws the lines from the oldest to the newest, left to right if horizontal, otherwise bottom to top.
+IMGUI_IMPL_API void     ImGui_ImplSoft_AddRingTextureImage(ImDrawList* draw_list, const ImGui_ImplSoft_RingTexture* ring, const ImVec2& p_min, const ImVec2& p_max, bool horizontal);
+
+// Statistics from the last call to ImGui_ImplSoft_RenderDrawData()
+struct ImGui_ImplSoft_FrameStats
+{
+    int     Triangles;          // Triangles set up, after dropping the ones outside their clip rect
+    int     BinnedTriangles;    // Sum of triangles over all tiles, a triangle touching several tiles counts once per tile
+    int     Tiles;              // Tiles with anything to draw
+    int     Threads;
+};
+IMGUI_IMPL_API const ImGui_ImplSoft_FrameStats& ImGui_ImplSoft_GetFrameStats();
@@ -0,0 +1,195 @@
+#include <cstring>
+#include <iostream>
+
+#include "input_recording.h"
+
+namespace imgui_editor {
+
+constexpr char RECORDING_MAGIC[4] = {'I', 'M', 'I', 'R'};
+constexpr uint32_t RECORDING_VERSION = 1;
+constexpr int RECORDED_MOUSE_BUTTONS = 5;
+
+struct RecordedFrameHeader
+{
+    float    delta_time;
+    float    display_size[2];
+    float    framebuffer_scale[2];
+    float    mouse_pos[2];
+    float    mouse_wheel;
+    float    mouse_wheel_h;
+    uint8_t  mouse_down;
+    uint8_t  modifiers;
+    uint16_t key_count;
+    uint16_t character_count;
+    uint16_t parameter_count;
+};
+
+InputRecorder::~InputRecorder()
+{
+    close();
+}
+
+bool InputRecorder::open(const std::string& path)
+{
+    _file.open(path, std::ios::binary | std::ios::trunc);
+    if (!_file.is_open())
+    {
+        std::cerr << "Failed to open " << path << " for recording" << std::endl;
+        return false;
+    }
+    _file.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    _file.write(reinterpret_cast<const char*>(&RECORDING_VERSION), sizeof(RECORDING_VERSION));
+    _keys_down.assign(IM_ARRAYSIZE(ImGuiIO::KeysDown), 0);
+    {
+        /* Changes from before are not part of this recording */
+        std::scoped_lock<std::mutex> lock(_parameter_lock);
+        _pending_parameters.clear();
+        _last_parameters.clear();
+    }
+    _open = true;
+    return true;
+}
+
+void InputRecorder::close()
+{
+    _open = false;
+    if (_file.is_open())
+    {
+        _file.close();
+    }
+    std::scoped_lock<std::mutex> lock(_parameter_lock);
+    _pending_parameters.clear();
+}
+
+void InputRecorder::record_frame(const ImGuiIO& io)
+{
+    if (!_file.is_open())
+    {
+        return;
+    }
+    RecordedFrameHeader header{};
+    header.delta_time = io.DeltaTime;
+    header.display_size[0] = io.DisplaySize.x;
+    header.display_size[1] = io.DisplaySize.y;
+    header.framebuffer_scale[0] = io.DisplayFramebufferScale.x;
+    header.framebuffer_scale[1] = io.DisplayFramebufferScale.y;
+    header.mouse_pos[0] = io.MousePos.x;
+    header.mouse_pos[1] = io.MousePos.y;
+    header.mouse_wheel = io.MouseWheel;
+    header.mouse_wheel_h = io.MouseWheelH;
+    for (int i = 0; i < RECORDED_MOUSE_BUTTONS; i++)
+    {
+        header.mouse_down |= io.MouseDown[i] ? 1 << i : 0;
+    }
+    header.modifiers = (io.KeyCtrl ? 1 : 0) | (io.KeyShift ? 2 : 0) | (io.KeyAlt ? 4 : 0) | (io.KeySuper ? 8 : 0);
+
+    /* Keys are stored as changes, the full state is 512 bools */
+    _frame.keys.clear();
+    for (size_t key = 0; key < _keys_down.size(); key++)
+    {
+        if (_keys_down[key] != io.KeysDown[key])
+        {
+            _keys_down[key] = io.KeysDown[key];
+            _frame.keys.push_back({static_cast<uint16_t>(key), _keys_down[key]});
+        }
+    }
+    _frame.characters.assign(io.InputQueueCharacters.begin(), io.InputQueueCharacters.end());
+    {
+        std::scoped_lock<std::mutex> lock(_parameter_lock);
+        _frame.parameters.swap(_pending_parameters);
+        _pending_parameters.clear();
+    }
+    header.key_count = static_cast<uint16_t>(_frame.keys.size());
+    header.character_count = static_cast<uint16_t>(_frame.characters.size());
+    header.parameter_count = static_cast<uint16_t>(_frame.parameters.size());
+
+    _file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    _file.write(reinterpret_cast<const char*>(_frame.keys.data()), _frame.keys.size() * sizeof(RecordedFrame::KeyChange));
+    _file.write(reinterpret_cast<const char*>(_frame.characters.data()), _frame.characters.size() * sizeof(ImWchar));
+    _file.write(reinterpret_cast<const char*>(_frame.parameters.data()), _frame.parameters.size() * sizeof(RecordedFrame::ParameterChange));
+    _frames++;
+}
+
+void InputRecorder::record_parameter(int index, float value)
+{
+    std::scoped_lock<std::mutex> lock(_parameter_lock);
+    if (index >= static_cast<int>(_last_parameters.size()))
+    {
+        _last_parameters.resize(index + 1, -1.0f);
+    }
+    if (_last_parameters[index] != value)
+    {
+        _last_parameters[index] = value;
+        _pending_parameters.push_back({index, value});
+    }
+}
+
+bool InputRecording::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(RECORDING_MAGIC)];
+    uint32_t version = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!file || std::memcmp(magic, RECORDING_MAGIC, sizeof(magic)) != 0 || version != RECORDING_VERSION)
+    {
+        std::cerr << path << " is not an input recording" << std::endl;
+        return false;
+    }
+
+    _frames.clear();
+    RecordedFrameHeader header;
+    while (file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        RecordedFrame& frame = _frames.emplace_back();
+        frame.delta_time = header.delta_time;
+        frame.display_size = ImVec2(header.display_size[0], header.display_size[1]);
+        frame.framebuffer_scale = ImVec2(header.framebuffer_scale[0], header.framebuffer_scale[1]);
+        frame.mouse_pos = ImVec2(header.mouse_pos[0], header.mouse_pos[1]);
+        frame.mouse_wheel = header.mouse_wheel;
+        frame.mouse_wheel_h = header.mouse_wheel_h;
+        frame.mouse_down = header.mouse_down;
+        frame.modifiers = header.modifiers;
+        frame.keys.resize(header.key_count);
+        frame.characters.resize(header.character_count);
+        frame.parameters.resize(header.parameter_count);
+        file.read(reinterpret_cast<char*>(frame.keys.data()), frame.keys.size() * sizeof(RecordedFrame::KeyChange));
+        file.read(reinterpret_cast<char*>(frame.characters.data()), frame.characters.size() * sizeof(ImWchar));
+        file.read(reinterpret_cast<char*>(frame.parameters.data()), frame.parameters.size() * sizeof(RecordedFrame::ParameterChange));
+        if (!file)
+        {
+            /* The session ended in the middle of writing this frame */
+            _frames.pop_back();
+            break;
+        }
+    }
+    return true;
+}
+
+void InputRecording::apply(const RecordedFrame& frame, ImGuiIO& io)
+{
+    io.DeltaTime = frame.delta_time;
+    io.DisplaySize = frame.display_size;
+    io.DisplayFramebufferScale = frame.framebuffer_scale;
+    io.MousePos = frame.mouse_pos;
+    io.MouseWheel = frame.mouse_wheel;
+    io.MouseWheelH = frame.mouse_wheel_h;
+    for (int i = 0; i < RECORDED_MOUSE_BUTTONS; i++)
+    {
+        io.MouseDown[i] = (frame.mouse_down & (1 << i)) != 0;
+    }
+    io.KeyCtrl = (frame.modifiers & 1) != 0;
+    io.KeyShift = (frame.modifiers & 2) != 0;
+    io.KeyAlt = (frame.modifiers & 4) != 0;
+    io.KeySuper = (frame.modifiers & 8) != 0;
+    for (const auto& key : frame.keys)
+    {
+        io.KeysDown[key.key] = key.down != 0;
+    }
+    for (ImWchar character : frame.characters)
+    {
+        io.AddInputCharacter(character);
+    }
+}
+
+} // imgui_editor
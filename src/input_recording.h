@@ -0,0 +1,111 @@
+#ifndef IMPLUGINGUI_INPUT_RECORDING_H
+#define IMPLUGINGUI_INPUT_RECORDING_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "imgui.h"
+
+namespace imgui_editor {
+
+/* Everything that goes into one frame of the widget code besides the editor's
+ * own state: the input as the GLFW backend applied it to ImGuiIO, the frame's
+ * time step and display size, and parameter changes from the host */
+struct RecordedFrame
+{
+    struct KeyChange
+    {
+        uint16_t key;
+        uint16_t down;
+    };
+
+    struct ParameterChange
+    {
+        int32_t index;
+        float   value;
+    };
+
+    float    delta_time{0};
+    ImVec2   display_size;
+    ImVec2   framebuffer_scale;
+    ImVec2   mouse_pos;
+    float    mouse_wheel{0};
+    float    mouse_wheel_h{0};
+    uint8_t  mouse_down{0};    // One bit per button
+    uint8_t  modifiers{0};     // Ctrl, shift, alt and super from the lowest bit
+    std::vector<KeyChange>       keys;
+    std::vector<ImWchar>         characters;
+    std::vector<ParameterChange> parameters;
+};
+
+/* Records a session frame by frame to a file. Each frame is stored as a fixed
+ * size header followed by its key changes, characters and parameter changes,
+ * in native byte order.
+ * open(), close() and record_frame() must be called from the draw thread, the
+ * latter after the platform backend's NewFrame(). is_open() and record_parameter()
+ * can be called from any thread, i.e. the host's, and the change is stored with
+ * the next frame. Only the draw thread touches the file */
+class InputRecorder
+{
+public:
+    InputRecorder() = default;
+
+    ~InputRecorder();
+
+    bool open(const std::string& path);
+
+    void close();
+
+    bool is_open() const
+    {
+        return _open;
+    }
+
+    void record_frame(const ImGuiIO& io);
+
+    /* Stores the value only if it changed since the last one recorded for this parameter */
+    void record_parameter(int index, float value);
+
+    int frames() const
+    {
+        return _frames;
+    }
+
+private:
+    std::ofstream _file;
+    std::atomic_bool _open{false};
+    int           _frames{0};
+    std::vector<uint8_t> _keys_down;
+
+    std::mutex                                   _parameter_lock;
+    std::vector<RecordedFrame::ParameterChange>  _pending_parameters;
+    std::vector<float>                           _last_parameters;
+
+    RecordedFrame _frame;
+};
+
+/* A recording loaded back for replaying */
+class InputRecording
+{
+public:
+    bool load(const std::string& path);
+
+    const std::vector<RecordedFrame>& frames() const
+    {
+        return _frames;
+    }
+
+    /* Sets up io for the frame as the platform backend did when it was recorded,
+     * call before ImGui::NewFrame(). Frames must be applied in order */
+    static void apply(const RecordedFrame& frame, ImGuiIO& io);
+
+private:
+    std::vector<RecordedFrame> _frames;
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_INPUT_RECORDING_H
@@ -0,0 +1,139 @@
+#ifndef IMPLUGINGUI_LAYOUT_H
+#define IMPLUGINGUI_LAYOUT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "imgui.h"
+
+namespace imgui_editor {
+
+/* Declarative layout of a group of parameter widgets, compiled to a flat table
+ * at compile time so drawing it is a linear walk over precomputed positions and
+ * ids, without any layout arithmetic or string handling per frame */
+
+enum class WidgetKind : uint8_t
+{
+    TITLE,              // The group's title
+    PARAMETER_NAME,
+    PARAMETER_SLIDER,
+    PARAMETER_VALUE,
+};
+
+/* A row of widgets of one kind, one in each column */
+struct LayoutRow
+{
+    WidgetKind kind;
+    float      x_offset;    // From the left edge of the column
+    ImVec2     size;        // Only the height is used for text
+};
+
+/* Columns of rows, with column i bound to parameter first_parameter + i.
+ * Positions are in window coordinates, i.e. for ImGui::SetCursorPos() */
+template <size_t COLUMNS, size_t ROWS>
+struct LayoutGroup
+{
+    const char*                 title;
+    ImVec2                      pos;            // Top left corner of the group's background
+    ImVec2                      padding;
+    float                       title_height;
+    float                       column_width;
+    float                       row_spacing;
+    int                         first_parameter;
+    std::array<LayoutRow, ROWS> rows;
+};
+
+/* Fits "##p" and a parameter number of up to 4 digits */
+constexpr int LAYOUT_ID_SIZE = 8;
+
+struct LayoutItem
+{
+    ImVec2      pos;
+    ImVec2      size;
+    WidgetKind  kind;
+    int16_t     parameter;      // -1 if not bound to a parameter
+    char        id[LAYOUT_ID_SIZE];
+};
+
+/* The title comes first, then the widgets of each column in turn, so all widgets
+ * of the first n parameters are a prefix of the table */
+template <size_t COLUMNS, size_t ROWS>
+struct CompiledLayout
+{
+    static constexpr size_t ITEM_COUNT = 1 + COLUMNS * ROWS;
+
+    std::array<LayoutItem, ITEM_COUNT> items;
+    /* Size of the background with only the first n columns shown */
+    std::array<ImVec2, COLUMNS + 1>    background_size;
+    ImVec2                             background_pos;
+    const char*                        title;
+    ImVec2                             end;     // Below the background, where the next widgets can go
+
+    /* Number of items to draw for the first n parameters of the group */
+    static constexpr size_t items_for(int columns)
+    {
+        return 1 + static_cast<size_t>(columns < 0 ? 0 : (columns > static_cast<int>(COLUMNS) ? COLUMNS : columns)) * ROWS;
+    }
+};
+
+constexpr void make_layout_id(char* id, int parameter)
+{
+    id[0] = '#';
+    id[1] = '#';
+    id[2] = 'p';
+    int digits = 1;
+    for (int rest = parameter / 10; rest > 0; rest /= 10)
+    {
+        digits++;
+    }
+    for (int i = digits - 1; i >= 0; --i)
+    {
+        id[3 + i] = static_cast<char>('0' + parameter % 10);
+        parameter /= 10;
+    }
+    id[3 + digits] = 0;
+}
+
+template <size_t COLUMNS, size_t ROWS>
+constexpr CompiledLayout<COLUMNS, ROWS> compile_layout(const LayoutGroup<COLUMNS, ROWS>& group)
+{
+    static_assert(COLUMNS > 0 && COLUMNS < 10000, "Parameter ids only have room for 4 digits");
+    CompiledLayout<COLUMNS, ROWS> layout{};
+    float content_x = group.pos.x + group.padding.x;
+    float content_y = group.pos.y + group.padding.y;
+    layout.items[0] = {ImVec2(content_x, content_y), ImVec2(0, group.title_height), WidgetKind::TITLE, -1, {}};
+
+    float rows_height = 0;
+    for (const auto& row : group.rows)
+    {
+        rows_height += row.size.y + group.row_spacing;
+    }
+    size_t item = 1;
+    for (size_t column = 0; column < COLUMNS; ++column)
+    {
+        float row_y = content_y + group.title_height + group.row_spacing;
+        for (const auto& row : group.rows)
+        {
+            LayoutItem& entry = layout.items[item++];
+            entry.pos = ImVec2(content_x + column * group.column_width + row.x_offset, row_y);
+            entry.size = row.size;
+            entry.kind = row.kind;
+            entry.parameter = static_cast<int16_t>(group.first_parameter + column);
+            make_layout_id(entry.id, group.first_parameter + static_cast<int>(column));
+            row_y += row.size.y + group.row_spacing;
+        }
+    }
+    float height = group.padding.y * 2 + group.title_height + group.row_spacing + rows_height;
+    for (size_t columns = 0; columns <= COLUMNS; ++columns)
+    {
+        layout.background_size[columns] = ImVec2(group.padding.x * 2 + columns * group.column_width, height);
+    }
+    layout.background_pos = group.pos;
+    layout.title = group.title;
+    layout.end = ImVec2(content_x, group.pos.y + height + group.row_spacing);
+    return layout;
+}
+
+} // imgui_editor
+#endif //IMPLUGINGUI_LAYOUT_H
@@ -0,0 +1,89 @@
+#include <iostream>
+
+#ifdef WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "mapped_file.h"
+
+namespace imgui_editor {
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+#ifdef WINDOWS
+    _file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER file_size;
+    if (_file_handle == INVALID_HANDLE_VALUE || !GetFileSizeEx(_file_handle, &file_size))
+    {
+        std::cerr << "Failed to open " << path << std::endl;
+        _file_handle = nullptr;
+        return false;
+    }
+    _size = static_cast<size_t>(file_size.QuadPart);
+    _mapping_handle = CreateFileMappingA(_file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    _data = _mapping_handle ? static_cast<const uint8_t*>(MapViewOfFile(_mapping_handle, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat file_stat{};
+    if (fd < 0 || fstat(fd, &file_stat) != 0)
+    {
+        std::cerr << "Failed to open " << path << std::endl;
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+        return false;
+    }
+    _size = static_cast<size_t>(file_stat.st_size);
+    void* data = _size > 0 ? mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    _data = data == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(data);
+#endif
+    if (_data == nullptr)
+    {
+        std::cerr << "Failed to map " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close()
+{
+#ifdef WINDOWS
+    if (_data)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping_handle)
+    {
+        CloseHandle(_mapping_handle);
+    }
+    if (_file_handle)
+    {
+        CloseHandle(_file_handle);
+    }
+    _mapping_handle = nullptr;
+    _file_handle = nullptr;
+#else
+    if (_data)
+    {
+        munmap(const_cast<uint8_t*>(_data), _size);
+    }
+#endif
+    _data = nullptr;
+    _size = 0;
+}
+
+} // imgui_editor
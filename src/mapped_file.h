@@ -0,0 +1,48 @@
+#ifndef IMPLUGINGUI_MAPPED_FILE_H
+#define IMPLUGINGUI_MAPPED_FILE_H
+
+#include <cstdint>
+#include <string>
+
+namespace imgui_editor {
+
+/* A whole file memory mapped read only. The mapping is shared, so every
+ * process that maps the same file uses the same pages of the page cache */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /* Unmaps any file mapped before. Empty files can't be mapped */
+    bool open(const std::string& path);
+
+    void close();
+
+    /* Null if no file is mapped */
+    const uint8_t* data() const
+    {
+        return _data;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+private:
+    const uint8_t* _data{nullptr};
+    size_t         _size{0};
+#ifdef WINDOWS
+    void*          _file_handle{nullptr};
+    void*          _mapping_handle{nullptr};
+#endif
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_MAPPED_FILE_H
@@ -0,0 +1,78 @@
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+
+#include "imgui.h"
+#include "memory_account.h"
+
+namespace imgui_editor {
+
+/* The size of each allocation is stored in front of it, padded to keep the alignment of malloc() */
+constexpr size_t ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+
+thread_local MemoryAccount* current_account = nullptr;
+
+void MemoryAccount::install()
+{
+    static std::once_flag installed;
+    std::call_once(installed, []
+    {
+        /* Memory allocated before would be freed with the wrong allocator */
+        IM_ASSERT(ImGui::GetCurrentContext() == nullptr && "MemoryAccount must be installed before any ImGui context is created");
+        ImGui::SetAllocatorFunctions(&MemoryAccount::_alloc, &MemoryAccount::_free);
+    });
+}
+
+static const bool installed_at_startup = (MemoryAccount::install(), true);
+
+MemoryAccount::Scope::Scope(MemoryAccount* account) : _previous(current_account)
+{
+    current_account = account;
+}
+
+MemoryAccount::Scope::~Scope()
+{
+    current_account = _previous;
+}
+
+void* MemoryAccount::_alloc(size_t size, [[maybe_unused]] void* user_data)
+{
+    auto block = static_cast<char*>(std::malloc(size + ALLOCATION_HEADER_SIZE));
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    if (current_account)
+    {
+        current_account->_allocations.fetch_add(1, std::memory_order_relaxed);
+        current_account->_add(static_cast<int64_t>(size));
+    }
+    return block + ALLOCATION_HEADER_SIZE;
+}
+
+void MemoryAccount::_free(void* ptr, [[maybe_unused]] void* user_data)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    char* block = static_cast<char*>(ptr) - ALLOCATION_HEADER_SIZE;
+    if (current_account)
+    {
+        current_account->_add(-static_cast<int64_t>(*reinterpret_cast<size_t*>(block)));
+    }
+    std::free(block);
+}
+
+void MemoryAccount::_add(int64_t bytes)
+{
+    /* The draw thread and the panel workers charge the same account, so the peak
+     * is only raised if no other thread has raised it further in the meantime */
+    int64_t total = _bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    int64_t peak = _peak_bytes.load(std::memory_order_relaxed);
+    while (total > peak && !_peak_bytes.compare_exchange_weak(peak, total, std::memory_order_relaxed))
+    {}
+}
+
+} // imgui_editor
@@ -0,0 +1,68 @@
+#ifndef IMPLUGINGUI_MEMORY_ACCOUNT_H
+#define IMPLUGINGUI_MEMORY_ACCOUNT_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace imgui_editor {
+
+/* Counts the memory ImGui allocates for one editor: its context, draw lists,
+ * font atlas and the backends' state. ImGui has a single allocator for the
+ * whole process, so memory is charged to the account set on the calling thread
+ * with a MemoryAccount::Scope, and credited to the account set on the thread
+ * freeing it. Every editor runs its ImGui code on its own thread, and its
+ * panel workers charge the same account from theirs, so an account is updated
+ * from several threads. The counts can be read from any thread */
+class MemoryAccount
+{
+public:
+    /* Sets ImGui's allocator functions, must be called before ImGui allocates
+     * anything. This is done during static initialization, before any ImGui
+     * context can exist, so only code running before then needs to call it.
+     * Only the first call has any effect */
+    static void install();
+
+    class Scope
+    {
+    public:
+        explicit Scope(MemoryAccount* account);
+
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        MemoryAccount* _previous;
+    };
+
+    int64_t bytes() const
+    {
+        return _bytes;
+    }
+
+    int64_t peak_bytes() const
+    {
+        return _peak_bytes;
+    }
+
+    /* Number of allocations made, not the number currently held */
+    int64_t allocations() const
+    {
+        return _allocations;
+    }
+
+private:
+    static void* _alloc(size_t size, void* user_data);
+
+    static void _free(void* ptr, void* user_data);
+
+    void _add(int64_t bytes);
+
+    std::atomic<int64_t> _bytes{0};
+    std::atomic<int64_t> _peak_bytes{0};
+    std::atomic<int64_t> _allocations{0};
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_MEMORY_ACCOUNT_H
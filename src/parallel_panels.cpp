@@ -0,0 +1,125 @@
+#include "parallel_panels.h"
+
+namespace imgui_editor {
+
+ParallelPanels::~ParallelPanels()
+{
+    stop();
+}
+
+void ParallelPanels::start(int threads, MemoryAccount* account)
+{
+    stop();
+    _account = account;
+    _stop = false;
+    for (int i = 0; i < threads; ++i)
+    {
+        _workers.emplace_back(&ParallelPanels::_worker, this);
+    }
+}
+
+void ParallelPanels::stop()
+{
+    {
+        std::scoped_lock<std::mutex> lock(_lock);
+        _stop = true;
+    }
+    _wake.notify_all();
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+    _workers.clear();
+    _panels.clear();
+    _lists.clear();
+    _merged.clear();
+    _drawn = 0;
+}
+
+void ParallelPanels::submit(const ImVec2& clip_min, const ImVec2& clip_max, DrawFunction draw)
+{
+    _panels.push_back({ImGui::GetWindowDrawList(), clip_min, clip_max, std::move(draw)});
+    if (_lists.size() < _panels.size())
+    {
+        _lists.push_back(std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData()));
+    }
+}
+
+void ParallelPanels::merge(ImDrawData* draw_data)
+{
+    _drawn = static_cast<int>(_panels.size());
+    if (_panels.empty())
+    {
+        return;
+    }
+    _font_texture = ImGui::GetIO().Fonts->TexID;
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _count = _panels.size();
+        _next = 0;
+        _done = 0;
+        _wake.notify_all();
+        while (_next < _count)
+        {
+            _draw_next(lock);
+        }
+        _finished.wait(lock, [this] {return _done == _count;});
+        _count = 0;
+        _next = 0;
+    }
+
+    /* Each window's draw list is followed by its panels in the order they were submitted */
+    _merged.resize(0);
+    for (int n = 0; n < draw_data->CmdListsCount; ++n)
+    {
+        _merged.push_back(draw_data->CmdLists[n]);
+        for (size_t i = 0; i < _panels.size(); ++i)
+        {
+            ImDrawList* list = _lists[i].get();
+            if (_panels[i].window_list == draw_data->CmdLists[n] && list->CmdBuffer.Size > 0)
+            {
+                _merged.push_back(list);
+                draw_data->TotalVtxCount += list->VtxBuffer.Size;
+                draw_data->TotalIdxCount += list->IdxBuffer.Size;
+            }
+        }
+    }
+    draw_data->CmdLists = _merged.Data;
+    draw_data->CmdListsCount = _merged.Size;
+    _panels.clear();
+}
+
+void ParallelPanels::_worker()
+{
+    MemoryAccount::Scope memory_scope(_account);
+    std::unique_lock<std::mutex> lock(_lock);
+    while (true)
+    {
+        _wake.wait(lock, [this] {return _stop || _next < _count;});
+        if (_stop)
+        {
+            return;
+        }
+        _draw_next(lock);
+    }
+}
+
+void ParallelPanels::_draw_next(std::unique_lock<std::mutex>& lock)
+{
+    size_t index = _next++;
+    lock.unlock();
+    const Panel& panel = _panels[index];
+    ImDrawList* list = _lists[index].get();
+    list->_ResetForNewFrame();
+    list->PushTextureID(_font_texture);
+    list->PushClipRect(panel.clip_min, panel.clip_max);
+    panel.draw(list);
+    list->_PopUnusedDrawCmd();
+    lock.lock();
+    if (++_done == _count)
+    {
+        _finished.notify_all();
+    }
+}
+
+} // imgui_editor
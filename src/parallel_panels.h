@@ -0,0 +1,99 @@
+#ifndef IMPLUGINGUI_PARALLEL_PANELS_H
+#define IMPLUGINGUI_PARALLEL_PANELS_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "imgui.h"
+#include "memory_account.h"
+
+namespace imgui_editor {
+
+/* Builds the geometry of independent panels, e.g. a scope or a matrix display,
+ * on worker threads, each panel into a draw list of its own, and merges the
+ * lists into the frame's draw data in a fixed order.
+ * Panels are submitted on the draw thread while building the frame and are
+ * drawn in merge(), after ImGui::Render(), by the workers and the draw thread
+ * together. A panel's draw function must only use the ImDrawList it is given:
+ * workers have no ImGui context, so widgets and their interaction stay on the
+ * draw thread, and the OpenGL3 backend's additions like ImGui_ImplOpenGL3_AddPolyline()
+ * keep their state per thread. The draw data is the same whichever thread drew
+ * which panel, and with any number of threads.
+ * All functions must be called from the thread owning the ImGui context */
+class ParallelPanels
+{
+public:
+    using DrawFunction = std::function<void(ImDrawList* draw_list)>;
+
+    ParallelPanels() = default;
+
+    ~ParallelPanels();
+
+    ParallelPanels(const ParallelPanels&) = delete;
+    ParallelPanels& operator=(const ParallelPanels&) = delete;
+
+    /* Starts threads workers, with 0 the panels are drawn on the calling thread.
+     * ImGui allocations made by the workers are charged to account */
+    void start(int threads, MemoryAccount* account);
+
+    /* Stops the workers and frees the draw lists, call before destroying the ImGui context */
+    void stop();
+
+    /* Queues a panel clipped to clip_min - clip_max, between ImGui::Begin() and End().
+     * Its draw list is drawn right after the current window's, and after panels
+     * submitted earlier for the same window. Panels of windows that aren't
+     * rendered are dropped */
+    void submit(const ImVec2& clip_min, const ImVec2& clip_max, DrawFunction draw);
+
+    /* Draws the panels submitted since the last call and adds them to draw_data,
+     * call after ImGui::Render() */
+    void merge(ImDrawData* draw_data);
+
+    int threads() const
+    {
+        return static_cast<int>(_workers.size());
+    }
+
+    /* Panels drawn by the last merge() */
+    int panels() const
+    {
+        return _drawn;
+    }
+
+private:
+    struct Panel
+    {
+        ImDrawList*  window_list;
+        ImVec2       clip_min;
+        ImVec2       clip_max;
+        DrawFunction draw;
+    };
+
+    void _worker();
+
+    /* Draws the next panel in line, lock is released while drawing */
+    void _draw_next(std::unique_lock<std::mutex>& lock);
+
+    std::vector<Panel>                       _panels;
+    std::vector<std::unique_ptr<ImDrawList>> _lists;
+    ImVector<ImDrawList*>                    _merged;
+    ImTextureID                              _font_texture{nullptr};
+    int                                      _drawn{0};
+
+    MemoryAccount*           _account{nullptr};
+    std::vector<std::thread> _workers;
+    std::mutex               _lock;
+    std::condition_variable  _wake;
+    std::condition_variable  _finished;
+    bool                     _stop{false};
+    size_t                   _count{0};     // Panels to draw in the current merge()
+    size_t                   _next{0};
+    size_t                   _done{0};
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_PARALLEL_PANELS_H
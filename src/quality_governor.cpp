@@ -0,0 +1,108 @@
+#include <array>
+
+#include "quality_governor.h"
+
+namespace imgui_editor {
+
+/* Smoothing of the frame cost and how long it has to stay over budget, or
+ * under budget * HEADROOM, before the level is changed. Stepping up is slower
+ * so a level that's just about sustainable is not left and re-entered all the time */
+constexpr float COST_SMOOTHING = 0.1f;
+constexpr int   FRAMES_BEFORE_STEP_DOWN = 30;
+constexpr int   FRAMES_BEFORE_STEP_UP = 180;
+constexpr float HEADROOM = 0.6f;
+
+/* ImGuiStyle::CircleSegmentMaxError was renamed in 1.83 */
+#if IMGUI_VERSION_NUM >= 18300
+#define CIRCLE_MAX_ERROR CircleTessellationMaxError
+#else
+#define CIRCLE_MAX_ERROR CircleSegmentMaxError
+#endif
+
+struct QualityLevel
+{
+    const char* name;
+    float tessellation_scale;   // Of CurveTessellationTol and the circle max error, higher means fewer segments
+    bool  anti_aliased_fill;
+    bool  anti_aliased_lines;
+    int   max_fps;              // 0 for no limit
+};
+
+constexpr std::array<QualityLevel, 5> QUALITY_LEVELS = {{{"Full",                 1.0f, true,  true,  0},
+                                                          {"Coarse curves",        2.0f, true,  true,  0},
+                                                          {"No anti-aliased fill", 4.0f, false, true,  0},
+                                                          {"No anti-aliasing",     4.0f, false, false, 0},
+                                                          {"Half frame rate",      4.0f, false, false, 30}}};
+
+QualityGovernor::QualityGovernor(float budget_ms) : _budget_ms(budget_ms)
+{}
+
+void QualityGovernor::reset(const ImGuiStyle& style)
+{
+    _anti_aliased_lines = style.AntiAliasedLines;
+    _anti_aliased_fill = style.AntiAliasedFill;
+    _curve_tessellation_tol = style.CurveTessellationTol;
+    _circle_max_error = style.CIRCLE_MAX_ERROR;
+    _level = 0;
+    _frames_over = 0;
+    _frames_under = 0;
+    _cost_ms = 0;
+}
+
+void QualityGovernor::frame(float cost_ms, ImGuiStyle& style)
+{
+    if (_budget_ms <= 0)
+    {
+        return;
+    }
+    float cost = _cost_ms + COST_SMOOTHING * (cost_ms - _cost_ms);
+    _cost_ms = cost;
+    _frames_over = cost > _budget_ms ? _frames_over + 1 : 0;
+    _frames_under = cost < _budget_ms * HEADROOM ? _frames_under + 1 : 0;
+
+    int level = _level;
+    if (_frames_over >= FRAMES_BEFORE_STEP_DOWN && level < levels() - 1)
+    {
+        level++;
+    }
+    else if (_frames_under >= FRAMES_BEFORE_STEP_UP && level > 0)
+    {
+        level--;
+    }
+    else
+    {
+        return;
+    }
+    /* Start measuring the new level from scratch */
+    _level = level;
+    _frames_over = 0;
+    _frames_under = 0;
+    _apply(style);
+}
+
+std::chrono::microseconds QualityGovernor::frame_interval() const
+{
+    int max_fps = QUALITY_LEVELS[_level].max_fps;
+    return std::chrono::microseconds(max_fps > 0 ? 1'000'000 / max_fps : 0);
+}
+
+int QualityGovernor::levels()
+{
+    return static_cast<int>(QUALITY_LEVELS.size());
+}
+
+const char* QualityGovernor::level_name(int level)
+{
+    return QUALITY_LEVELS[level].name;
+}
+
+void QualityGovernor::_apply(ImGuiStyle& style) const
+{
+    const auto& level = QUALITY_LEVELS[_level];
+    style.AntiAliasedLines = _anti_aliased_lines && level.anti_aliased_lines;
+    style.AntiAliasedFill = _anti_aliased_fill && level.anti_aliased_fill;
+    style.CurveTessellationTol = _curve_tessellation_tol * level.tessellation_scale;
+    style.CIRCLE_MAX_ERROR = _circle_max_error * level.tessellation_scale;
+}
+
+} // imgui_editor
@@ -0,0 +1,70 @@
+#ifndef IMPLUGINGUI_QUALITY_GOVERNOR_H
+#define IMPLUGINGUI_QUALITY_GOVERNOR_H
+
+#include <atomic>
+#include <chrono>
+
+#include "imgui.h"
+
+namespace imgui_editor {
+
+/* Keeps an editor's cost per frame within a budget by stepping down the drawing
+ * quality when its frames are consistently over budget, first the tessellation
+ * of curves and circles, then anti-aliasing and finally the frame rate, and
+ * stepping back up once there's enough headroom at the current level.
+ * All functions except level() and cost_ms() must be called from the draw thread */
+class QualityGovernor
+{
+public:
+    /* A budget of 0 disables the governor, quality then stays at level 0 */
+    explicit QualityGovernor(float budget_ms);
+
+    /* Takes the style's current settings as full quality and starts over at level 0 */
+    void reset(const ImGuiStyle& style);
+
+    /* Feed the time spent on a frame, not counting waiting for the display, after
+     * it was drawn. Changes to style take effect from the next frame */
+    void frame(float cost_ms, ImGuiStyle& style);
+
+    /* The shortest time between frames, zero for no limit besides vsync */
+    std::chrono::microseconds frame_interval() const;
+
+    /* 0 is full quality, levels() - 1 the lowest */
+    int level() const
+    {
+        return _level;
+    }
+
+    static int levels();
+
+    static const char* level_name(int level);
+
+    /* Smoothed cost per frame */
+    float cost_ms() const
+    {
+        return _cost_ms;
+    }
+
+    float budget_ms() const
+    {
+        return _budget_ms;
+    }
+
+private:
+    void _apply(ImGuiStyle& style) const;
+
+    float _budget_ms;
+    int   _frames_over{0};
+    int   _frames_under{0};
+    std::atomic<int>   _level{0};
+    std::atomic<float> _cost_ms{0};
+
+    /* Full quality settings */
+    bool  _anti_aliased_lines{true};
+    bool  _anti_aliased_fill{true};
+    float _curve_tessellation_tol{1.25f};
+    float _circle_max_error{0.3f};
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_QUALITY_GOVERNOR_H
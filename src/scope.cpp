@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cassert>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SCOPE_USE_SSE
+#endif
+
+#include "scope.h"
+
+namespace imgui_editor {
+
+#ifdef SCOPE_USE_SSE
+static inline void min_max_range(const float* samples, int count, float& min_val, float& max_val)
+{
+    __m128 min_4 = _mm_set1_ps(samples[0]);
+    __m128 max_4 = min_4;
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 data = _mm_loadu_ps(samples + i);
+        min_4 = _mm_min_ps(min_4, data);
+        max_4 = _mm_max_ps(max_4, data);
+    }
+    /* Horizontal reduction of the 4 lanes */
+    min_4 = _mm_min_ps(min_4, _mm_shuffle_ps(min_4, min_4, _MM_SHUFFLE(2, 3, 0, 1)));
+    min_4 = _mm_min_ps(min_4, _mm_shuffle_ps(min_4, min_4, _MM_SHUFFLE(1, 0, 3, 2)));
+    max_4 = _mm_max_ps(max_4, _mm_shuffle_ps(max_4, max_4, _MM_SHUFFLE(2, 3, 0, 1)));
+    max_4 = _mm_max_ps(max_4, _mm_shuffle_ps(max_4, max_4, _MM_SHUFFLE(1, 0, 3, 2)));
+    min_val = _mm_cvtss_f32(min_4);
+    max_val = _mm_cvtss_f32(max_4);
+    for (; i < count; ++i)
+    {
+        min_val = std::min(min_val, samples[i]);
+        max_val = std::max(max_val, samples[i]);
+    }
+}
+#else
+static inline void min_max_range(const float* samples, int count, float& min_val, float& max_val)
+{
+    min_val = samples[0];
+    max_val = samples[0];
+    for (int i = 1; i < count; ++i)
+    {
+        min_val = std::min(min_val, samples[i]);
+        max_val = std::max(max_val, samples[i]);
+    }
+}
+#endif
+
+void decimate_min_max(const float* samples, int count, float* min_out, float* max_out, int bins)
+{
+    assert(bins > 0 && count >= bins);
+    int start = 0;
+    for (int bin = 0; bin < bins; ++bin)
+    {
+        int end = static_cast<int>(static_cast<long long>(count) * (bin + 1) / bins);
+        /* Include the last sample of the previous bin so adjacent columns connect */
+        int first = std::max(0, start - 1);
+        min_max_range(samples + first, end - first, min_out[bin], max_out[bin]);
+        start = end;
+    }
+}
+
+Scope::Scope(int length) : _length(length),
+                           _history(2 * length, 0.0f),
+                           _min(length, 0.0f),
+                           _max(length, 0.0f)
+{}
+
+void Scope::push(const float* samples, int count)
+{
+    if (count > _length)
+    {
+        samples += count - _length;
+        count = _length;
+    }
+    while (count > 0)
+    {
+        int chunk = std::min(count, _length - _write_index);
+        std::copy(samples, samples + chunk, _history.data() + _write_index);
+        std::copy(samples, samples + chunk, _history.data() + _write_index + _length);
+        _write_index = (_write_index + chunk) % _length;
+        samples += chunk;
+        count -= chunk;
+    }
+}
+
+void Scope::decimate(int bins)
+{
+    _bins = std::clamp(bins, 1, _length);
+    decimate_min_max(history(), _length, _min.data(), _max.data(), _bins);
+}
+
+void Scope::draw(ImDrawList* draw_list, const ImVec2& pos, const ImVec2& size, ImU32 colour) const
+{
+    if (_bins == 0)
+    {
+        return;
+    }
+    float x_step = size.x / _bins;
+    float mid = pos.y + size.y * 0.5f;
+    float scale = size.y * 0.5f;
+    for (int bin = 0; bin < _bins; ++bin)
+    {
+        float x = pos.x + bin * x_step;
+        float top = mid - std::clamp(_max[bin], -1.0f, 1.0f) * scale;
+        float bottom = mid - std::clamp(_min[bin], -1.0f, 1.0f) * scale;
+        /* Make sure flat sections are still visible as a 1 pixel line */
+        draw_list->AddRectFilled(ImVec2(x, top), ImVec2(x + x_step, std::max(bottom, top + 1.0f)), colour);
+    }
+}
+
+} // imgui_editor
@@ -0,0 +1,52 @@
+#ifndef IMPLUGINGUI_SCOPE_H
+#define IMPLUGINGUI_SCOPE_H
+
+#include <vector>
+
+#include "imgui.h"
+
+namespace imgui_editor {
+
+/* Reduce count samples to bins pairs of min and max values, i.e. one bin per
+ * pixel column of a waveform display. Vectorised with SSE where available */
+void decimate_min_max(const float* samples, int count, float* min_out, float* max_out, int bins);
+
+/* Oscilloscope style waveform display. Audio is pushed to it on the draw
+ * thread and the last length samples are drawn as one vertical min/max
+ * line per pixel column */
+class Scope
+{
+public:
+    explicit Scope(int length);
+
+    void push(const float* samples, int count);
+
+    /* Reduce the history buffer to bins columns, call before draw() */
+    void decimate(int bins);
+
+    void draw(ImDrawList* draw_list, const ImVec2& pos, const ImVec2& size, ImU32 colour) const;
+
+    /* The last length() samples received, oldest first */
+    const float* history() const
+    {
+        return _history.data() + _write_index;
+    }
+
+    int length() const
+    {
+        return _length;
+    }
+
+private:
+    int                _length;
+    int                _write_index{0};
+    int                _bins{0};
+    /* The history is stored twice, back to back, so the latest
+     * window of samples is always available as a contiguous range */
+    std::vector<float> _history;
+    std::vector<float> _min;
+    std::vector<float> _max;
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_SCOPE_H
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <cassert>
+
+#include "spectrogram.h"
+
+namespace imgui_editor {
+
+struct ColourStop
+{
+    float position;
+    ImVec4 colour;
+};
+
+/* Dark blue through purple and orange to light yellow, like most audio spectrograms */
+constexpr std::array<ColourStop, 5> COLOUR_STOPS = {{{0.00f, {0.00f, 0.00f, 0.05f, 1.0f}},
+                                                     {0.30f, {0.20f, 0.05f, 0.45f, 1.0f}},
+                                                     {0.55f, {0.70f, 0.10f, 0.45f, 1.0f}},
+                                                     {0.80f, {0.98f, 0.55f, 0.10f, 1.0f}},
+                                                     {1.00f, {1.00f, 1.00f, 0.75f, 1.0f}}}};
+
+Spectrogram::Spectrogram(int bins, int history, float min_db, float max_db, bool software) : _bins(bins),
+                                                                                             _history(history),
+                                                                                             _min_db(min_db),
+                                                                                             _db_scale((COLOUR_MAP_SIZE - 1) / (max_db - min_db)),
+                                                                                             _software(software)
+{
+    for (int i = 0; i < COLOUR_MAP_SIZE; ++i)
+    {
+        float t = static_cast<float>(i) / (COLOUR_MAP_SIZE - 1);
+        size_t stop = 1;
+        while (stop < COLOUR_STOPS.size() - 1 && COLOUR_STOPS[stop].position < t)
+        {
+            ++stop;
+        }
+        const auto& low = COLOUR_STOPS[stop - 1];
+        const auto& high = COLOUR_STOPS[stop];
+        float frac = (t - low.position) / (high.position - low.position);
+        _colour_map[i] = ImGui::ColorConvertFloat4ToU32(ImVec4(low.colour.x + frac * (high.colour.x - low.colour.x),
+                                                               low.colour.y + frac * (high.colour.y - low.colour.y),
+                                                               low.colour.z + frac * (high.colour.z - low.colour.z),
+                                                               1.0f));
+    }
+    _pending.reserve(static_cast<size_t>(bins) * history);
+}
+
+Spectrogram::~Spectrogram()
+{
+    assert(_texture == nullptr && _soft_texture == nullptr && "clear() must be called with the GL context current");
+}
+
+void Spectrogram::push(const float* spectrum_db, int bins)
+{
+    /* Columns that would have scrolled out before being drawn are dropped */
+    if (_pending_columns == _history)
+    {
+        _pending.erase(_pending.begin(), _pending.begin() + _bins);
+        _pending_columns--;
+    }
+    int count = std::min(bins, _bins);
+    for (int i = 0; i < count; ++i)
+    {
+        int index = static_cast<int>((spectrum_db[i] - _min_db) * _db_scale);
+        _pending.push_back(_colour_map[std::clamp(index, 0, COLOUR_MAP_SIZE - 1)]);
+    }
+    _pending.resize(_pending.size() + (_bins - count), _colour_map[0]);
+    _pending_columns++;
+}
+
+void Spectrogram::draw(ImDrawList* draw_list, const ImVec2& pos, const ImVec2& size)
+{
+    if (_software)
+    {
+        if (_soft_texture == nullptr)
+        {
+            _soft_texture = ImGui_ImplSoft_CreateRingTexture(_bins, _history);
+        }
+        ImGui_ImplSoft_PushRingTextureLines(_soft_texture, _pending.data(), _pending_columns);
+        _pending.clear();
+        _pending_columns = 0;
+        ImGui_ImplSoft_AddRingTextureImage(draw_list, _soft_texture, pos, ImVec2(pos.x + size.x, pos.y + size.y), true);
+        return;
+    }
+    if (_texture == nullptr)
+    {
+        _texture = ImGui_ImplOpenGL3_CreateRingTexture(_bins, _history);
+    }
+    if (_pending_columns > 0)
+    {
+        ImGui_ImplOpenGL3_PushRingTextureLines(_texture, _pending.data(), _pending_columns);
+        _pending.clear();
+        _pending_columns = 0;
+    }
+    ImGui_ImplOpenGL3_AddRingTextureImage(draw_list, _texture, pos, ImVec2(pos.x + size.x, pos.y + size.y), true);
+}
+
+void Spectrogram::clear()
+{
+    ImGui_ImplOpenGL3_DestroyRingTexture(_texture);
+    ImGui_ImplSoft_DestroyRingTexture(_soft_texture);
+    _texture = nullptr;
+    _soft_texture = nullptr;
+    _pending.clear();
+    _pending_columns = 0;
+}
+
+} // imgui_editor
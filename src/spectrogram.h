@@ -0,0 +1,58 @@
+#ifndef IMPLUGINGUI_SPECTROGRAM_H
+#define IMPLUGINGUI_SPECTROGRAM_H
+
+#include <array>
+#include <vector>
+
+#include "imgui.h"
+#include "imgui_impl_opengl3.h"
+#include "imgui_impl_soft.h"
+
+namespace imgui_editor {
+
+/* Scrolling spectrogram display, one column of pixels per pushed spectrum with
+ * the newest at the right. The image is kept in a streaming ring texture in
+ * the OpenGL3 backend, so only the new columns are uploaded each frame, or in
+ * the software renderer's if drawn with it.
+ * push() can be called at any time on the draw thread, the texture is created
+ * and updated in draw() and must be released with clear() before the GL
+ * context is destroyed */
+class Spectrogram
+{
+public:
+    Spectrogram(int bins, int history, float min_db, float max_db, bool software = false);
+
+    ~Spectrogram();
+
+    /* Add a spectrum of bins values in dB, lowest frequency first */
+    void push(const float* spectrum_db, int bins);
+
+    void draw(ImDrawList* draw_list, const ImVec2& pos, const ImVec2& size);
+
+    void clear();
+
+    /* Keep the image in the software renderer's texture instead of OpenGL's,
+     * i.e. when drawing headless without a GL context. Only after clear() */
+    void set_software(bool software)
+    {
+        _software = software;
+    }
+
+private:
+    static constexpr int     COLOUR_MAP_SIZE = 256;
+
+    int                      _bins;
+    int                      _history;
+    float                    _min_db;
+    float                    _db_scale;
+    std::array<ImU32, COLOUR_MAP_SIZE> _colour_map;
+    /* Columns pushed since the last draw() */
+    std::vector<ImU32>       _pending;
+    int                      _pending_columns{0};
+    bool                     _software;
+    ImGui_ImplOpenGL3_RingTexture* _texture{nullptr};
+    ImGui_ImplSoft_RingTexture*    _soft_texture{nullptr};
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_SPECTROGRAM_H
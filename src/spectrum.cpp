@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SPECTRUM_USE_SSE
+#endif
+
+#include "spectrum.h"
+#include "imgui_impl_opengl3.h"
+
+namespace imgui_editor {
+
+constexpr float MIN_DB = -90.0f;
+constexpr float MAX_DB = 0.0f;
+constexpr float POWER_FLOOR = 1.0e-12f;
+
+static void apply_window(const float* input, const float* window, float* output, int count)
+{
+    int i = 0;
+#ifdef SPECTRUM_USE_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(output + i, _mm_mul_ps(_mm_loadu_ps(input + i), _mm_loadu_ps(window + i)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        output[i] = input[i] * window[i];
+    }
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer(int fft_size, float sample_rate) : _fft(fft_size),
+                                                                      _sample_rate(sample_rate),
+                                                                      _history(2 * fft_size, 0.0f),
+                                                                      _window(fft_size),
+                                                                      _windowed(fft_size),
+                                                                      _power(fft_size / 2 + 1)
+{
+    float window_sum = 0;
+    for (int i = 0; i < fft_size; ++i)
+    {
+        _window[i] = 0.5f - 0.5f * std::cos(2.0f * 3.14159265f * i / fft_size);
+        window_sum += _window[i];
+    }
+    /* Scale so that a full scale sine reads as 0 dB */
+    _normalisation = (2.0f / window_sum) * (2.0f / window_sum);
+}
+
+void SpectrumAnalyzer::push(const float* samples, int count)
+{
+    int size = _fft.size();
+    if (count > size)
+    {
+        samples += count - size;
+        count = size;
+    }
+    while (count > 0)
+    {
+        int chunk = std::min(count, size - _write_index);
+        std::copy(samples, samples + chunk, _history.data() + _write_index);
+        std::copy(samples, samples + chunk, _history.data() + _write_index + size);
+        _write_index = (_write_index + chunk) % size;
+        samples += chunk;
+        count -= chunk;
+        _new_data = true;
+    }
+}
+
+void SpectrumAnalyzer::set_sample_rate(float sample_rate)
+{
+    if (sample_rate != _sample_rate)
+    {
+        _sample_rate = sample_rate;
+        _update_bin_mapping();
+    }
+}
+
+void SpectrumAnalyzer::set_display_range(int bins, float min_freq, float max_freq)
+{
+    _bins = bins;
+    _min_freq = min_freq;
+    _max_freq = max_freq;
+    _average_db.assign(bins, MIN_DB);
+    _peak_db.assign(bins, MIN_DB);
+    _points.resize(bins);
+    _update_bin_mapping();
+}
+
+void SpectrumAnalyzer::set_smoothing(float average_coeff, float peak_decay)
+{
+    _average_coeff = average_coeff;
+    _peak_decay = peak_decay;
+}
+
+void SpectrumAnalyzer::_update_bin_mapping()
+{
+    _bin_start.resize(_bins);
+    _bin_end.resize(_bins);
+    _bin_centre.resize(_bins);
+    float bin_width = _sample_rate / _fft.size();
+    int max_bin = _fft.size() / 2;
+    float ratio = _max_freq / _min_freq;
+    for (int i = 0; i < _bins; ++i)
+    {
+        float low = _min_freq * std::pow(ratio, static_cast<float>(i) / _bins) / bin_width;
+        float high = _min_freq * std::pow(ratio, static_cast<float>(i + 1) / _bins) / bin_width;
+        _bin_start[i] = std::clamp(static_cast<int>(std::ceil(low)), 0, max_bin);
+        _bin_end[i] = std::clamp(static_cast<int>(std::ceil(high)), 0, max_bin + 1);
+        _bin_centre[i] = std::clamp(std::sqrt(low * high), 0.0f, static_cast<float>(max_bin - 1));
+    }
+}
+
+bool SpectrumAnalyzer::process()
+{
+    if (!_new_data || _bins == 0)
+    {
+        return false;
+    }
+    _new_data = false;
+
+    apply_window(_history.data() + _write_index, _window.data(), _windowed.data(), _fft.size());
+    _fft.power_spectrum(_windowed.data(), _power.data());
+
+    for (int i = 0; i < _bins; ++i)
+    {
+        float power;
+        if (_bin_end[i] - _bin_start[i] > 1)
+        {
+            /* Several fft bins fall in this display bin, show the strongest */
+            power = *std::max_element(_power.data() + _bin_start[i], _power.data() + _bin_end[i]);
+        }
+        else
+        {
+            /* Display bins are narrower than the fft resolution at low frequencies */
+            int index = static_cast<int>(_bin_centre[i]);
+            float frac = _bin_centre[i] - index;
+            power = (1.0f - frac) * _power[index] + frac * _power[index + 1];
+        }
+        float db = std::max(MIN_DB, 10.0f * std::log10(power * _normalisation + POWER_FLOOR));
+        _average_db[i] = _average_coeff * _average_db[i] + (1.0f - _average_coeff) * db;
+        _peak_db[i] = std::max(db, _peak_db[i] - _peak_decay);
+    }
+    return true;
+}
+
+void SpectrumAnalyzer::draw(ImDrawList* draw_list, const ImVec2& pos, const ImVec2& size, ImU32 average_colour, ImU32 peak_colour)
+{
+    if (_bins < 2)
+    {
+        return;
+    }
+    float x_step = size.x / (_bins - 1);
+    float y_scale = size.y / (MIN_DB - MAX_DB);
+
+    for (int i = 0; i < _bins; ++i)
+    {
+        _points[i] = ImVec2(pos.x + i * x_step, pos.y + std::clamp(_peak_db[i] - MAX_DB, MIN_DB, 0.0f) * y_scale);
+    }
+    ImGui_ImplOpenGL3_AddPolyline(draw_list, _points.data(), _bins, peak_colour, 1.0f);
+
+    for (int i = 0; i < _bins; ++i)
+    {
+        _points[i] = ImVec2(pos.x + i * x_step, pos.y + std::clamp(_average_db[i] - MAX_DB, MIN_DB, 0.0f) * y_scale);
+    }
+    ImGui_ImplOpenGL3_AddPolyline(draw_list, _points.data(), _bins, average_colour, 1.5f);
+}
+
+} // imgui_editor
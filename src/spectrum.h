@@ -0,0 +1,84 @@
+#ifndef IMPLUGINGUI_SPECTRUM_H
+#define IMPLUGINGUI_SPECTRUM_H
+
+#include <vector>
+
+#include "imgui.h"
+#include "fft.h"
+
+namespace imgui_editor {
+
+/* Real time spectrum analyzer display. Audio is pushed to it on the draw
+ * thread, process() then runs a Hann windowed fft over the latest fft_size
+ * samples, maps the result to logarithmically spaced display bins and
+ * applies average and peak hold smoothing. process() does nothing unless
+ * new audio has arrived, so the fft only runs while the editor is drawing */
+class SpectrumAnalyzer
+{
+public:
+    SpectrumAnalyzer(int fft_size, float sample_rate);
+
+    void push(const float* samples, int count);
+
+    void set_sample_rate(float sample_rate);
+
+    /* Map the spectrum to bins columns, spaced logarithmically from min_freq to max_freq */
+    void set_display_range(int bins, float min_freq, float max_freq);
+
+    /* average_coeff is the weight of the previous value in the running average (0 - 1),
+     * peak_decay is how much the peak hold value falls per processed frame in dB */
+    void set_smoothing(float average_coeff, float peak_decay);
+
+    /* Returns true if a new spectrum was calculated */
+    bool process();
+
+    void draw(ImDrawList* draw_list, const ImVec2& pos, const ImVec2& size, ImU32 average_colour, ImU32 peak_colour);
+
+    int fft_size() const
+    {
+        return _fft.size();
+    }
+
+    /* The smoothed spectrum in dB, one value per display bin */
+    const float* average_db() const
+    {
+        return _average_db.data();
+    }
+
+    int bins() const
+    {
+        return _bins;
+    }
+
+private:
+    void _update_bin_mapping();
+
+    RealFft            _fft;
+    float              _sample_rate;
+    int                _write_index{0};
+    bool               _new_data{false};
+
+    /* Mirrored history, the latest fft_size samples are always contiguous */
+    std::vector<float> _history;
+    std::vector<float> _window;
+    std::vector<float> _windowed;
+    std::vector<float> _power;
+    float              _normalisation;
+
+    int                _bins{0};
+    float              _min_freq{20.0f};
+    float              _max_freq{20000.0f};
+    /* Range of fft bins for each display bin, narrower ranges are interpolated */
+    std::vector<int>   _bin_start;
+    std::vector<int>   _bin_end;
+    std::vector<float> _bin_centre;
+
+    float              _average_coeff{0.7f};
+    float              _peak_decay{0.3f};
+    std::vector<float> _average_db;
+    std::vector<float> _peak_db;
+    std::vector<ImVec2> _points;
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_SPECTRUM_H
@@ -3,9 +3,18 @@
 #include <atomic>
 #include <vector>
 #include <csignal>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
 
 #ifdef LINUX
 #include <X11/Xlib.h>
+#include <sys/resource.h>
 #endif
 #ifdef WINDOWS
 #include <windows.h>
@@ -16,6 +25,12 @@
 
 std::atomic_bool running = true;
 
+constexpr int AUDIO_BLOCK_SIZE = 64;
+constexpr float AUDIO_SAMPLE_RATE = 48000;
+constexpr float TWO_PI = 6.283185307f;
+constexpr int MAX_STRESS_EDITORS = 128;
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+
 void signal_handler([[maybe_unused]] int sig_number)
 {
     running = false;
@@ -133,30 +148,226 @@ void close_editor_window(std::vector<EditorNode>* editors, NativeWindow window,
     {
         if (editor->second == window)
         {
+            /* close() returns without waiting for the editor's teardown, its window is
+             * out of the native one by then so that can be destroyed right away */
             editor->first->close();
 #ifdef LINUX
             XDestroyWindow(display, window);
 #elif WINDOWS
             DestroyWindow(window);
 #endif
+            auto lifecycle = imgui_editor::lifecycle_stats(editor->first.get());
+            std::cout << "Editor closed in " << lifecycle.close_call_ms << " ms" << std::endl;
+            /* Waits for the teardown to finish */
             editors->erase(editor);
             break;
         }
     }
 }
 
+/* Resource usage of the whole process, negative where not available */
+struct ProcessStats
+{
+    double cpu_seconds{-1};
+    int    threads{-1};
+    double rss_mb{-1};
+    double peak_rss_mb{-1};
+};
+
+ProcessStats process_stats()
+{
+    ProcessStats stats;
+#ifdef LINUX
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        stats.cpu_seconds = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1'000'000.0;
+    }
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        /* Memory is given in kB */
+        if (line.rfind("Threads:", 0) == 0)
+        {
+            stats.threads = std::atoi(line.c_str() + std::strlen("Threads:"));
+        }
+        else if (line.rfind("VmRSS:", 0) == 0)
+        {
+            stats.rss_mb = std::atof(line.c_str() + std::strlen("VmRSS:")) * 1024.0 / BYTES_PER_MB;
+        }
+        else if (line.rfind("VmHWM:", 0) == 0)
+        {
+            stats.peak_rss_mb = std::atof(line.c_str() + std::strlen("VmHWM:")) * 1024.0 / BYTES_PER_MB;
+        }
+    }
+#endif
+    return stats;
+}
+
+/* Prints value, or null if it's negative, i.e. not available */
+void print_json_number(FILE* out, const char* name, double value, bool last = false)
+{
+    if (value < 0)
+    {
+        std::fprintf(out, "\"%s\": null%s", name, last ? "" : ", ");
+    }
+    else
+    {
+        std::fprintf(out, "\"%s\": %.3f%s", name, value, last ? "" : ", ");
+    }
+}
+
+/* Counts, printed without decimals, or null if negative */
+void print_json_number(FILE* out, const char* name, int value, bool last = false)
+{
+    if (value < 0)
+    {
+        std::fprintf(out, "\"%s\": null%s", name, last ? "" : ", ");
+    }
+    else
+    {
+        std::fprintf(out, "\"%s\": %d%s", name, value, last ? "" : ", ");
+    }
+}
+
+/* Prints the average and maximum of a value over all editors, skipping negative ones, i.e. not available */
+template <typename STATS>
+void print_json_summary(FILE* out, const char* name, const std::vector<STATS>& stats, float STATS::*value)
+{
+    double max = -1;
+    double sum = 0;
+    int count = 0;
+    for (const auto& editor : stats)
+    {
+        if (editor.*value >= 0)
+        {
+            max = std::max(max, static_cast<double>(editor.*value));
+            sum += editor.*value;
+            count++;
+        }
+    }
+    std::fprintf(out, "  \"%s\": {", name);
+    print_json_number(out, "average", count > 0 ? sum / count : -1);
+    print_json_number(out, "max", max, true);
+    std::fprintf(out, "},\n");
+}
+
+/* Writes the results of a stress run, per editor and for the whole process before
+ * opening any editors and at the end of the run, so the cost per instance shows.
+ * The lifecycle stats are taken after closing all editors */
+void write_stress_report(FILE* out, const std::vector<imgui_editor::FrameTimeStats>& editor_stats,
+                         const std::vector<imgui_editor::LifecycleStats>& lifecycle_stats,
+                         const std::vector<imgui_editor::SchedulingStats>& scheduling_stats, double duration,
+                         const ProcessStats& before, const ProcessStats& after)
+{
+    int editors = static_cast<int>(editor_stats.size());
+    std::fprintf(out, "{\n  \"editors\": %d,\n  \"duration_s\": %.3f,\n", editors, duration);
+    print_json_summary(out, "open_latency_ms", editor_stats, &imgui_editor::FrameTimeStats::open_latency_ms);
+    print_json_summary(out, "open_call_ms", lifecycle_stats, &imgui_editor::LifecycleStats::open_call_ms);
+    print_json_summary(out, "close_call_ms", lifecycle_stats, &imgui_editor::LifecycleStats::close_call_ms);
+    print_json_summary(out, "teardown_ms", lifecycle_stats, &imgui_editor::LifecycleStats::teardown_ms);
+    print_json_summary(out, "run_delay_ms", scheduling_stats, &imgui_editor::SchedulingStats::run_delay_ms);
+    print_json_summary(out, "render_wait_ms", scheduling_stats, &imgui_editor::SchedulingStats::render_wait_ms);
+    std::fprintf(out, "  \"process\": {");
+    print_json_number(out, "cpu_s", after.cpu_seconds < 0 ? -1 : after.cpu_seconds - before.cpu_seconds);
+    print_json_number(out, "cpu_percent", after.cpu_seconds < 0 ? -1 : 100.0 * (after.cpu_seconds - before.cpu_seconds) / duration);
+    print_json_number(out, "threads", after.threads);
+    print_json_number(out, "threads_per_editor", after.threads < 0 ? -1 : static_cast<double>(after.threads - before.threads) / editors);
+    print_json_number(out, "rss_mb", after.rss_mb);
+    print_json_number(out, "rss_per_editor_mb", after.rss_mb < 0 ? -1 : (after.rss_mb - before.rss_mb) / editors);
+    print_json_number(out, "peak_rss_mb", after.peak_rss_mb, true);
+    std::fprintf(out, "},\n  \"per_editor\": [\n");
+    for (int i = 0; i < editors; ++i)
+    {
+        const auto& stats = editor_stats[i];
+        const auto& lifecycle = lifecycle_stats[i];
+        std::fprintf(out, "    {");
+        print_json_number(out, "open_latency_ms", stats.open_latency_ms);
+        print_json_number(out, "open_call_ms", lifecycle.open_call_ms);
+        print_json_number(out, "close_call_ms", lifecycle.close_call_ms);
+        print_json_number(out, "teardown_ms", lifecycle.teardown_ms);
+        print_json_number(out, "frames", stats.frames);
+        print_json_number(out, "fps", stats.frames / duration);
+        print_json_number(out, "suspended_s", stats.suspended_s);
+        print_json_number(out, "run_delay_ms", scheduling_stats[i].run_delay_ms);
+        print_json_number(out, "max_run_delay_ms", scheduling_stats[i].max_run_delay_ms);
+        print_json_number(out, "render_wait_ms", scheduling_stats[i].render_wait_ms);
+        print_json_number(out, "quality_level", stats.quality_level);
+        print_json_number(out, "frame_ms_average", stats.average_ms);
+        print_json_number(out, "frame_ms_p50", stats.p50_ms);
+        print_json_number(out, "frame_ms_p90", stats.p90_ms);
+        print_json_number(out, "frame_ms_p99", stats.p99_ms);
+        print_json_number(out, "frame_ms_max", stats.max_ms, true);
+        std::fprintf(out, "}%s\n", i + 1 < editors ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+/* Stand-in for the audio thread of a plugin, pushes a test signal to the editors' scopes */
+void audio_thread(std::vector<std::unique_ptr<imgui_editor::SampleFifo>>* fifos)
+{
+    std::array<float, AUDIO_BLOCK_SIZE> buffer;
+    float phase = 0;
+    float lfo_phase = 0;
+    auto block_time = std::chrono::microseconds(static_cast<int>(AUDIO_BLOCK_SIZE * 1'000'000 / AUDIO_SAMPLE_RATE));
+    auto next_block = std::chrono::steady_clock::now();
+    while (running)
+    {
+        for (auto& sample : buffer)
+        {
+            sample = 0.8f * std::sin(phase) * (0.5f + 0.5f * std::sin(lfo_phase));
+            phase = std::fmod(phase + TWO_PI * 110.0f / AUDIO_SAMPLE_RATE, TWO_PI);
+            lfo_phase = std::fmod(lfo_phase + TWO_PI * 0.5f / AUDIO_SAMPLE_RATE, TWO_PI);
+        }
+        for (auto& fifo : *fifos)
+        {
+            fifo->push(buffer.data(), AUDIO_BLOCK_SIZE);
+        }
+        next_block += block_time;
+        std::this_thread::sleep_until(next_block);
+    }
+}
+
+/* usage: standalone_demo [windows] [--stress <seconds>] [--report <file>]
+ * In stress mode, all editors are opened as fast as possible, closed again after
+ * the given time and a report is written as JSON to stdout or the report file */
 int main(int argc, char** argv)
 {
     int n_windows = 1;
-    if (argc > 1)
+    double stress_duration = 0;
+    const char* report_path = nullptr;
+    for (int i = 1; i < argc; ++i)
     {
-        n_windows = std::atoi(argv[1]);
+        if (std::strcmp(argv[i], "--stress") == 0 && i + 1 < argc)
+        {
+            stress_duration = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--report") == 0 && i + 1 < argc)
+        {
+            report_path = argv[++i];
+        }
+        else
+        {
+            n_windows = std::atoi(argv[i]);
+        }
+    }
+    bool stress = stress_duration > 0;
+    if (stress)
+    {
+        n_windows = std::clamp(n_windows, 1, MAX_STRESS_EDITORS);
+        if (report_path == nullptr)
+        {
+            /* Keep stdout for the report only */
+            std::cout.setstate(std::ios::failbit);
+        }
     }
     std::cout << "Using " << n_windows << " windows" << std::endl;
 
     signal(SIGINT, signal_handler);
     signal(SIGABRT, signal_handler);
     std::vector<EditorNode> editors(n_windows);
+    std::vector<std::unique_ptr<imgui_editor::SampleFifo>> audio_fifos;
 
     /* Create a dummy plugin instance and pass to the Editor's factory function */
     AudioEffect plugin_dummy_instance;
@@ -167,10 +378,16 @@ int main(int argc, char** argv)
     XEvent x_event;
 #endif
 
+    ProcessStats stats_before = process_stats();
+    auto start_time = std::chrono::steady_clock::now();
     for (auto& editor : editors)
     {
-        editor.first = imgui_editor::create_editor(&plugin_dummy_instance);
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto& fifo = audio_fifos.emplace_back(std::make_unique<imgui_editor::SampleFifo>());
+        editor.first = imgui_editor::create_editor(&plugin_dummy_instance, fifo.get());
+        if (!stress)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
         ERect* rect = nullptr;
         /* Get the size of the Editor and create a system window to match this,
          * Essentially mimicking what a plugin host would do */
@@ -179,6 +396,8 @@ int main(int argc, char** argv)
         editor.first->open(reinterpret_cast<void*>(editor.second));
     }
 
+    std::thread dsp_thread(audio_thread, &audio_fifos);
+
     while(running)
     {
 #ifdef LINUX
@@ -213,6 +432,10 @@ int main(int argc, char** argv)
         {
             running = false;
         }
+        if (stress && std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count() >= stress_duration)
+        {
+            running = false;
+        }
         for(auto& editor : editors)
         {
             editor.first->idle();
@@ -220,7 +443,19 @@ int main(int argc, char** argv)
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
 
-    /* If there are any windows still open, close them */
+    /* Closed editors are not in the report, closing a window ends the run early */
+    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    ProcessStats stats_after = process_stats();
+    std::vector<imgui_editor::FrameTimeStats> editor_stats;
+    std::vector<imgui_editor::SchedulingStats> scheduling_stats;
+    for (auto& editor : editors)
+    {
+        editor_stats.push_back(imgui_editor::frame_time_stats(editor.first.get()));
+        scheduling_stats.push_back(imgui_editor::scheduling_stats(editor.first.get()));
+    }
+
+    /* If there are any windows still open, close them, then wait for the editors'
+     * teardown so the audio fifos can go */
     for(auto& editor : editors)
     {
         editor.first->close();
@@ -228,6 +463,30 @@ int main(int argc, char** argv)
         XDestroyWindow(display, editor.second);
 #endif
     }
+    std::vector<imgui_editor::LifecycleStats> lifecycle_stats;
+    for(auto& editor : editors)
+    {
+        imgui_editor::editor_closed(editor.first.get()).wait();
+        lifecycle_stats.push_back(imgui_editor::lifecycle_stats(editor.first.get()));
+    }
+
+    if (stress)
+    {
+        FILE* report = report_path ? std::fopen(report_path, "w") : stdout;
+        if (report == nullptr)
+        {
+            std::cerr << "Failed to open " << report_path << std::endl;
+        }
+        else if (!editor_stats.empty())
+        {
+            write_stress_report(report, editor_stats, lifecycle_stats, scheduling_stats, duration, stats_before, stats_after);
+            if (report != stdout)
+            {
+                std::fclose(report);
+            }
+        }
+    }
+    dsp_thread.join();
 
 #ifdef LINUX
     XCloseDisplay(display);
@@ -0,0 +1,143 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "stats_export.h"
+
+namespace imgui_editor {
+
+constexpr const char* STATS_EXPORT_ENV_VARIABLE = "VSTIMGUI_STATS_EXPORT";
+/* Names tried for the segment before giving up, if ones left behind are in the way */
+constexpr int MAX_SEGMENT_NAMES = 64;
+
+#ifdef LINUX
+/* The process's segment, created on first use and removed at exit */
+class SharedSegment
+{
+public:
+    SharedSegment()
+    {
+        const char* enabled = std::getenv(STATS_EXPORT_ENV_VARIABLE);
+        if (enabled != nullptr && std::strcmp(enabled, "0") == 0)
+        {
+            return;
+        }
+        /* Only ever a new segment, one with the same name may have been left behind by an
+         * earlier process with the same pid, or be someone else's, so it's never opened */
+        int fd = -1;
+        for (int unique = 0; fd < 0 && unique < MAX_SEGMENT_NAMES; ++unique)
+        {
+            _name = stats_segment_name(getpid(), unique);
+            fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0 && errno != EEXIST)
+            {
+                break;
+            }
+        }
+        if (fd < 0)
+        {
+            std::cerr << "Failed to create shared memory " << _name << ": " << std::strerror(errno) << std::endl;
+            return;
+        }
+        bool sized = ftruncate(fd, sizeof(StatsSegment)) == 0;
+        void* memory = sized ? mmap(nullptr, sizeof(StatsSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+        close(fd);
+        if (memory == MAP_FAILED)
+        {
+            std::cerr << "Failed to map shared memory " << _name << ": " << std::strerror(errno) << std::endl;
+            shm_unlink(_name.c_str());
+            return;
+        }
+        _segment = static_cast<StatsSegment*>(memory);
+        _segment->version = STATS_SEGMENT_VERSION;
+        _segment->pid = static_cast<int32_t>(getpid());
+        _segment->start_time = process_start_time(getpid());
+        _segment->slot_count = STATS_SEGMENT_SLOTS;
+        /* Readers check the magic number before anything else */
+        std::atomic_thread_fence(std::memory_order_release);
+        _segment->magic = STATS_SEGMENT_MAGIC;
+    }
+
+    ~SharedSegment()
+    {
+        if (_segment)
+        {
+            munmap(_segment, sizeof(StatsSegment));
+            shm_unlink(_name.c_str());
+        }
+    }
+
+    StatsSegment* segment() const
+    {
+        return _segment;
+    }
+
+private:
+    std::string   _name;
+    StatsSegment* _segment{nullptr};
+};
+
+static StatsSegment* shared_segment()
+{
+    static SharedSegment segment;
+    return segment.segment();
+}
+#endif
+
+StatsExport::~StatsExport()
+{
+    release();
+}
+
+bool StatsExport::claim()
+{
+    release();
+#ifdef LINUX
+    StatsSegment* segment = shared_segment();
+    if (segment == nullptr)
+    {
+        return false;
+    }
+    for (auto& slot : segment->slots)
+    {
+        uint32_t free = 0;
+        if (slot.claimed.compare_exchange_strong(free, 1, std::memory_order_acq_rel))
+        {
+            _slot = &slot;
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+void StatsExport::release()
+{
+    if (_slot)
+    {
+        _slot->claimed.store(0, std::memory_order_release);
+        _slot = nullptr;
+    }
+}
+
+void StatsExport::publish(const EditorStatsRecord& record)
+{
+    if (_slot == nullptr)
+    {
+        return;
+    }
+    uint32_t sequence = _slot->sequence.load(std::memory_order_relaxed);
+    _slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&_slot->record, &record, sizeof(record));
+    _slot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+} // imgui_editor
@@ -0,0 +1,37 @@
+#ifndef IMPLUGINGUI_STATS_EXPORT_H
+#define IMPLUGINGUI_STATS_EXPORT_H
+
+#include "stats_segment.h"
+
+namespace imgui_editor {
+
+/* Publishes one editor's statistics in its slot of the process's shared memory
+ * segment, see stats_segment.h, for watching all editors of a running host with
+ * the stats_monitor tool. The segment is created with the first slot claimed and
+ * removed when the process exits. Only available on Linux, elsewhere claim()
+ * always fails.
+ * Setting the environment variable VSTIMGUI_STATS_EXPORT to 0 turns it off */
+class StatsExport
+{
+public:
+    StatsExport() = default;
+
+    ~StatsExport();
+
+    StatsExport(const StatsExport&) = delete;
+    StatsExport& operator=(const StatsExport&) = delete;
+
+    /* Takes a free slot, false if there's none or no segment */
+    bool claim();
+
+    void release();
+
+    /* Doesn't block or allocate, a no-op without a slot */
+    void publish(const EditorStatsRecord& record);
+
+private:
+    EditorStatsSlot* _slot{nullptr};
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_STATS_EXPORT_H
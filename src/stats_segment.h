@@ -0,0 +1,135 @@
+#ifndef IMPLUGINGUI_STATS_SEGMENT_H
+#define IMPLUGINGUI_STATS_SEGMENT_H
+
+/* Layout of the shared memory segment editors publish their statistics in,
+ * shared by the editors and the stats_monitor tool reading it from another
+ * process. There's one segment per process, with one slot per open editor.
+ * Each slot has a single writer, the editor's draw thread, and is read without
+ * locking: the writer makes the slot's sequence number odd while it writes the
+ * record, readers retry until they have copied a record with the same even
+ * sequence number before and after */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace imgui_editor {
+
+constexpr uint32_t STATS_SEGMENT_MAGIC = 0x53545356;     // "VSTS"
+constexpr uint32_t STATS_SEGMENT_VERSION = 3;
+constexpr int      STATS_SEGMENT_SLOTS = 128;
+constexpr const char* STATS_SEGMENT_PREFIX = "vstimgui-stats.";
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Slots are shared between processes");
+
+/* Name of a segment of process pid for shm_open(), it shows up in /dev/shm without
+ * the leading slash. unique tells it apart from segments left behind by earlier
+ * processes with the same pid */
+inline std::string stats_segment_name(int pid, int unique)
+{
+    return "/" + std::string(STATS_SEGMENT_PREFIX) + std::to_string(pid) + "." + std::to_string(unique);
+}
+
+/* The pid in the name of a segment as listed in /dev/shm, 0 if it isn't one */
+inline int stats_segment_pid(const std::string& file_name)
+{
+    size_t prefix_length = std::string(STATS_SEGMENT_PREFIX).size();
+    if (file_name.compare(0, prefix_length, STATS_SEGMENT_PREFIX) != 0)
+    {
+        return 0;
+    }
+    return std::atoi(file_name.c_str() + prefix_length);
+}
+
+/* When process pid started, in clock ticks since boot, 0 if there's no such process.
+ * Tells a process apart from earlier ones that had the same pid */
+inline uint64_t process_start_time(int pid)
+{
+    std::ifstream file("/proc/" + std::to_string(pid) + "/stat");
+    std::string stat;
+    std::getline(file, stat);
+    /* The command name can contain spaces, the start time is the 20th field after it */
+    size_t command_end = stat.rfind(')');
+    if (command_end == std::string::npos)
+    {
+        return 0;
+    }
+    std::istringstream fields(stat.substr(command_end + 1));
+    std::string field;
+    int count = 0;
+    while (count < 20 && fields >> field)
+    {
+        ++count;
+    }
+    return count == 20 ? std::strtoull(field.c_str(), nullptr, 10) : 0;
+}
+
+struct EditorStatsRecord
+{
+    int32_t  session;           // Numbers each opening of an editor in the process
+    int32_t  quality_level;     // Set by the quality governor, 0 is full quality
+    uint64_t frames;            // Since opened
+    uint64_t skipped_frames;    // Display refreshes missed because a frame took too long
+    uint64_t update_ns;         // Steady clock time of the last update, comparable between processes
+    float    fps;
+    float    draw_ms;           // Smoothed timings of the phases of a frame
+    float    render_ms;
+    float    gl_render_ms;
+    float    swap_ms;
+    float    decimation_ms;
+    float    analyzer_ms;
+    float    suspended_s;
+    float    run_delay_ms;      // Average wait for a cpu each time the draw thread was ready to run
+    float    render_wait_ms;    // Smoothed wait for other editors to finish drawing
+    int64_t  cpu_bytes;
+    int64_t  gpu_bytes;
+};
+
+struct EditorStatsSlot
+{
+    std::atomic<uint32_t> claimed;
+    std::atomic<uint32_t> sequence;
+    EditorStatsRecord     record;
+};
+
+struct StatsSegment
+{
+    uint32_t        magic;
+    uint32_t        version;
+    int32_t         pid;
+    uint32_t        slot_count;
+    uint64_t        start_time;     // Of the process, see process_start_time()
+    EditorStatsSlot slots[STATS_SEGMENT_SLOTS];
+};
+
+/* Copies the record of a claimed slot, false if the slot is free or kept being written to */
+inline bool read_stats_slot(const EditorStatsSlot& slot, EditorStatsRecord& record)
+{
+    constexpr int MAX_TRIES = 100;
+    for (int i = 0; i < MAX_TRIES; ++i)
+    {
+        if (slot.claimed.load(std::memory_order_acquire) == 0)
+        {
+            return false;
+        }
+        uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1)
+        {
+            continue;
+        }
+        std::memcpy(&record, &slot.record, sizeof(record));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // imgui_editor
+#endif //IMPLUGINGUI_STATS_SEGMENT_H
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include "fnv_hash.h"
+#include "glyph_atlas.h"
+#include "text_cache.h"
+#include "utf8.h"
+
+namespace imgui_editor {
+
+/* Text not drawn for this many frames is dropped, checked as often */
+constexpr int EVICT_AFTER_FRAMES = 120;
+constexpr int FORMAT_BUFFER_SIZE = 64;
+
+void TextCache::new_frame()
+{
+    _frame++;
+    ImTextureID texture = ImGui::GetIO().Fonts->TexID;
+    if (texture != _texture)
+    {
+        _texture = texture;
+        invalidate();
+    }
+    if (_frame % EVICT_AFTER_FRAMES == 0)
+    {
+        for (auto i = _entries.begin(); i != _entries.end();)
+        {
+            i = _frame - i->second.last_frame > EVICT_AFTER_FRAMES ? _entries.erase(i) : std::next(i);
+        }
+    }
+}
+
+void TextCache::invalidate()
+{
+    _entries.clear();
+    for (auto& slot : _values)
+    {
+        slot.valid = false;
+    }
+}
+
+void TextCache::text(const char* text, const char* text_end)
+{
+    if (text_end == nullptr)
+    {
+        text_end = text + std::strlen(text);
+    }
+    ImFont* font = ImGui::GetFont();
+    float font_size = ImGui::GetFontSize();
+    uint64_t key = fnv_hash(FNV_OFFSET, text, text_end - text);
+    key = fnv_hash(key, &font, sizeof(font));
+    key = fnv_hash(key, &font_size, sizeof(font_size));
+
+    Geometry& geometry = _entries[key];
+    size_t length = text_end - text;
+    if (geometry.font != font || geometry.font_size != font_size || geometry.text.size() != length ||
+        std::memcmp(geometry.text.data(), text, length) != 0)
+    {
+        /* New, or in the rare case of a hash collision replaced */
+        _build(geometry, font, font_size, text, text_end);
+    }
+    geometry.last_frame = _frame;
+    _draw(geometry);
+}
+
+void TextCache::value(int slot, float value, const char* format, float precision)
+{
+    if (slot >= static_cast<int>(_values.size()))
+    {
+        _values.resize(slot + 1);
+    }
+    ValueSlot& entry = _values[slot];
+    ImFont* font = ImGui::GetFont();
+    float font_size = ImGui::GetFontSize();
+    auto steps = static_cast<int64_t>(std::round(value / precision));
+    if (!entry.valid || entry.steps != steps || entry.format != format || entry.geometry.font != font || entry.geometry.font_size != font_size)
+    {
+        char buffer[FORMAT_BUFFER_SIZE];
+        int length = std::snprintf(buffer, sizeof(buffer), format, static_cast<double>(value));
+        length = std::max(0, std::min(length, FORMAT_BUFFER_SIZE - 1));
+        _build(entry.geometry, font, font_size, buffer, buffer + length);
+        entry.valid = true;
+        entry.steps = steps;
+        entry.format = format;
+    }
+    _draw(entry.geometry);
+}
+
+void TextCache::_build(Geometry& geometry, ImFont* font, float font_size, const char* text, const char* text_end)
+{
+    if (_glyphs)
+    {
+        _glyphs->use(font, text, text_end);
+    }
+    geometry.text.assign(text, text_end);
+    geometry.font = font;
+    geometry.font_size = font_size;
+    geometry.glyphs.clear();
+
+    /* Same placement as ImFont::RenderText() */
+    float scale = font_size / font->FontSize;
+    float x = 0;
+    float y = 0;
+    float width = 0;
+    while (text < text_end)
+    {
+        unsigned int c;
+        text += decode_utf8(text, text_end, &c);
+        if (c == '\n')
+        {
+            width = std::max(width, x);
+            x = 0;
+            y += font_size;
+            continue;
+        }
+        if (c == '\r')
+        {
+            continue;
+        }
+        const ImFontGlyph* glyph = font->FindGlyph(static_cast<ImWchar>(c));
+        if (glyph == nullptr)
+        {
+            continue;
+        }
+        if (glyph->Visible)
+        {
+            geometry.glyphs.push_back({ImVec2(x + glyph->X0 * scale, y + glyph->Y0 * scale),
+                                       ImVec2(x + glyph->X1 * scale, y + glyph->Y1 * scale),
+                                       ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1)});
+        }
+        x += glyph->AdvanceX * scale;
+    }
+    /* Rounded up like ImGui::CalcTextSize() */
+    geometry.size = ImVec2(std::floor(std::max(width, x) + 0.99999f), y + font_size);
+}
+
+void TextCache::_draw(const Geometry& geometry)
+{
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    pos = ImVec2(std::floor(pos.x), std::floor(pos.y));
+    int glyphs = static_cast<int>(geometry.glyphs.size());
+    if (glyphs > 0)
+    {
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        ImU32 colour = ImGui::GetColorU32(ImGuiCol_Text);
+        draw_list->PrimReserve(glyphs * 6, glyphs * 4);
+        for (const auto& glyph : geometry.glyphs)
+        {
+            draw_list->PrimRectUV(ImVec2(pos.x + glyph.p0.x, pos.y + glyph.p0.y), ImVec2(pos.x + glyph.p1.x, pos.y + glyph.p1.y),
+                                  glyph.uv0, glyph.uv1, colour);
+        }
+    }
+    ImGui::Dummy(geometry.size);
+}
+
+} // imgui_editor
@@ -0,0 +1,89 @@
+#ifndef IMPLUGINGUI_TEXT_CACHE_H
+#define IMPLUGINGUI_TEXT_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "imgui.h"
+
+namespace imgui_editor {
+
+class GlyphAtlas;
+
+/* Caches the glyph quads of text drawn every frame, so unchanged text is only
+ * copied into the draw list instead of being laid out glyph by glyph again.
+ * Static text is keyed by the string, font and size. Formatted values each have
+ * a slot of their own and are only formatted again when the value changes by
+ * more than the displayed precision.
+ * Text is drawn at the cursor and advances it like ImGui::TextUnformatted(),
+ * but is not clipped on the cpu. Must be used from the thread owning the ImGui
+ * context, between ImGui::NewFrame() and ImGui::Render() */
+class TextCache
+{
+public:
+    /* Call once per frame before drawing any text, drops text not drawn for a while */
+    void new_frame();
+
+    /* Call when the font atlas has been rebuilt, the cached texture coordinates are then stale */
+    void invalidate();
+
+    /* Glyphs of text that is laid out are loaded through glyphs, if set */
+    void set_glyphs(GlyphAtlas* glyphs)
+    {
+        _glyphs = glyphs;
+    }
+
+    void text(const char* text, const char* text_end = nullptr);
+
+    /* Draws value formatted with a printf format taking a single double, e.g.
+     * "%.2f dB". precision is the smallest change that shows, i.e. 0.01 for "%.2f" */
+    void value(int slot, float value, const char* format, float precision);
+
+    /* Entries in the cache, for statistics */
+    int size() const
+    {
+        return static_cast<int>(_entries.size());
+    }
+
+private:
+    struct Glyph
+    {
+        ImVec2 p0;
+        ImVec2 p1;
+        ImVec2 uv0;
+        ImVec2 uv1;
+    };
+
+    struct Geometry
+    {
+        std::string        text;
+        ImFont*            font{nullptr};
+        float              font_size{0};
+        ImVec2             size;
+        std::vector<Glyph> glyphs;
+        int                last_frame{0};
+    };
+
+    struct ValueSlot
+    {
+        bool        valid{false};
+        int64_t     steps{0};       // The value in units of the precision
+        const char* format{nullptr};
+        Geometry    geometry;
+    };
+
+    void _build(Geometry& geometry, ImFont* font, float font_size, const char* text, const char* text_end);
+
+    static void _draw(const Geometry& geometry);
+
+    std::unordered_map<uint64_t, Geometry> _entries;
+    std::vector<ValueSlot> _values;
+    int         _frame{0};
+    ImTextureID _texture{};
+    GlyphAtlas* _glyphs{nullptr};
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_TEXT_CACHE_H
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef LINUX
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "thread_policy.h"
+
+namespace imgui_editor {
+
+constexpr const char* NICE_ENV_VARIABLE = "VSTIMGUI_DRAW_THREAD_NICE";
+constexpr const char* CPUS_ENV_VARIABLE = "VSTIMGUI_DRAW_THREAD_CPUS";
+constexpr const char* MAX_RENDERING_ENV_VARIABLE = "VSTIMGUI_MAX_RENDERING";
+constexpr int MAX_NICE = 19;
+constexpr int MAX_CPUS = 1024;
+constexpr auto SCHEDULER_SAMPLE_INTERVAL = std::chrono::milliseconds(250);
+
+/* Parses a list of cpus like "0-3,6", empty if it isn't one */
+static std::vector<int> parse_cpus(const char* list)
+{
+    std::vector<int> cpus;
+    const char* pos = list;
+    while (*pos != 0)
+    {
+        char* end;
+        long first = std::strtol(pos, &end, 10);
+        long last = first;
+        if (end == pos)
+        {
+            return {};
+        }
+        if (*end == '-')
+        {
+            pos = end + 1;
+            last = std::strtol(pos, &end, 10);
+            if (end == pos)
+            {
+                return {};
+            }
+        }
+        if (first < 0 || last < first || last >= MAX_CPUS || (*end != ',' && *end != 0))
+        {
+            return {};
+        }
+        for (long cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+        pos = *end == ',' ? end + 1 : end;
+    }
+    return cpus;
+}
+
+static ThreadPolicy read_policy()
+{
+    ThreadPolicy policy;
+    const char* nice = std::getenv(NICE_ENV_VARIABLE);
+    if (nice != nullptr && std::strcmp(nice, "idle") == 0)
+    {
+        policy.idle = true;
+    }
+    else if (nice != nullptr && nice[0] != 0)
+    {
+        policy.nice = std::clamp(std::atoi(nice), 0, MAX_NICE);
+    }
+    const char* cpus = std::getenv(CPUS_ENV_VARIABLE);
+    if (cpus != nullptr && cpus[0] != 0)
+    {
+        policy.cpus = parse_cpus(cpus);
+        if (policy.cpus.empty())
+        {
+            std::cerr << "Ignoring " << CPUS_ENV_VARIABLE << ", not a list of cpus: " << cpus << std::endl;
+        }
+    }
+    const char* max_rendering = std::getenv(MAX_RENDERING_ENV_VARIABLE);
+    if (max_rendering != nullptr && max_rendering[0] != 0)
+    {
+        policy.max_rendering = std::max(0, std::atoi(max_rendering));
+    }
+    return policy;
+}
+
+const ThreadPolicy& ThreadPolicy::from_environment()
+{
+    static const ThreadPolicy policy = read_policy();
+    return policy;
+}
+
+bool apply_thread_policy(const ThreadPolicy& policy)
+{
+#ifdef LINUX
+    bool applied = true;
+    /* Nice levels are per thread on Linux, set through the thread's id */
+    if (policy.nice != 0 && setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), policy.nice) != 0)
+    {
+        std::cerr << "Failed to set nice level of draw thread: " << std::strerror(errno) << std::endl;
+        applied = false;
+    }
+    if (policy.idle)
+    {
+        sched_param param{};
+        int error = pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+        if (error != 0)
+        {
+            std::cerr << "Failed to set idle scheduling of draw thread: " << std::strerror(error) << std::endl;
+            applied = false;
+        }
+    }
+    if (!policy.cpus.empty())
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu : policy.cpus)
+        {
+            CPU_SET(cpu, &cpus);
+        }
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (error != 0)
+        {
+            std::cerr << "Failed to set cpus of draw thread: " << std::strerror(error) << std::endl;
+            applied = false;
+        }
+    }
+    return applied;
+#else
+    return policy.nice == 0 && !policy.idle && policy.cpus.empty();
+#endif
+}
+
+void RenderSlots::acquire()
+{
+    if (_slots <= 0)
+    {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_lock);
+    _released.wait(lock, [this] {return _used < _slots;});
+    _used++;
+}
+
+void RenderSlots::release()
+{
+    if (_slots <= 0)
+    {
+        return;
+    }
+    {
+        std::scoped_lock<std::mutex> lock(_lock);
+        _used--;
+    }
+    _released.notify_one();
+}
+
+SchedulerLatency::~SchedulerLatency()
+{
+    stop();
+}
+
+void SchedulerLatency::start()
+{
+    stop();
+    _run_delay_ms = 0;
+    _max_run_delay_ms = 0;
+    _sample_time = std::chrono::high_resolution_clock::now();
+#ifdef LINUX
+    /* Opened once, the file stays bound to this thread and is read again from the start */
+    _fd = open("/proc/thread-self/schedstat", O_RDONLY | O_CLOEXEC);
+    if (_fd >= 0 && !_read(_run_delay_ns, _timeslices))
+    {
+        stop();
+    }
+#endif
+}
+
+void SchedulerLatency::stop()
+{
+#ifdef LINUX
+    if (_fd >= 0)
+    {
+        close(_fd);
+    }
+#endif
+    _fd = -1;
+}
+
+void SchedulerLatency::update(std::chrono::high_resolution_clock::time_point now)
+{
+    if (_fd < 0 || now - _sample_time < SCHEDULER_SAMPLE_INTERVAL)
+    {
+        return;
+    }
+    _sample_time = now;
+    uint64_t run_delay_ns;
+    uint64_t timeslices;
+    if (!_read(run_delay_ns, timeslices) || timeslices <= _timeslices)
+    {
+        return;
+    }
+    float delay = (run_delay_ns - _run_delay_ns) / 1'000'000.0f / (timeslices - _timeslices);
+    _run_delay_ms = delay;
+    _max_run_delay_ms = std::max(_max_run_delay_ms.load(), delay);
+    _run_delay_ns = run_delay_ns;
+    _timeslices = timeslices;
+}
+
+bool SchedulerLatency::_read(uint64_t& run_delay_ns, uint64_t& timeslices)
+{
+#ifdef LINUX
+    /* Time on the cpu, time waiting for one and the number of times scheduled, all since the thread started */
+    char buffer[96];
+    ssize_t length = pread(_fd, buffer, sizeof(buffer) - 1, 0);
+    if (length <= 0)
+    {
+        return false;
+    }
+    buffer[length] = 0;
+    unsigned long long run_time;
+    unsigned long long delay;
+    unsigned long long count;
+    if (std::sscanf(buffer, "%llu %llu %llu", &run_time, &delay, &count) != 3)
+    {
+        return false;
+    }
+    run_delay_ns = delay;
+    timeslices = count;
+    return true;
+#else
+    (void) run_delay_ns;
+    (void) timeslices;
+    return false;
+#endif
+}
+
+} // imgui_editor
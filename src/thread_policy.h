@@ -0,0 +1,105 @@
+#ifndef IMPLUGINGUI_THREAD_POLICY_H
+#define IMPLUGINGUI_THREAD_POLICY_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace imgui_editor {
+
+/* How the editors' threads are scheduled, so they don't take cpu time from the
+ * host's audio threads. Read once per process from environment variables:
+ *   VSTIMGUI_DRAW_THREAD_NICE  nice level from 0 to 19, or "idle" to only run
+ *                              when a cpu has nothing else to do (SCHED_IDLE)
+ *   VSTIMGUI_DRAW_THREAD_CPUS  cpus the threads may run on, e.g. "2-5,7", to
+ *                              keep them off the cores the audio threads use
+ *   VSTIMGUI_MAX_RENDERING     how many editors may draw a frame at the same
+ *                              time, 0 for no limit
+ * The default leaves all of them as they are. Only the limit is available on
+ * platforms other than Linux */
+struct ThreadPolicy
+{
+    int              nice{0};
+    bool             idle{false};
+    std::vector<int> cpus;              // Empty for all of them
+    int              max_rendering{0};
+
+    static const ThreadPolicy& from_environment();
+};
+
+/* Applies the nice level, scheduling class and cpus of policy to the calling
+ * thread. Threads it starts afterwards inherit them. False if any of them
+ * couldn't be applied */
+bool apply_thread_policy(const ThreadPolicy& policy);
+
+/* Limits the number of threads between acquire() and release() */
+class RenderSlots
+{
+public:
+    /* 0 for no limit */
+    explicit RenderSlots(int slots) : _slots(slots) {}
+
+    RenderSlots(const RenderSlots&) = delete;
+    RenderSlots& operator=(const RenderSlots&) = delete;
+
+    /* Waits for a free slot, returns immediately if there is no limit */
+    void acquire();
+
+    void release();
+
+private:
+    const int               _slots;
+    int                     _used{0};
+    std::mutex              _lock;
+    std::condition_variable _released;
+};
+
+/* Measures how long a thread waits for a cpu when it's ready to run, from the
+ * kernel's scheduler statistics of the thread. Sampled a few times a second,
+ * the results can be read from any thread. Linux only, always 0 elsewhere */
+class SchedulerLatency
+{
+public:
+    SchedulerLatency() = default;
+
+    ~SchedulerLatency();
+
+    SchedulerLatency(const SchedulerLatency&) = delete;
+    SchedulerLatency& operator=(const SchedulerLatency&) = delete;
+
+    /* Starts measuring the calling thread and clears the results */
+    void start();
+
+    void stop();
+
+    /* Takes a sample if it's time to, must be called from the measured thread */
+    void update(std::chrono::high_resolution_clock::time_point now);
+
+    /* Average wait each time the thread was scheduled, over the last sample interval */
+    float run_delay_ms() const
+    {
+        return _run_delay_ms;
+    }
+
+    /* Highest of the averages since start() */
+    float max_run_delay_ms() const
+    {
+        return _max_run_delay_ms;
+    }
+
+private:
+    bool _read(uint64_t& run_delay_ns, uint64_t& timeslices);
+
+    int      _fd{-1};
+    uint64_t _run_delay_ns{0};
+    uint64_t _timeslices{0};
+    std::chrono::high_resolution_clock::time_point _sample_time;
+    std::atomic<float> _run_delay_ms{0};
+    std::atomic<float> _max_run_delay_ms{0};
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_THREAD_POLICY_H
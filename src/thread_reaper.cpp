@@ -0,0 +1,54 @@
+#include "thread_reaper.h"
+
+namespace imgui_editor {
+
+ThreadReaper::~ThreadReaper()
+{
+    {
+        std::scoped_lock<std::mutex> lock(_lock);
+        _running = false;
+    }
+    _added.notify_one();
+    if (_reaper.joinable())
+    {
+        _reaper.join();
+    }
+}
+
+void ThreadReaper::add(std::thread thread)
+{
+    if (!thread.joinable())
+    {
+        return;
+    }
+    {
+        std::scoped_lock<std::mutex> lock(_lock);
+        _threads.push_back(std::move(thread));
+        if (!_reaper.joinable())
+        {
+            _reaper = std::thread(&ThreadReaper::_run, this);
+        }
+    }
+    _added.notify_one();
+}
+
+void ThreadReaper::_run()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    while (true)
+    {
+        _added.wait(lock, [this] {return !_threads.empty() || !_running;});
+        if (_threads.empty())
+        {
+            return;
+        }
+        /* Join without holding the lock so more threads can be added meanwhile */
+        std::thread thread = std::move(_threads.front());
+        _threads.pop_front();
+        lock.unlock();
+        thread.join();
+        lock.lock();
+    }
+}
+
+} // imgui_editor
@@ -0,0 +1,39 @@
+#ifndef IMPLUGINGUI_THREAD_REAPER_H
+#define IMPLUGINGUI_THREAD_REAPER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace imgui_editor {
+
+/* Joins threads that have been told to stop and finish on their own, so the
+ * thread stopping them doesn't have to wait, e.g. an editor's draw thread
+ * tearing down its window and GL context after the host closed the editor.
+ * The reaper's own thread is started with the first thread added, threads
+ * still running when the reaper is destroyed are waited for */
+class ThreadReaper
+{
+public:
+    ThreadReaper() = default;
+
+    ~ThreadReaper();
+
+    ThreadReaper(const ThreadReaper&) = delete;
+    ThreadReaper& operator=(const ThreadReaper&) = delete;
+
+    void add(std::thread thread);
+
+private:
+    void _run();
+
+    std::mutex              _lock;
+    std::condition_variable _added;
+    std::deque<std::thread> _threads;
+    bool                    _running{true};
+    std::thread             _reaper;
+};
+
+} // imgui_editor
+#endif //IMPLUGINGUI_THREAD_REAPER_H
@@ -0,0 +1,34 @@
+#ifndef IMPLUGINGUI_UTF8_H
+#define IMPLUGINGUI_UTF8_H
+
+namespace imgui_editor {
+
+/* Decodes one character, returns the number of bytes used. Invalid sequences
+ * decode to U+FFFD one byte at a time, as ImGui does */
+inline int decode_utf8(const char* text, const char* text_end, unsigned int* character)
+{
+    auto bytes = reinterpret_cast<const unsigned char*>(text);
+    int available = static_cast<int>(text_end - text);
+    int length = bytes[0] < 0x80 ? 1 : (bytes[0] & 0xe0) == 0xc0 ? 2 : (bytes[0] & 0xf0) == 0xe0 ? 3 : (bytes[0] & 0xf8) == 0xf0 ? 4 : 0;
+    if (length == 0 || length > available)
+    {
+        *character = 0xfffd;
+        return 1;
+    }
+    constexpr unsigned char FIRST_BYTE_MASK[] = {0, 0x7f, 0x1f, 0x0f, 0x07};
+    unsigned int c = bytes[0] & FIRST_BYTE_MASK[length];
+    for (int i = 1; i < length; ++i)
+    {
+        if ((bytes[i] & 0xc0) != 0x80)
+        {
+            *character = 0xfffd;
+            return 1;
+        }
+        c = (c << 6) | (bytes[i] & 0x3f);
+    }
+    *character = c;
+    return length;
+}
+
+} // imgui_editor
+#endif //IMPLUGINGUI_UTF8_H
@@ -0,0 +1,49 @@
+#include <algorithm>
+
+#include "widgets.h"
+#include "imgui_impl_opengl3.h"
+
+namespace imgui_editor {
+
+/* How much a knob turns per pixel of vertical mouse movement */
+constexpr float KNOB_DRAG_SPEED = 0.005f;
+
+bool instanced_vslider(const char* str_id, const ImVec2& size, float* value)
+{
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImGui::InvisibleButton(str_id, size);
+    bool active = ImGui::IsItemActive();
+    if (active)
+    {
+        /* Map the mouse position to the grab's travel, same as ImGui::VSliderFloat() */
+        float grab_size = ImGui::GetStyle().GrabMinSize;
+        float travel = size.y - 4.0f - grab_size;
+        float mouse_y = ImGui::GetIO().MousePos.y - pos.y - 2.0f - grab_size * 0.5f;
+        if (travel > 0.0f)
+        {
+            *value = std::clamp(1.0f - mouse_y / travel, 0.0f, 1.0f);
+        }
+    }
+    ImGuiCol frame_col = active ? ImGuiCol_FrameBgActive : (ImGui::IsItemHovered() ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg);
+    ImGui_ImplOpenGL3_AddWidgetInstance(ImGui::GetWindowDrawList(), ImGui_ImplOpenGL3_WidgetType_VSlider, pos, size, *value,
+                                        ImGui::GetColorU32(frame_col), ImGui::GetColorU32(active ? ImGuiCol_SliderGrabActive : ImGuiCol_SliderGrab));
+    return active;
+}
+
+bool instanced_knob(const char* str_id, float diameter, float* value)
+{
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImVec2 size(diameter, diameter);
+    ImGui::InvisibleButton(str_id, size);
+    bool active = ImGui::IsItemActive();
+    if (active)
+    {
+        *value = std::clamp(*value - ImGui::GetIO().MouseDelta.y * KNOB_DRAG_SPEED, 0.0f, 1.0f);
+    }
+    ImGuiCol frame_col = active ? ImGuiCol_FrameBgActive : (ImGui::IsItemHovered() ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg);
+    ImGui_ImplOpenGL3_AddWidgetInstance(ImGui::GetWindowDrawList(), ImGui_ImplOpenGL3_WidgetType_Knob, pos, size, *value,
+                                        ImGui::GetColorU32(frame_col), ImGui::GetColorU32(active ? ImGuiCol_SliderGrabActive : ImGuiCol_SliderGrab));
+    return active;
+}
+
+} // imgui_editor
@@ -0,0 +1,21 @@
+#ifndef IMPLUGINGUI_WIDGETS_H
+#define IMPLUGINGUI_WIDGETS_H
+
+#include "imgui.h"
+
+namespace imgui_editor {
+
+/* Parameter widgets for normalised (0 - 1) values that are drawn through the
+ * OpenGL3 backend's instanced widget path. All widgets of one type in a window
+ * are rendered with a single draw call and only a small per instance record
+ * is uploaded for each, instead of the vertices of a regular ImGui slider.
+ * Return true while the widget is being dragged, like ImGui::IsItemActive() */
+
+/* Vertical slider, the value follows the mouse while dragged */
+bool instanced_vslider(const char* str_id, const ImVec2& size, float* value);
+
+/* Round knob, dragging the mouse up or down turns the knob */
+bool instanced_knob(const char* str_id, float diameter, float* value);
+
+} // imgui_editor
+#endif //IMPLUGINGUI_WIDGETS_H
@@ -0,0 +1,110 @@
+/* Builds an asset pack, see asset_pack.h, from font and image files.
+ *
+ * usage: asset_packer <pack file> [<name>=]<file>...
+ * Assets are named after their file name unless a name is given, which is what
+ * editors look them up by. .ttf and .otf files are stored as fonts, .png files
+ * are decoded to RGBA images if built with libpng, everything else is stored
+ * as it is */
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifdef WITH_LIBPNG
+#include <png.h>
+#endif
+
+#include "asset_pack.h"
+
+using imgui_editor::AssetType;
+
+static std::string extension(const std::string& path)
+{
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {return std::tolower(c);});
+    return extension;
+}
+
+static bool read_file(const std::string& path, std::vector<uint8_t>& data)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+#ifdef WITH_LIBPNG
+static bool decode_png(const std::string& path, std::vector<uint8_t>& pixels, int& width, int& height)
+{
+    png_image image{};
+    image.version = PNG_IMAGE_VERSION;
+    if (png_image_begin_read_from_file(&image, path.c_str()) == 0)
+    {
+        std::cerr << "Failed to read " << path << ": " << image.message << std::endl;
+        return false;
+    }
+    image.format = PNG_FORMAT_RGBA;
+    pixels.resize(PNG_IMAGE_SIZE(image));
+    if (png_image_finish_read(&image, nullptr, pixels.data(), 0, nullptr) == 0)
+    {
+        std::cerr << "Failed to decode " << path << ": " << image.message << std::endl;
+        png_image_free(&image);
+        return false;
+    }
+    width = static_cast<int>(image.width);
+    height = static_cast<int>(image.height);
+    return true;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <pack file> [<name>=]<file>..." << std::endl;
+        return 1;
+    }
+
+    imgui_editor::AssetPackWriter writer;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        auto separator = argument.find('=');
+        std::string path = separator == std::string::npos ? argument : argument.substr(separator + 1);
+        std::string name = separator == std::string::npos ? std::filesystem::path(path).filename().string() : argument.substr(0, separator);
+        std::string type = extension(path);
+
+        if (type == ".png")
+        {
+#ifdef WITH_LIBPNG
+            std::vector<uint8_t> pixels;
+            int width;
+            int height;
+            if (!decode_png(path, pixels, width, height))
+            {
+                return 1;
+            }
+            writer.add(name, AssetType::IMAGE_RGBA, std::move(pixels), width, height);
+            continue;
+#else
+            std::cerr << "Built without libpng, storing " << path << " without decoding it" << std::endl;
+#endif
+        }
+        std::vector<uint8_t> data;
+        if (!read_file(path, data))
+        {
+            std::cerr << "Failed to read " << path << std::endl;
+            return 1;
+        }
+        writer.add(name, type == ".ttf" || type == ".otf" ? AssetType::FONT : AssetType::BLOB, std::move(data));
+    }
+    return writer.write(argv[1]) ? 0 : 1;
+}
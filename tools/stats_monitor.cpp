@@ -0,0 +1,174 @@
+/* Shows the statistics of all open editors in running host processes, as
+ * published by the editors in shared memory, refreshed live. Reads the segments
+ * without locking or otherwise disturbing the editors, so it can be pointed at
+ * a slow session in production.
+ *
+ * usage: stats_monitor [pid] [--interval <ms>] [--once]
+ * Without a pid, all processes with editors are shown */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "stats_segment.h"
+
+constexpr const char* SHM_DIRECTORY = "/dev/shm";
+constexpr int DEFAULT_INTERVAL_MS = 500;
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+
+using imgui_editor::EditorStatsRecord;
+using imgui_editor::StatsSegment;
+
+static bool process_running(int pid)
+{
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+struct SegmentFile
+{
+    int         pid;
+    std::string name;
+};
+
+/* Segments of process pid, or of all processes if 0, whether they are still running or not */
+static std::vector<SegmentFile> find_segments(int pid)
+{
+    std::vector<SegmentFile> segments;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(SHM_DIRECTORY, error))
+    {
+        std::string name = entry.path().filename().string();
+        int process = imgui_editor::stats_segment_pid(name);
+        if (process > 0 && (pid == 0 || process == pid))
+        {
+            segments.push_back({process, "/" + name});
+        }
+    }
+    std::sort(segments.begin(), segments.end(), [](const SegmentFile& a, const SegmentFile& b)
+    {
+        return a.pid != b.pid ? a.pid < b.pid : a.name < b.name;
+    });
+    return segments;
+}
+
+/* Prints one line per editor in the segment of process pid, returns the number of editors */
+static int print_segment(int pid, const std::string& name, uint64_t now_ns)
+{
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return 0;
+    }
+    struct stat info{};
+    void* memory = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(StatsSegment))
+    {
+        memory = mmap(nullptr, sizeof(StatsSegment), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        return 0;
+    }
+    auto segment = static_cast<const StatsSegment*>(memory);
+    int editors = 0;
+    if (segment->magic != imgui_editor::STATS_SEGMENT_MAGIC || segment->version != imgui_editor::STATS_SEGMENT_VERSION)
+    {
+        std::printf("%7d  unknown segment version\n", pid);
+    }
+    else if (!process_running(pid) || imgui_editor::process_start_time(pid) != segment->start_time)
+    {
+        std::printf("%7d  not running, segment left behind\n", pid);
+    }
+    else
+    {
+        int slots = std::min(static_cast<int>(segment->slot_count), imgui_editor::STATS_SEGMENT_SLOTS);
+        for (int i = 0; i < slots; ++i)
+        {
+            EditorStatsRecord record;
+            if (!imgui_editor::read_stats_slot(segment->slots[i], record))
+            {
+                continue;
+            }
+            double age = now_ns > record.update_ns ? (now_ns - record.update_ns) / 1'000'000'000.0 : 0.0;
+            std::printf("%7d  %7d  %5.1f  %7.3f  %7.3f  %7.3f  %7.3f  %7.3f  %8llu  %8llu  %7d  %6.1f  %6.1f  %8.3f  %7.3f  %9.1f  %5.1f\n",
+                        pid, record.session, record.fps, record.draw_ms, record.render_ms, record.gl_render_ms,
+                        record.swap_ms, record.decimation_ms + record.analyzer_ms,
+                        static_cast<unsigned long long>(record.frames), static_cast<unsigned long long>(record.skipped_frames),
+                        record.quality_level, record.cpu_bytes / BYTES_PER_MB, record.gpu_bytes / BYTES_PER_MB,
+                        record.run_delay_ms, record.render_wait_ms, record.suspended_s, age);
+            editors++;
+        }
+    }
+    munmap(memory, sizeof(StatsSegment));
+    return editors;
+}
+
+int main(int argc, char** argv)
+{
+    int pid = 0;
+    int interval_ms = DEFAULT_INTERVAL_MS;
+    bool once = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--interval") == 0 && i + 1 < argc)
+        {
+            interval_ms = std::max(50, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--once") == 0)
+        {
+            once = true;
+        }
+        else if (argv[i][0] != '-')
+        {
+            pid = std::atoi(argv[i]);
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [pid] [--interval <ms>] [--once]" << std::endl;
+            return 1;
+        }
+    }
+
+    while (true)
+    {
+        if (!once)
+        {
+            /* Clear the terminal and start from the top */
+            std::printf("\033[H\033[2J");
+        }
+        std::printf("    pid  session    fps  draw ms  rend ms    gl ms  swap ms   dsp ms    frames   skipped  quality  cpu MB  gpu MB  sched ms  wait ms  suspended  age s\n");
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        uint64_t now_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+        int editors = 0;
+        for (const auto& segment : find_segments(pid))
+        {
+            editors += print_segment(segment.pid, segment.name, now_ns);
+        }
+        if (editors == 0)
+        {
+            std::printf("No open editors%s\n", pid > 0 ? " in this process" : "");
+        }
+        std::fflush(stdout);
+        if (once)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+    return 0;
+}